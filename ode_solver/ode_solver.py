@@ -37,6 +37,8 @@ if __name__ == "__main__":
     parser = argparse.ArgumentParser(description="simple ode solver / illustrate force of a falling magnet")
     parser.add_argument( "ode_method", type=str, help="The ode method") # e.g. 'RK45' or 'BDF'
     parser.add_argument( "dt", type=float, help="The time step size")
+    parser.add_argument( "--native", action="store_true",
+                         help="Evaluate the force with the adapter's C++ model (ts_force_generator module)")
     #
     # parse arguments
     args = parser.parse_args()
@@ -54,7 +56,16 @@ if __name__ == "__main__":
 
     grav = 9.81
     mg = mass * grav
-    fz = partial( force, scale=mg )
+    if args.native:
+        # the sigmoid model of the adapter, in process
+        import ts_force_generator as tsfg
+        settings = tsfg.ForceModelSettings()
+        settings.sigmoid.mass = mass
+        settings.sigmoid.gravity = grav
+        model = tsfg.ForceModel( settings )
+        fz = lambda t, z: model( t, [0.0, 0.0, z] )[2]
+    else:
+        fz = partial( force, scale=mg )
     time_steps = np.arange(0,t_span[1],dt)
     
     sol = solve_ivp( ode_system, t_span, y0, args=(mass, grav, fz), t_eval=time_steps, method=args.ode_method)
@@ -63,10 +74,16 @@ if __name__ == "__main__":
     z = sol.y[0]
     v = sol.y[1]
 
-    f = np.zeros_like(t)
+    if args.native:
+        # all samples in one call
+        U = np.zeros( (len(t),3) )
+        U[:,2] = z
+        f = -mg + model.evalBatch( np.ascontiguousarray(t), U )[:,2]
+    else:
+        f = np.zeros_like(t)
 
-    for i, ti in enumerate(t):
-        f[i] = -mg + fz(ti,z[i])
+        for i, ti in enumerate(t):
+            f[i] = -mg + fz(ti,z[i])
     
     fname = f"ode_{args.ode_method}_dt{args.dt:.0e}.dat"
     export_to_file( fname, t, z, v, f )
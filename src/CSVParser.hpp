@@ -18,30 +18,82 @@
 // system ----------------------------------------------------------------------
 #include <vector>
 #include <filesystem>
-#include <fstream>
 #include <stdexcept>
 #include <string>
-#include <sstream>
-#include <array>
-#include <iterator>
+#include <string_view>
+#include <charconv>
+#include <cstring>
+#include <format>
 
 // own -------------------------------------------------------------------------
 #include "types.hpp"
+#include "MappedFile.hpp"
+#include "Parallel.hpp"
 
 //------------------------------------------------------------------------------
 namespace ts {
 
   //----------------------------------------------------------------------------
+  /** Parser for delimiter separated numeric tables.
+   *
+   *  The file is memory mapped and split at line boundaries into chunks that
+   *  are parsed concurrently with std::from_chars straight into a presized
+   *  row-major buffer. Lines starting with commentChar and blank lines are
+   *  skipped; every other line must hold exactly NUM_COLS values, optionally
+   *  followed by one delimiter.
+   *
+   *  With numParts > 1 only the part-th of numParts line aligned byte slices
+   *  of the file is parsed, so that each rank of a partitioned run touches
+   *  just its share of the mapping. Line numbers in errors are then relative
+   *  to the slice.
+   */
   template< SizeT NUM_COLS, typename T = Real >
   struct CSVParser
   {
     using Value = T;
     using Vector = std::vector<Value>;
 
+    static constexpr SizeT numCols = NUM_COLS;
+
+    //! number of parser threads, zero means all hardware threads
+    SizeT numThreads = 0;
+
+    //! parse slice part of numParts only
+    SizeT part     = 0;
+    SizeT numParts = 1;
+
     Vector operator()( const std::filesystem::path& file,
                        char delimiter   = ',',
                        char commentChar = '#' ) const;
-    
+
+    Vector parse( std::string_view content,
+                  char delimiter   = ',',
+                  char commentChar = '#',
+                  std::string_view source = "<memory>" ) const;
+
+  private:
+    //! content moved forward to the next line start
+    static SizeT lineStart_( std::string_view content, SizeT pos );
+
+    // don't bother spawning threads for less than this
+    static constexpr SizeT minChunkBytes_ = SizeT{1} << 20;
+
+    struct ChunkInfo_
+    {
+      SizeT begin   = 0;
+      SizeT end     = 0;
+      SizeT numRows = 0;
+      SizeT numLines = 0;
+    };
+
+    static bool isDataLine_( std::string_view line, char commentChar );
+
+    static void parseRow_( std::string_view line,
+                           char delimiter,
+                           Value* row,
+                           std::string_view source,
+                           SizeT lineNumber );
+
   }; // end class CSVParser
 
   //============================================================================
@@ -55,32 +107,160 @@ namespace ts {
                                           char commentChar)
     const -> Vector
   {
-    std::ifstream is( file );
-    if( !is.is_open() ) {
+    if( !std::filesystem::exists( file ) ) {
       const std::string msg = "ts::CSVParser::operator():File '" + file.string() + "' not found";
       throw std::runtime_error(msg);
     }
 
-    std::string line;
-    Vector resval;
-    while( std::getline( is, line ) ) {
-      // skip comment lines
-      if( !line.empty() && line[0] == commentChar ) continue;
-
-      std::istringstream stream(line);
-      std::array<Value,NUM_COLS> row;
-      std::string val;
-
-      // Tokenize line
-      while( std::getline( stream, val, delimiter ) ) {
-        std::istringstream iss(val);
-        std::copy( std::istream_iterator<Value>(iss),
-                   std::istream_iterator<Value>(),
-                   std::back_inserter( resval ) );
+    const MappedFile mapped( file );
+    return parse( mapped.view(), delimiter, commentChar, file.string() );
+  }
+
+  //----------------------------------------------------------------------------
+  template< SizeT NUM_COLS, typename T >
+  auto CSVParser<NUM_COLS,T>::parse( std::string_view content,
+                                     char delimiter,
+                                     char commentChar,
+                                     std::string_view source )
+    const -> Vector
+  {
+    static_assert( NUM_COLS > 0, "ts::CSVParser:NUM_COLS must be positive" );
+
+    std::string partSource;
+    if( numParts > 1 ) {
+      if( part >= numParts )
+        throw std::runtime_error( "ts::CSVParser::parse:Invalid part" );
+      const SizeT begin = lineStart_( content, part * (content.size() / numParts) );
+      const SizeT end   = part + 1 == numParts
+                        ? content.size()
+                        : lineStart_( content, (part+1) * (content.size() / numParts) );
+      content    = content.substr( begin, end - begin );
+      partSource = std::format( "{} (part {} of {})", source, part, numParts );
+      source     = partSource;
+    }
+
+    const SizeT size = content.size();
+    const SizeT numChunks =
+      std::min( parallel::numThreads( numThreads ), size / minChunkBytes_ + 1 );
+
+    // chunk boundaries are moved forward to the next line start
+    std::vector<ChunkInfo_> chunks( numChunks );
+    for( SizeT c = 1; c < numChunks; ++c ) {
+      const SizeT pos = lineStart_( content, std::max( c * (size / numChunks), chunks[c-1].begin ) );
+      chunks[c].begin = pos;
+      chunks[c-1].end = pos;
+    }
+    chunks.back().end = size;
+
+    auto forEachLine = [content]( const ChunkInfo_& chunk, auto&& f ) {
+      SizeT pos = chunk.begin;
+      while( pos < chunk.end ) {
+        const void* nl = std::memchr( content.data() + pos, '\n', chunk.end - pos );
+        const SizeT eol = nl ? static_cast<const char*>(nl) - content.data() : chunk.end;
+        f( content.substr( pos, eol - pos ) );
+        pos = eol + 1;
       }
+    };
+
+    // pass 1: count data rows per chunk
+    parallel::forEachChunk( numChunks, numChunks,
+                            [&]( SizeT, SizeT cBegin, SizeT cEnd ) {
+                              for( SizeT c = cBegin; c < cEnd; ++c )
+                                forEachLine( chunks[c], [&]( std::string_view line ) {
+                                  ++chunks[c].numLines;
+                                  if( isDataLine_( line, commentChar ) ) ++chunks[c].numRows;
+                                } );
+                            } );
+
+    SizeT numRows = 0;
+    std::vector<SizeT> rowOffsets( numChunks ), lineOffsets( numChunks );
+    for( SizeT c = 0, numLines = 0; c < numChunks; ++c ) {
+      rowOffsets[c]  = numRows;
+      lineOffsets[c] = numLines;
+      numRows  += chunks[c].numRows;
+      numLines += chunks[c].numLines;
     }
-    
+
+    // pass 2: parse every chunk into its slot of the presized buffer
+    Vector resval( numRows * NUM_COLS );
+    parallel::forEachChunk( numChunks, numChunks,
+                            [&]( SizeT, SizeT cBegin, SizeT cEnd ) {
+                              for( SizeT c = cBegin; c < cEnd; ++c ) {
+                                Value* row = resval.data() + rowOffsets[c] * NUM_COLS;
+                                SizeT lineNumber = lineOffsets[c];
+                                forEachLine( chunks[c], [&]( std::string_view line ) {
+                                  ++lineNumber;
+                                  if( !isDataLine_( line, commentChar ) ) return;
+                                  parseRow_( line, delimiter, row, source, lineNumber );
+                                  row += NUM_COLS;
+                                } );
+                              }
+                            } );
+
     return resval;
   }
-  
+
+  //----------------------------------------------------------------------------
+  template< SizeT NUM_COLS, typename T >
+  SizeT CSVParser<NUM_COLS,T>::lineStart_( std::string_view content, SizeT pos )
+  {
+    if( pos == 0 ) return 0;
+    const auto nl = content.find( '\n', pos - 1 );
+    return (nl == std::string_view::npos) ? content.size() : nl + 1;
+  }
+
+  //----------------------------------------------------------------------------
+  template< SizeT NUM_COLS, typename T >
+  bool CSVParser<NUM_COLS,T>::isDataLine_( std::string_view line, char commentChar )
+  {
+    if( line.empty() || line[0] == commentChar ) return false;
+    return line.find_first_not_of( " \t\r" ) != std::string_view::npos;
+  }
+
+  //----------------------------------------------------------------------------
+  template< SizeT NUM_COLS, typename T >
+  void CSVParser<NUM_COLS,T>::parseRow_( std::string_view line,
+                                         char delimiter,
+                                         Value* row,
+                                         std::string_view source,
+                                         SizeT lineNumber )
+  {
+    auto fail = [&]( std::string_view what ) {
+      const std::string msg = std::format( "ts::CSVParser::operator():'{}', line {}: {}",
+                                           source, lineNumber, what );
+      throw std::runtime_error(msg);
+    };
+
+    SizeT col = 0;
+    SizeT pos = 0;
+    while( true ) {
+      SizeT end = line.find( delimiter, pos );
+      if( end == std::string_view::npos ) end = line.size();
+
+      std::string_view token = line.substr( pos, end - pos );
+      const auto first = token.find_first_not_of( " \t\r" );
+      const auto last  = token.find_last_not_of( " \t\r" );
+      token = (first == std::string_view::npos) ? std::string_view{}
+                                                : token.substr( first, last - first + 1 );
+      if( !token.empty() && token.front() == '+' ) token.remove_prefix( 1 );
+
+      if( col == NUM_COLS )
+        fail( std::format( "more than {} columns", NUM_COLS ) );
+
+      const auto [ptr,ec] = std::from_chars( token.data(), token.data() + token.size(), row[col] );
+      if( ec != std::errc() || ptr != token.data() + token.size() || token.empty() )
+        fail( std::format( "cannot convert '{}' in column {}", token, col ) );
+      ++col;
+
+      if( end == line.size() ) break;
+      pos = end + 1;
+
+      // one trailing delimiter, as many exporters write it
+      if( line.find_first_not_of( " \t\r", pos ) == std::string_view::npos ) break;
+    }
+
+    if( col != NUM_COLS )
+      fail( std::format( "expected {} columns, found {}", NUM_COLS, col ) );
+  }
+
 } // end namespace ts
@@ -0,0 +1,132 @@
+//------------------------------------------------------------------------------
+// <preamble>
+//
+//  ______
+// |
+// | TailSiT GmbH
+// | Graz, Austria
+//   www.tailsit.com
+//
+// </preamble>
+//------------------------------------------------------------------------------
+
+//! @author    Lars Kielhorn, Thomas Rüberg, Jürgen Zechner
+//! @date      2024
+//! @copyright TailSiT GmbH
+
+// system ----------------------------------------------------------------------
+#include <type_traits>
+
+// own -------------------------------------------------------------------------
+#include "Communicator.hpp"
+
+//------------------------------------------------------------------------------
+namespace ts {
+
+#ifdef TS_WITH_MPI
+  static_assert( std::is_same_v<Real,double>, "ts::Communicator:Reductions assume MPI_DOUBLE" );
+  static_assert( sizeof(SizeT) == sizeof(unsigned long long) );
+#endif
+
+  //----------------------------------------------------------------------------
+  Communicator::Communicator( )
+#ifdef TS_WITH_MPI
+    : comm_(MPI_COMM_SELF)
+    , rank_(0)
+#else
+    : rank_(0)
+#endif
+    , size_(1)
+  {
+    // empty
+  }
+
+  //----------------------------------------------------------------------------
+  Communicator Communicator::world( )
+  {
+    Communicator comm;
+#ifdef TS_WITH_MPI
+    int initialized = 0;
+    MPI_Initialized( &initialized );
+    if( !initialized ) return comm;
+
+    int rank = 0, size = 1;
+    MPI_Comm_rank( MPI_COMM_WORLD, &rank );
+    MPI_Comm_size( MPI_COMM_WORLD, &size );
+    comm.comm_ = MPI_COMM_WORLD;
+    comm.rank_ = static_cast<SizeT>( rank );
+    comm.size_ = static_cast<SizeT>( size );
+#endif
+    return comm;
+  }
+
+  //----------------------------------------------------------------------------
+  void Communicator::allReduceSum( [[maybe_unused]] std::span<Real> values ) const
+  {
+    if( size_ == 1 ) return;
+#ifdef TS_WITH_MPI
+    MPI_Allreduce( MPI_IN_PLACE, values.data(), static_cast<int>( values.size() ),
+                   MPI_DOUBLE, MPI_SUM, comm_ );
+#endif
+  }
+
+  //----------------------------------------------------------------------------
+  SizeT Communicator::allReduceSum( SizeT value ) const
+  {
+    if( size_ == 1 ) return value;
+#ifdef TS_WITH_MPI
+    unsigned long long sum = value;
+    MPI_Allreduce( MPI_IN_PLACE, &sum, 1, MPI_UNSIGNED_LONG_LONG, MPI_SUM, comm_ );
+    value = static_cast<SizeT>( sum );
+#endif
+    return value;
+  }
+
+  //----------------------------------------------------------------------------
+  void Communicator::allReduceMax( [[maybe_unused]] std::span<Real> values ) const
+  {
+    if( size_ == 1 ) return;
+#ifdef TS_WITH_MPI
+    MPI_Allreduce( MPI_IN_PLACE, values.data(), static_cast<int>( values.size() ),
+                   MPI_DOUBLE, MPI_MAX, comm_ );
+#endif
+  }
+
+  //----------------------------------------------------------------------------
+  void Communicator::barrier( ) const
+  {
+    if( size_ == 1 ) return;
+#ifdef TS_WITH_MPI
+    MPI_Barrier( comm_ );
+#endif
+  }
+
+  //----------------------------------------------------------------------------
+  void Communicator::abort( [[maybe_unused]] int errorCode ) const
+  {
+    if( size_ == 1 ) return;
+#ifdef TS_WITH_MPI
+    MPI_Abort( comm_, errorCode );
+#endif
+  }
+
+  //----------------------------------------------------------------------------
+  MpiEnvironment::MpiEnvironment( [[maybe_unused]] int& argc,
+                                  [[maybe_unused]] char**& argv )
+  {
+#ifdef TS_WITH_MPI
+    // worker threads (startup, sampling) never call MPI
+    int provided;
+    MPI_Init_thread( &argc, &argv, MPI_THREAD_FUNNELED, &provided );
+#endif
+  }
+
+  //----------------------------------------------------------------------------
+  MpiEnvironment::~MpiEnvironment( )
+  {
+#ifdef TS_WITH_MPI
+    MPI_Finalize();
+#endif
+  }
+
+} // end namespace ts
@@ -0,0 +1,94 @@
+//------------------------------------------------------------------------------
+// <preamble>
+//
+//  ______
+// |
+// | TailSiT GmbH
+// | Graz, Austria
+//   www.tailsit.com
+//
+// </preamble>
+//------------------------------------------------------------------------------
+
+//! @author    Lars Kielhorn, Thomas Rüberg, Jürgen Zechner
+//! @date      2024
+//! @copyright TailSiT GmbH
+#pragma once
+
+// system ----------------------------------------------------------------------
+#include <span>
+
+// MPI -------------------------------------------------------------------------
+#ifdef TS_WITH_MPI
+#include <mpi.h>
+#endif
+
+// own -------------------------------------------------------------------------
+#include "types.hpp"
+
+//------------------------------------------------------------------------------
+namespace ts {
+
+  class Communicator;
+  class MpiEnvironment;
+
+}
+
+//------------------------------------------------------------------------------
+/** The ranks a partitioned adapter runs on.
+ *
+ *  A default constructed communicator is a single rank; all collectives are
+ *  then no-ops. world() spans all processes started by mpirun if the build
+ *  has MPI support (TS_WITH_MPI) and MPI is initialized.
+ */
+class ts::Communicator
+{
+private:
+#ifdef TS_WITH_MPI
+  MPI_Comm comm_;
+#endif
+  SizeT    rank_;
+  SizeT    size_;
+
+public:
+  Communicator( );
+
+  static Communicator world( );
+
+  SizeT rank( ) const { return rank_; }
+  SizeT size( ) const { return size_; }
+  bool  isRoot( ) const { return rank_ == 0; }
+
+  /** @name collectives, every rank has to call them */
+  //@{
+  //! in place sum over all ranks
+  void allReduceSum( std::span<Real> values ) const;
+
+  SizeT allReduceSum( SizeT value ) const;
+
+  //! in place maximum over all ranks
+  void allReduceMax( std::span<Real> values ) const;
+
+  void barrier( ) const;
+  //@}
+
+  /** MPI_Abort on all ranks, for errors that leave the others waiting in a
+   *  collective; returns on a single rank, which can just unwind */
+  void abort( int errorCode ) const;
+
+}; // end class Communicator
+
+//------------------------------------------------------------------------------
+/** MPI_Init_thread (funneled) on construction, MPI_Finalize on destruction;
+ *  nothing without MPI */
+class ts::MpiEnvironment
+{
+public:
+  MpiEnvironment( int& argc, char**& argv );
+
+  MpiEnvironment( const MpiEnvironment& ) = delete;
+  MpiEnvironment& operator=( const MpiEnvironment& ) = delete;
+
+  ~MpiEnvironment( );
+
+}; // end class MpiEnvironment
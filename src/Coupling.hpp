@@ -0,0 +1,346 @@
+//------------------------------------------------------------------------------
+// <preamble>
+//
+//  ______
+// |
+// | TailSiT GmbH
+// | Graz, Austria
+//   www.tailsit.com
+//
+// </preamble>
+//------------------------------------------------------------------------------
+
+//! @author    Lars Kielhorn, Thomas Rüberg, Jürgen Zechner
+//! @date      2024
+//! @copyright TailSiT GmbH
+#pragma once
+
+// system ----------------------------------------------------------------------
+#include <algorithm>
+#include <filesystem>
+#include <format>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <variant>
+#include <vector>
+
+// own -------------------------------------------------------------------------
+#include "types.hpp"
+#include "ForceGenerator.hpp"
+#include "ForceModels.hpp"
+#include "Settings.hpp"
+#include "SubcycledWindow.hpp"
+
+//------------------------------------------------------------------------------
+namespace ts {
+
+  //----------------------------------------------------------------------------
+  /** Subcycled steps read the displacements at substep ends within the
+   *  window. Deltas sampled there have no defined reference: it depends on
+   *  what the partner writes and on the waveform degree, so only absolute
+   *  displacements are accepted. */
+  inline void checkSubcycledField( bool subcycling, const Settings& settings )
+  {
+    if( !subcycling || settings.inField != "DisplacementDeltas" ) return;
+    const std::string msg = std::format( "ts::couple:Subcycling reads absolute displacements, "
+                                         "mesh '{}' reads '{}'", settings.meshName, settings.inField );
+    throw std::runtime_error(msg);
+  }
+
+  //----------------------------------------------------------------------------
+  /** The coupling loop of the adapter.
+   *
+   *  PARTICIPANT is precice::Participant or anything offering the same
+   *  coupling calls, e.g. the ReplayParticipant. FORCE is one of the force
+   *  models, so every model gets its own inlined loop. The solver may
+   *  store its fields in either precision; the buffers exchanged with the
+   *  participant are Real. The participant calls are timed by the solver's
+   *  profiler.
+   *
+   *  With subcycling every coupling step spans all the participant allows.
+   *  The solver takes substeps within it, equal ones or the adaptive ones
+   *  it proposes, each at the displacements read at the substep end, and
+   *  the time average of their forces is written (see SubcycledWindow).
+   *  Subcycling needs absolute displacements (see checkSubcycledField).
+   */
+  template< typename PARTICIPANT, typename T, typename FORCE >
+  void couple( PARTICIPANT&                 participant,
+               BasicForceGenerator<T>&      solver,
+               const Settings&              settings,
+               std::span<const Int>         vertexIds,
+               const FORCE&                 force )
+  {
+    using Phase = Profiler::Phase;
+    static constexpr SizeT dim = ForceGenerator::dim();
+    const SizeT numPoints = vertexIds.size();
+    Profiler& profiler = solver.profiler();
+    const bool subcycling = settings.subcycling.enabled;
+    checkSubcycledField( subcycling, settings );
+
+    std::vector<Real> displacementBuffer( numPoints * dim );
+    std::vector<Real> forcesBuffer( numPoints * dim );
+    SubcycledWindow   window( subcycling ? numPoints * dim : 0 );
+    SizeT             forcesVersion = 0; // of the forces in forcesBuffer, 0 for none
+    const auto read = [&]( Real relativeReadTime ) {
+      const Profiler::Scope scope( profiler, Phase::readData );
+      participant.readData( settings.meshName,
+                            settings.inField,
+                            vertexIds,
+                            relativeReadTime,
+                            displacementBuffer );
+    };
+    while( participant.isCouplingOngoing() ) {
+
+      // possibly save state
+      if( participant.requiresWritingCheckpoint() )
+        solver.saveOldState();
+
+      // handle time step size
+      const Real preciceDt = participant.getMaxTimeStepSize();
+      const Real dt        = subcycling ? preciceDt : std::min( preciceDt, solver.beginTimeStep() );
+
+      const bool sampleForce = true;
+      if( !subcycling ) {
+        // read data
+        read( dt );
+
+        // pass data to solver
+        solver.set( settings.inField, displacementBuffer );
+
+        // 'solve' for this time step
+        solver.solveTimeStep( force, sampleForce );
+
+        // fetch forces on points from solver, unless forcesBuffer holds them
+        if( solver.forcesVersion() != forcesVersion ) {
+          solver.get( settings.outField, forcesBuffer );
+          forcesVersion = solver.forcesVersion();
+        }
+      }
+      else {
+        // the forces at the very first window start
+        if( !window.hasStartForces() ) {
+          read( 0 );
+          solver.set( settings.inField, displacementBuffer );
+          solver.solveTimeStep( force );
+          solver.get( settings.outField, window.startForces() );
+        }
+
+        // 'solve' the substeps, averaging their forces
+        window.begin( dt, forcesBuffer );
+        while( !window.done() ) {
+          const Real step = settings.timeStep.adaptive
+                          ? solver.beginTimeStep()
+                          : dt / static_cast<Real>( settings.subcycling.numSubsteps );
+          const Real h = window.next( step );
+          read( window.time() );
+          solver.set( settings.inField, displacementBuffer );
+          solver.solveTimeStep( force, sampleForce );
+          solver.get( settings.outField, window.substepForces() );
+          window.add( h, forcesBuffer );
+          solver.endSubstep( h );
+        }
+      }
+
+      // pass forces to precice
+      {
+        const Profiler::Scope scope( profiler, Phase::writeData );
+        participant.writeData( settings.meshName,
+                               settings.outField,
+                               vertexIds,
+                               forcesBuffer );
+      }
+
+      // advance in time
+      {
+        const Profiler::Scope scope( profiler, Phase::advance );
+        participant.advance(dt);
+      }
+
+      // possibly load old state
+      if( participant.requiresReadingCheckpoint() )
+        solver.reloadOldState();
+      else if( subcycling ) {
+        window.accept();
+        solver.endWindow();
+      }
+      else 
+        solver.endTimeStep(dt);
+    }
+  }
+
+  //----------------------------------------------------------------------------
+  /** One settings per mesh: settings itself if it lists no meshes, else
+   *  copies with the mesh's name, fields, force model, samples file and
+   *  point cloud region */
+  inline std::vector<Settings> meshSettings( const Settings& settings )
+  {
+    if( settings.meshes.empty() ) return { settings };
+    std::vector<Settings> result;
+    result.reserve( settings.meshes.size() );
+    for( const auto& mesh : settings.meshes ) {
+      Settings& meshSettings = result.emplace_back( settings );
+      meshSettings.meshes.clear();
+      meshSettings.meshName   = mesh.meshName;
+      meshSettings.inField    = mesh.inField;
+      meshSettings.outField   = mesh.outField;
+      meshSettings.forceModel = mesh.forceModel;
+      if( !mesh.pointCloudRegion.empty() )
+        meshSettings.pointCloudRegion = mesh.pointCloudRegion;
+      if( !mesh.samplesFile.empty() )
+        meshSettings.samplesFile = mesh.samplesFile;
+      else {
+        const std::filesystem::path file = settings.samplesFile;
+        const auto name = file.stem().string() + "_" + mesh.meshName + file.extension().string();
+        meshSettings.samplesFile = (file.parent_path() / name).string();
+      }
+    }
+    return result;
+  }
+
+  //----------------------------------------------------------------------------
+  /** A mesh of the multi-mesh coupling loop, with its own solver */
+  struct CoupledMesh
+  {
+    ForceGenerator*      solver;
+    const Settings*      settings;   //!< meshName, inField and outField used
+    std::span<const Int> vertexIds;
+    const ForceModel*    forceModel;
+  };
+
+  //----------------------------------------------------------------------------
+  /** The coupling loop for several meshes of one participant.
+   *
+   *  All meshes share the time step (the smallest one proposed) and the
+   *  checkpoints. Their displacements and forces live in one buffer each,
+   *  mesh after mesh, and are exchanged in one batch of readData and one of
+   *  writeData calls per iteration, or per substep when subcycling (the
+   *  settings of the first mesh decide on it). The participant calls are
+   *  timed by the profiler of the first mesh's solver.
+   */
+  template< typename PARTICIPANT >
+  void couple( PARTICIPANT&                   participant,
+               std::span<const CoupledMesh>   meshes )
+  {
+    using Phase = Profiler::Phase;
+    static constexpr SizeT dim = ForceGenerator::dim();
+    Profiler& profiler = meshes.front().solver -> profiler();
+    const Settings& first = *meshes.front().settings;
+    const bool subcycling = first.subcycling.enabled;
+    for( const auto& mesh : meshes )
+      checkSubcycledField( subcycling, *mesh.settings );
+
+    std::vector<SizeT> offsets( meshes.size() + 1, 0 );
+    for( SizeT m = 0; m < meshes.size(); ++m )
+      offsets[m+1] = offsets[m] + meshes[m].vertexIds.size() * dim;
+    const auto slice = [&offsets]( std::span<Real> buffer, SizeT m ) {
+      return buffer.subspan( offsets[m], offsets[m+1] - offsets[m] );
+    };
+
+    std::vector<Real>  displacementBuffer( offsets.back() );
+    std::vector<Real>  forcesBuffer( offsets.back() );
+    SubcycledWindow    window( subcycling ? offsets.back() : 0 );
+    std::vector<SizeT> forcesVersions( meshes.size(), 0 ); // of the slices of forcesBuffer
+
+    // read data of all meshes
+    const auto read = [&]( Real relativeReadTime ) {
+      const Profiler::Scope scope( profiler, Phase::readData );
+      for( SizeT m = 0; m < meshes.size(); ++m )
+        participant.readData( meshes[m].settings -> meshName,
+                              meshes[m].settings -> inField,
+                              meshes[m].vertexIds,
+                              relativeReadTime,
+                              slice( displacementBuffer, m ) );
+    };
+
+    // 'solve' every mesh, forces into the given buffer; with versions, of the
+    // forces the buffer holds, unchanged ones are not fetched again
+    const auto solve = [&]( std::span<Real> forces, bool sampleForce,
+                            std::span<SizeT> versions = {} ) {
+      for( SizeT m = 0; m < meshes.size(); ++m ) {
+        ForceGenerator& solver = *meshes[m].solver;
+        const Settings& settings = *meshes[m].settings;
+        solver.set( settings.inField, slice( displacementBuffer, m ) );
+        std::visit( [&]( const auto& force ) { solver.solveTimeStep( force, sampleForce ); },
+                    *meshes[m].forceModel );
+        if( !versions.empty() && versions[m] == solver.forcesVersion() ) continue;
+        solver.get( settings.outField, slice( forces, m ) );
+        if( !versions.empty() ) versions[m] = solver.forcesVersion();
+      }
+    };
+
+    // smallest step proposed
+    const auto propose = [&]( Real dt ) {
+      for( const auto& mesh : meshes )
+        dt = std::min( dt, mesh.solver -> beginTimeStep() );
+      return dt;
+    };
+
+    while( participant.isCouplingOngoing() ) {
+
+      // possibly save state
+      if( participant.requiresWritingCheckpoint() )
+        for( const auto& mesh : meshes ) mesh.solver -> saveOldState();
+
+      // handle time step size
+      const Real preciceDt = participant.getMaxTimeStepSize();
+      const Real dt        = subcycling ? preciceDt : propose( preciceDt );
+
+      const bool sampleForce = true;
+      if( !subcycling ) {
+        read( dt );
+        solve( forcesBuffer, sampleForce, forcesVersions );
+      }
+      else {
+        // the forces at the very first window start
+        if( !window.hasStartForces() ) {
+          read( 0 );
+          solve( window.startForces(), false );
+        }
+
+        // the substeps, averaging their forces
+        window.begin( dt, forcesBuffer );
+        while( !window.done() ) {
+          const Real step = first.timeStep.adaptive
+                          ? propose( dt )
+                          : dt / static_cast<Real>( first.subcycling.numSubsteps );
+          const Real h = window.next( step );
+          read( window.time() );
+          solve( window.substepForces(), sampleForce );
+          window.add( h, forcesBuffer );
+          for( const auto& mesh : meshes ) mesh.solver -> endSubstep( h );
+        }
+      }
+
+      // pass forces of all meshes to precice
+      {
+        const Profiler::Scope scope( profiler, Phase::writeData );
+        for( SizeT m = 0; m < meshes.size(); ++m )
+          participant.writeData( meshes[m].settings -> meshName,
+                                 meshes[m].settings -> outField,
+                                 meshes[m].vertexIds,
+                                 slice( forcesBuffer, m ) );
+      }
+
+      // advance in time
+      {
+        const Profiler::Scope scope( profiler, Phase::advance );
+        participant.advance(dt);
+      }
+
+      // possibly load old state
+      const bool reload = participant.requiresReadingCheckpoint();
+      if( !reload && subcycling )
+        window.accept();
+      for( const auto& mesh : meshes ) {
+        if( reload )
+          mesh.solver -> reloadOldState();
+        else if( subcycling )
+          mesh.solver -> endWindow();
+        else
+          mesh.solver -> endTimeStep(dt);
+      }
+    }
+  }
+
+} // end namespace ts
@@ -0,0 +1,247 @@
+//------------------------------------------------------------------------------
+// <preamble>
+//
+//  ______
+// |
+// | TailSiT GmbH
+// | Graz, Austria
+//   www.tailsit.com
+//
+// </preamble>
+//------------------------------------------------------------------------------
+
+//! @author    Lars Kielhorn, Thomas Rüberg, Jürgen Zechner
+//! @date      2024
+//! @copyright TailSiT GmbH
+
+// system ----------------------------------------------------------------------
+#include <algorithm>
+#include <bit>
+#include <cstring>
+#include <format>
+#include <stdexcept>
+#include <string>
+
+// own -------------------------------------------------------------------------
+#include "CouplingTrace.hpp"
+
+//------------------------------------------------------------------------------
+namespace {
+
+  constexpr char          magic[8] = { 'T','S','T','R','A','C','E','\0' };
+  constexpr std::uint32_t version  = 1;
+
+  // a value's code is its number of residual bytes, or repeatCode if its
+  // residual is the one of the value stride before (same component of the
+  // previous vertex), as with rigid motions and the uniform force
+  constexpr ts::SizeT stride     = 3;
+  constexpr unsigned  repeatCode = 0xf;
+
+  constexpr std::uint8_t writeCheckpointFlag = 1;
+  constexpr std::uint8_t readCheckpointFlag  = 2;
+
+  // the low bytes of a word are its first ones
+  static_assert( std::endian::native == std::endian::little );
+  static_assert( sizeof(ts::Real) == sizeof(std::uint64_t) );
+
+  //----------------------------------------------------------------------------
+  template< typename T >
+  void writeRaw( std::ofstream& out, const T* data, ts::SizeT n )
+  {
+    out.write( reinterpret_cast<const char*>(data),
+               static_cast<std::streamsize>( n * sizeof(T) ) );
+  }
+
+  //----------------------------------------------------------------------------
+  template< typename T >
+  bool readRaw( std::ifstream& in, T* data, ts::SizeT n )
+  {
+    const auto numBytes = static_cast<std::streamsize>( n * sizeof(T) );
+    in.read( reinterpret_cast<char*>(data), numBytes );
+    return in.gcount() == numBytes;
+  }
+
+  //----------------------------------------------------------------------------
+  [[noreturn]] void corrupt( const std::filesystem::path& file, ts::SizeT record )
+  {
+    throw std::runtime_error(
+      std::format( "ts::CouplingTrace::Reader:Corrupt record {} in '{}'", record, file.string() ) );
+  }
+
+} // end anonymous namespace
+
+//------------------------------------------------------------------------------
+namespace ts {
+
+  //----------------------------------------------------------------------------
+  void CouplingTrace::encode( std::span<const Real> values,
+                              std::span<Real>       previous,
+                              std::vector<char>&    out )
+  {
+    const SizeT n           = values.size();
+    const SizeT nibbleBytes = (n + 1) / 2;
+    const SizeT base        = out.size();
+    // worst case, plus room for the full word stored last
+    out.resize( base + nibbleBytes + 8*n + 8 );
+    char* nibbles = out.data() + base;
+    char* p       = nibbles + nibbleBytes;
+    std::fill_n( nibbles, nibbleBytes, 0 );
+
+    std::uint64_t residuals[stride] = {};
+    for( SizeT i = 0; i < n; ++i ) {
+      const auto x = std::bit_cast<std::uint64_t>( values[i] )
+                   ^ std::bit_cast<std::uint64_t>( previous[i] );
+      previous[i] = values[i];
+      auto& residual = residuals[i % stride];
+      unsigned code = repeatCode;
+      if( i < stride || x != residual ) {
+        code = static_cast<unsigned>( 64 - std::countl_zero( x ) + 7 ) / 8;
+        std::memcpy( p, &x, 8 );
+        p += code;
+      }
+      residual = x;
+      nibbles[i/2] = static_cast<char>( nibbles[i/2] | code << 4*(i%2) );
+    }
+    out.resize( static_cast<SizeT>( p - out.data() ) );
+  }
+
+  //----------------------------------------------------------------------------
+  const char* CouplingTrace::decode( const char*     in,
+                                     const char*     end,
+                                     std::span<Real> values )
+  {
+    const SizeT n           = values.size();
+    const SizeT nibbleBytes = (n + 1) / 2;
+    if( end - in < static_cast<std::ptrdiff_t>( nibbleBytes ) ) return nullptr;
+    const char* nibbles = in;
+    const char* p       = in + nibbleBytes;
+
+    std::uint64_t residuals[stride] = {};
+    for( SizeT i = 0; i < n; ++i ) {
+      const auto code = static_cast<unsigned>( nibbles[i/2] >> 4*(i%2) ) & 0xf;
+      auto& residual = residuals[i % stride];
+      if( code == repeatCode ) {
+        if( i < stride ) return nullptr;
+      }
+      else {
+        if( code > 8 || end - p < static_cast<std::ptrdiff_t>( code ) ) return nullptr;
+        residual = 0;
+        std::memcpy( &residual, p, code );
+        p += code;
+      }
+      values[i] = std::bit_cast<Real>( std::bit_cast<std::uint64_t>( values[i] ) ^ residual );
+    }
+    return p;
+  }
+
+  //----------------------------------------------------------------------------
+  CouplingTrace::Writer::Writer( const std::filesystem::path& file,
+                                 SizeT numDisplacements,
+                                 SizeT numForces )
+    : file_(file)
+    , out_( file, std::ios::binary )
+    , displacements_( numDisplacements, 0 )
+    , forces_( numForces, 0 )
+    , buffer_()
+    , numRecords_(0)
+    , numBytes_(0)
+  {
+    if( !out_ )
+      throw std::runtime_error(
+        std::format( "ts::CouplingTrace::Writer:Cannot open '{}'", file.string() ) );
+    const std::uint32_t reserved = 0;
+    const std::uint64_t sizes[2] = { numDisplacements, numForces };
+    writeRaw( out_, magic, sizeof(magic) );
+    writeRaw( out_, &version, 1 );
+    writeRaw( out_, &reserved, 1 );
+    writeRaw( out_, sizes, 2 );
+    numBytes_ = sizeof(magic) + 2*sizeof(std::uint32_t) + sizeof(sizes);
+  }
+
+  //----------------------------------------------------------------------------
+  void CouplingTrace::Writer::write( Real                  dt,
+                                     bool                  writeCheckpoint,
+                                     bool                  readCheckpoint,
+                                     std::span<const Real> displacements,
+                                     std::span<const Real> forces )
+  {
+    if( displacements.size() != displacements_.size() || forces.size() != forces_.size() )
+      throw std::runtime_error( "ts::CouplingTrace::Writer::write:Invalid size" );
+
+    buffer_.clear();
+    encode( displacements, displacements_, buffer_ );
+    encode( forces, forces_, buffer_ );
+
+    const std::uint8_t flags = (writeCheckpoint ? writeCheckpointFlag : 0)
+                             | (readCheckpoint  ? readCheckpointFlag  : 0);
+    const std::uint64_t numBytes = buffer_.size();
+    writeRaw( out_, &flags, 1 );
+    writeRaw( out_, &dt, 1 );
+    writeRaw( out_, &numBytes, 1 );
+    writeRaw( out_, buffer_.data(), buffer_.size() );
+    if( !out_ )
+      throw std::runtime_error(
+        std::format( "ts::CouplingTrace::Writer::write:Cannot write '{}'", file_.string() ) );
+    ++numRecords_;
+    numBytes_ += sizeof(flags) + sizeof(dt) + sizeof(numBytes) + numBytes;
+  }
+
+  //----------------------------------------------------------------------------
+  void CouplingTrace::Writer::close( )
+  {
+    if( !out_.is_open() ) return;
+    out_.close();
+    if( !out_ )
+      throw std::runtime_error(
+        std::format( "ts::CouplingTrace::Writer::close:Cannot write '{}'", file_.string() ) );
+  }
+
+  //----------------------------------------------------------------------------
+  CouplingTrace::Reader::Reader( const std::filesystem::path& file )
+    : file_(file)
+    , in_( file, std::ios::binary )
+    , record_()
+    , buffer_()
+    , numRecords_(0)
+  {
+    if( !in_ )
+      throw std::runtime_error(
+        std::format( "ts::CouplingTrace::Reader:Cannot open '{}'", file.string() ) );
+    char          fileMagic[8];
+    std::uint32_t fileVersion = 0, reserved = 0;
+    std::uint64_t sizes[2]    = { 0, 0 };
+    if( !readRaw( in_, fileMagic, sizeof(fileMagic) ) ||
+        !std::equal( fileMagic, fileMagic + sizeof(fileMagic), magic ) ||
+        !readRaw( in_, &fileVersion, 1 ) || fileVersion != version ||
+        !readRaw( in_, &reserved, 1 ) || !readRaw( in_, sizes, 2 ) )
+      throw std::runtime_error(
+        std::format( "ts::CouplingTrace::Reader:'{}' is no coupling trace", file.string() ) );
+    record_.displacements.assign( sizes[0], 0 );
+    record_.forces.assign( sizes[1], 0 );
+  }
+
+  //----------------------------------------------------------------------------
+  bool CouplingTrace::Reader::next( )
+  {
+    std::uint8_t  flags    = 0;
+    std::uint64_t numBytes = 0;
+    in_.read( reinterpret_cast<char*>(&flags), 1 );
+    if( in_.gcount() == 0 ) return false;
+    if( !readRaw( in_, &record_.dt, 1 ) || !readRaw( in_, &numBytes, 1 ) )
+      corrupt( file_, numRecords_ );
+    buffer_.resize( numBytes );
+    if( !readRaw( in_, buffer_.data(), numBytes ) )
+      corrupt( file_, numRecords_ );
+
+    const char* end = buffer_.data() + buffer_.size();
+    const char* p   = decode( buffer_.data(), end, record_.displacements );
+    if( p ) p = decode( p, end, record_.forces );
+    if( p != end ) corrupt( file_, numRecords_ );
+
+    record_.writeCheckpoint = flags & writeCheckpointFlag;
+    record_.readCheckpoint  = flags & readCheckpointFlag;
+    ++numRecords_;
+    return true;
+  }
+
+} // end namespace ts
@@ -0,0 +1,140 @@
+//------------------------------------------------------------------------------
+// <preamble>
+//
+//  ______
+// |
+// | TailSiT GmbH
+// | Graz, Austria
+//   www.tailsit.com
+//
+// </preamble>
+//------------------------------------------------------------------------------
+
+//! @author    Lars Kielhorn, Thomas Rüberg, Jürgen Zechner
+//! @date      2024
+//! @copyright TailSiT GmbH
+#pragma once
+
+// system ----------------------------------------------------------------------
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <span>
+#include <vector>
+
+// own -------------------------------------------------------------------------
+#include "types.hpp"
+
+//------------------------------------------------------------------------------
+namespace ts {
+
+  class CouplingTrace;
+
+}
+
+//------------------------------------------------------------------------------
+/** Binary trace of the coupling traffic, one record per iteration.
+ *
+ *  A record holds the time step size, the checkpoint flags and the
+ *  displacement and force fields exchanged. Fields are stored as the XOR of
+ *  their bits with the previous record's, so barely changing values leave
+ *  mostly zero high bytes; only the low nonzero bytes are kept, their count
+ *  in a nibble per value. A residual equal to the one of the same component
+ *  of the previous vertex is not stored again. The encoding is lossless,
+ *  replayed values are bit-for-bit the recorded ones. Layout, native byte
+ *  order:
+ *   - header { char magic[8] = "TSTRACE", uint32 version, uint32 reserved,
+ *     uint64 numDisplacements, uint64 numForces },
+ *   - records { uint8 flags, double dt, uint64 numBytes, numBytes encoded
+ *     bytes: displacements, then forces }.
+ *  Writer and Reader keep only the previous record, so traces of any length
+ *  are streamed.
+ */
+class ts::CouplingTrace
+{
+public:
+  struct Record
+  {
+    Real              dt              = 0;
+    bool              writeCheckpoint = false;
+    bool              readCheckpoint  = false;
+    std::vector<Real> displacements;
+    std::vector<Real> forces;
+  };
+
+  class Writer;
+  class Reader;
+
+  //! appends values XOR previous to out and stores values in previous
+  static void encode( std::span<const Real> values,
+                      std::span<Real>       previous,
+                      std::vector<char>&    out );
+
+  //! decodes in place: values holds the previous record on entry
+  static const char* decode( const char*     in,
+                             const char*     end,
+                             std::span<Real> values );
+
+}; // end class CouplingTrace
+
+//------------------------------------------------------------------------------
+class ts::CouplingTrace::Writer
+{
+private:
+  std::filesystem::path file_;
+  std::ofstream         out_;
+  std::vector<Real>     displacements_; //!< previous record
+  std::vector<Real>     forces_;
+  std::vector<char>     buffer_;
+  SizeT                 numRecords_;
+  std::uint64_t         numBytes_;
+
+public:
+  Writer( const std::filesystem::path& file, SizeT numDisplacements, SizeT numForces );
+
+  void write( Real                  dt,
+              bool                  writeCheckpoint,
+              bool                  readCheckpoint,
+              std::span<const Real> displacements,
+              std::span<const Real> forces );
+
+  void write( const Record& record )
+  {
+    write( record.dt, record.writeCheckpoint, record.readCheckpoint,
+           record.displacements, record.forces );
+  }
+
+  SizeT numRecords( ) const { return numRecords_; }
+
+  //! written so far, header included
+  std::uint64_t numBytes( ) const { return numBytes_; }
+
+  void close( );
+
+}; // end class CouplingTrace::Writer
+
+//------------------------------------------------------------------------------
+class ts::CouplingTrace::Reader
+{
+private:
+  std::filesystem::path file_;
+  std::ifstream         in_;
+  Record                record_;
+  std::vector<char>     buffer_;
+  SizeT                 numRecords_;
+
+public:
+  explicit Reader( const std::filesystem::path& file );
+
+  SizeT numDisplacements( ) const { return record_.displacements.size(); }
+  SizeT numForces( ) const { return record_.forces.size(); }
+
+  //! reads the next record into record(), false at the end of the trace
+  bool next( );
+
+  const Record& record( ) const { return record_; }
+
+  //! read so far
+  SizeT numRecords( ) const { return numRecords_; }
+
+}; // end class CouplingTrace::Reader
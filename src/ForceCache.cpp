@@ -0,0 +1,84 @@
+//------------------------------------------------------------------------------
+// <preamble>
+//
+//  ______
+// |
+// | TailSiT GmbH
+// | Graz, Austria
+//   www.tailsit.com
+//
+// </preamble>
+//------------------------------------------------------------------------------
+
+//! @author    Lars Kielhorn, Thomas Rüberg, Jürgen Zechner
+//! @date      2024
+//! @copyright TailSiT GmbH
+
+// system ----------------------------------------------------------------------
+#include <algorithm>
+#include <bit>
+#include <cmath>
+
+// own -------------------------------------------------------------------------
+#include "ForceCache.hpp"
+
+//------------------------------------------------------------------------------
+namespace {
+
+  //! the cell of x, or the bits of x (with -0 as 0) if quantum is zero
+  std::int64_t quantize( ts::Real x, ts::Real quantum )
+  {
+    if( quantum > 0 ) return std::llround( x / quantum );
+    return std::bit_cast<std::int64_t>( x + ts::Real(0) );
+  }
+
+} // end anonymous namespace
+
+//------------------------------------------------------------------------------
+namespace ts {
+
+  //----------------------------------------------------------------------------
+  ForceCache::ForceCache( const ForceCacheSettings& settings )
+    : settings_(settings)
+    , entries_( settings.enabled ? std::max<SizeT>( 1, settings.capacity ) : 0 )
+    , numLookups_(0)
+    , numHits_(0)
+  {}
+
+  //----------------------------------------------------------------------------
+  void ForceCache::clear( )
+  {
+    std::ranges::fill( entries_, Entry_() );
+    numLookups_ = 0;
+    numHits_    = 0;
+  }
+
+  //----------------------------------------------------------------------------
+  auto ForceCache::key_( const RigidMotion& motion ) const -> Key_
+  {
+    // quaternion components change by half the angle
+    const Real angularQuantum = settings_.angularTolerance / 2;
+    Key_ key;
+    for( SizeT a = 0; a < 3; ++a )
+      key[a] = quantize( motion.translation[a], settings_.tolerance );
+    for( SizeT a = 0; a < 4; ++a )
+      key[3 + a] = quantize( motion.rotation[a], angularQuantum );
+    return key;
+  }
+
+  //----------------------------------------------------------------------------
+  auto ForceCache::entry_( const Key_& key ) -> Entry_&
+  {
+    // FNV-1a over the words, then a final avalanche
+    std::uint64_t hash = 14695981039346656037ull;
+    for( const auto k : key ) {
+      hash ^= static_cast<std::uint64_t>( k );
+      hash *= 1099511628211ull;
+    }
+    hash ^= hash >> 33;
+    hash *= 0xff51afd7ed558ccdull;
+    hash ^= hash >> 33;
+    return entries_[hash % entries_.size()];
+  }
+
+} // end namespace ts
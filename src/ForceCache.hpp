@@ -0,0 +1,115 @@
+//------------------------------------------------------------------------------
+// <preamble>
+//
+//  ______
+// |
+// | TailSiT GmbH
+// | Graz, Austria
+//   www.tailsit.com
+//
+// </preamble>
+//------------------------------------------------------------------------------
+
+//! @author    Lars Kielhorn, Thomas Rüberg, Jürgen Zechner
+//! @date      2024
+//! @copyright TailSiT GmbH
+#pragma once
+
+// system ----------------------------------------------------------------------
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+// own -------------------------------------------------------------------------
+#include "types.hpp"
+#include "Settings.hpp"
+#include "RigidMotion.hpp"
+
+//------------------------------------------------------------------------------
+namespace ts {
+
+  class ForceCache;
+
+}
+
+//------------------------------------------------------------------------------
+/** Memoized force model evaluations, keyed on the rigid motion.
+ *
+ *  Translation and rotation are quantized by tolerance and
+ *  angularTolerance; motions in the same cell share the force evaluated
+ *  first, so the error is bounded by the model's gradient times the
+ *  quantum. With zero tolerances keys are the exact bit patterns. The
+ *  table is direct mapped with capacity entries: a key hashes to one
+ *  entry, which a miss overwrites. Time is not part of the key.
+ */
+class ts::ForceCache
+{
+public:
+  using Force = std::array<Real,3>;
+
+private:
+  using Key_ = std::array<std::int64_t,7>;
+
+  struct Entry_
+  {
+    Key_  key   = {};
+    Force force = {};
+    bool  valid = false;
+  };
+
+  ForceCacheSettings  settings_;
+  std::vector<Entry_> entries_;
+  SizeT               numLookups_;
+  SizeT               numHits_;
+
+public:
+  explicit ForceCache( const ForceCacheSettings& settings );
+
+  bool enabled( ) const { return settings_.enabled; }
+
+  //! forget all entries and counts
+  void clear( );
+
+  //! force(time, motion, F), or the cached F for motion
+  template< typename FORCE >
+  void operator()( const FORCE& force, Real time, const RigidMotion& motion,
+                   std::span<Real,3> F );
+
+  SizeT numLookups( ) const { return numLookups_; }
+  SizeT numHits( ) const { return numHits_; }
+
+private:
+  Key_ key_( const RigidMotion& motion ) const;
+
+  Entry_& entry_( const Key_& key );
+
+}; // end class ForceCache
+
+//============================================================================
+//
+// IMPLEMENTATION
+//
+//============================================================================
+template< typename FORCE >
+void ts::ForceCache::operator()( const FORCE& force, Real time, const RigidMotion& motion,
+                                 std::span<Real,3> F )
+{
+  if( !settings_.enabled ) {
+    force( time, motion, F );
+    return;
+  }
+  ++numLookups_;
+  const Key_ key = key_( motion );
+  Entry_& entry = entry_( key );
+  if( entry.valid && entry.key == key ) {
+    ++numHits_;
+    std::ranges::copy( entry.force, F.begin() );
+    return;
+  }
+  force( time, motion, F );
+  entry.key   = key;
+  entry.valid = true;
+  std::ranges::copy( F, entry.force.begin() );
+}
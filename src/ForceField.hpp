@@ -0,0 +1,129 @@
+//------------------------------------------------------------------------------
+// <preamble>
+//
+//  ______
+// |
+// | TailSiT GmbH
+// | Graz, Austria
+//   www.tailsit.com
+//
+// </preamble>
+//------------------------------------------------------------------------------
+
+//! @author    Lars Kielhorn, Thomas Rüberg, Jürgen Zechner
+//! @date      2024
+//! @copyright TailSiT GmbH
+#pragma once
+
+// system ----------------------------------------------------------------------
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <span>
+#include <utility>
+#include <vector>
+
+// own -------------------------------------------------------------------------
+#include "types.hpp"
+#include "Parallel.hpp"
+#include "RigidMotion.hpp"
+#include "Simd.hpp"
+
+//------------------------------------------------------------------------------
+namespace ts {
+
+  //----------------------------------------------------------------------------
+  /** Per-vertex force field of a force model: vertex i gets weight F(U_i),
+   *  the model evaluated as if the body's reference point sat at the
+   *  vertex's current position, U_i = x_i + u_i - center. For a body small
+   *  against the scale of the model this reproduces the uniform force.
+   *
+   *  Models offering evalAxial(s, F) (the sigmoid) are evaluated in SIMD
+   *  packs over blocks of vertices if the build targets a vector ISA (see
+   *  simd::Pack), else by eval(s) vertex by vertex, as blocking scalar
+   *  evaluations only adds overhead. All others go through operator()
+   *  vertex by vertex. The
+   *  vertices are split into up to pool.size() contiguous chunks, each
+   *  writing its part of forces directly.
+   *
+   *  With vertexWeights, vertex i gets weight * vertexWeights[i] instead.
+   *
+   *  The fields are stored as T (see Storage); the model is evaluated and
+   *  the forces are summed in Real.
+   *
+   *  @return the sum of the forces, before they are rounded to T
+   */
+  template< typename FORCE, typename T >
+  std::array<Real,3> evalForceField( const FORCE&              force,
+                                     Real                      time,
+                                     const std::array<Real,3>& center,
+                                     std::span<const T>        coords,
+                                     std::span<const T>        displacements,
+                                     Real                      weight,
+                                     std::span<T>              forces,
+                                     parallel::ThreadPool&     pool,
+                                     std::span<const Real>     vertexWeights = {} )
+  {
+    static constexpr SizeT dim       = 3;
+    static constexpr SizeT blockSize = 256;
+    const SizeT numVertices = coords.size() / dim;
+    const SizeT numChunks   = std::clamp<SizeT>( numVertices / (4*blockSize), 1, pool.size() );
+    std::vector<std::array<Real,dim>> sums( numChunks, { 0, 0, 0 } );
+
+    pool.forEachChunk( numVertices, numChunks, [&]( SizeT c, SizeT begin, SizeT end ) {
+      auto& sum = sums[c];
+      if constexpr( requires { force.evalAxial( std::span<const Real>(), std::span<Real>() ); } ) {
+        const SizeT axis = force.axis();
+        if constexpr( simd::Pack::size == 1 ) {
+          for( SizeT i = begin; i < end; ++i ) {
+            const SizeT k = dim*i + axis;
+            const Real fAxis = ( vertexWeights.empty() ? weight : weight * vertexWeights[i] )
+                             * force.eval( std::abs( coords[k] + displacements[k] - center[axis] ) );
+            T* f = forces.data() + dim*i;
+            f[0] = f[1] = f[2] = 0;
+            f[axis]    = static_cast<T>( fAxis );
+            sum[axis] += fAxis;
+          }
+        }
+        else {
+          Real s[blockSize], F[blockSize];
+          for( SizeT b = begin; b < end; b += blockSize ) {
+            const SizeT n = std::min( blockSize, end - b );
+            for( SizeT j = 0; j < n; ++j ) {
+              const SizeT k = dim*(b + j) + axis;
+              s[j] = std::abs( coords[k] + displacements[k] - center[axis] );
+            }
+            force.evalAxial( std::span<const Real>( s, n ), std::span<Real>( F, n ) );
+            for( SizeT j = 0; j < n; ++j ) {
+              T* f = forces.data() + dim*(b + j);
+              const Real fAxis = ( vertexWeights.empty() ? weight : weight * vertexWeights[b + j] ) * F[j];
+              f[0] = f[1] = f[2] = 0;
+              f[axis]    = static_cast<T>( fAxis );
+              sum[axis] += fAxis;
+            }
+          }
+        }
+      }
+      else {
+        RigidMotion motion;
+        std::array<Real,dim> F;
+        for( SizeT i = begin; i < end; ++i ) {
+          for( SizeT a = 0; a < dim; ++a )
+            motion.translation[a] = coords[dim*i + a] + displacements[dim*i + a] - center[a];
+          force( time, std::as_const( motion ), F );
+          const Real w = vertexWeights.empty() ? weight : weight * vertexWeights[i];
+          for( SizeT a = 0; a < dim; ++a ) {
+            forces[dim*i + a] = static_cast<T>( w * F[a] );
+            sum[a] += w * F[a];
+          }
+        }
+      }
+    } );
+
+    std::array<Real,dim> total = { 0, 0, 0 };
+    for( const auto& sum : sums )
+      for( SizeT a = 0; a < dim; ++a ) total[a] += sum[a];
+    return total;
+  }
+
+} // end namespace ts
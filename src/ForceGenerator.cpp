@@ -18,7 +18,6 @@
 #include <algorithm>
 #include <stdexcept>
 #include <format>
-#include <fstream>
 
 // own -------------------------------------------------------------------------
 #include "ForceGenerator.hpp"
@@ -27,83 +26,221 @@
 namespace ts {
 
   //----------------------------------------------------------------------------
-  ForceGenerator::ForceGenerator( std::span<const Real> coords,
-                                  const Settings&       settings )
-    : coords_(coords.begin(),coords.end())
+  template< typename T >
+  BasicForceGenerator<T>::BasicForceGenerator( std::span<const Real> coords,
+                                               const Settings&       settings,
+                                               const Communicator&   comm )
+    : decimation_( coords, settings.decimation, comm )
+    , order_( spaceFillingOrder( decimation_.coordinates(), settings.vertexOrdering ) )
+    , coords_( toInternal_( decimation_.coordinates() ) )
     , currentDisplacements_( coords_.size() )
     , settings_(settings)
+    , comm_(comm)
+    , numGlobalCoordinates_( comm.allReduceSum( coords_.size() / dimMesh_ ) )
     , currentTime_(0)
     , solution_()
-    , previousState_(nullptr)
+    , pool_( std::make_shared<parallel::ThreadPool>( settings.numThreads ) )
+    , rigidMotionFit_( coords_, settings.numThreads, comm, pool_ )
+    , rigidMotion_()
+    , forceField_( settings.forceField == Settings::ForceField::perVertex ? coords_.size() : 0 )
+    , vertexWeights_()
+    , pointCenter_()
+    , timeStepControl_( settings.timeStep, settings.dt )
+    , forceCache_( settings.forceCache )
+    , bufferSolved_(false)
+    , solvedTime_(0)
+    , solvedMotion_()
+    , solvedSolution_()
+    , numSkipped_(0)
+    , forcesVersion_(1)
+    , savedStates_( std::max<SizeT>( 1, settings.numCheckpoints ),
+                    SavedState_{ {}, {}, {}, 0, timeStepControl_ } )
+    , newestState_(0)
+    , numSavedStates_(0)
+    , displacementsStale_(false)
     , samplingForce_( std::make_unique<SamplingForce_>() )
+    , profiler_( settings.profiling )
+    , telemetry_(nullptr)
+    , telemetrySlot_(0)
+    , numReloads_(0)
   {
-    // empty
+    for( auto& state : savedStates_ )
+      state.displacements.resize( coords_.size() );
+
+    // forces in proportion to the points of a vertex, in the internal order
+    if( settings.decimation.enabled ) {
+      const auto counts = decimation_.counts();
+      const Real numGlobalPoints =
+        static_cast<Real>( comm.allReduceSum( decimation_.vertexMap().size() ) );
+      vertexWeights_.resize( counts.size() );
+      for( SizeT n = 0; n < counts.size(); ++n ) {
+        vertexWeights_[n] = static_cast<Real>( counts[order_.empty() ? n : order_[n]] ) / numGlobalPoints;
+        for( SizeT a = 0; a < dimMesh_; ++a )
+          pointCenter_[a] += vertexWeights_[n] * coords_[dimMesh_*n + a];
+      }
+      comm.allReduceSum( pointCenter_ );
+    }
   }
 
   //----------------------------------------------------------------------------
-  void ForceGenerator::start( )
+  template< typename T >
+  void BasicForceGenerator<T>::start( )
   {
     std::ranges::fill( solution_, 0 );
+    std::ranges::fill( forceField_, 0 );
     std::ranges::fill( currentDisplacements_, 0 );
+    currentTime_        = 0;
+    displacementsStale_ = false;
+    bufferSolved_       = false;
+    numSavedStates_     = 0;
+    numSkipped_         = 0;
+    ++forcesVersion_;
+    rigidMotion_ = rigidMotionFit_( coords_, currentDisplacements_ );
+    timeStepControl_.reset();
+    forceCache_.clear();
+    if( comm_.isRoot() )
+      samplingForce_ -> writer =
+        std::make_unique<ForceSampleWriter>( settings_.samplesFile, settings_.binarySamples );
+    samplingForce_ -> pending.clear();
+    profiler_.reset();
+    numReloads_ = 0;
+    if( telemetry_ ) publishTelemetry_();
   }
 
   //----------------------------------------------------------------------------
-  void ForceGenerator::stop( )
+  template< typename T >
+  void BasicForceGenerator<T>::stop( )
   {
-    static constexpr std::string_view csvOut = "forces.csv";
-    if( !(samplingForce_ -> samples).empty() ) {
-      const auto& samples = samplingForce_ -> samples;
-      std::ofstream out(csvOut.data());
-      out << std::format("#{:>13s},{:>14s},{:>14s},{:>14s},{:>14s},{:>14s}\n",
-                         "U0", "U1", "U2", "F0", "F1", "F2");
-      for( const auto& row : samples ) {
-        out << std::format( "{:>14.7e},{:>14.7e},{:>14.7e},{:>14.7e},{:>14.7e},{:>14.7e}\n",
-                            row[0], row[1], row[2], row[3], row[4], row[5] );
-      }
+    samplingForce_ -> flush();
+    if( samplingForce_ -> writer ) {
+      samplingForce_ -> writer -> close();
+      samplingForce_ -> writer = nullptr;
     }
   }
 
   //----------------------------------------------------------------------------
-  bool ForceGenerator::isRunning( ) const
+  template< typename T >
+  bool BasicForceGenerator<T>::isRunning( ) const
   {
     return currentTime_ <= settings_.endt;
   }
 
   //----------------------------------------------------------------------------
-  Real ForceGenerator::beginTimeStep( )
+  template< typename T >
+  Real BasicForceGenerator<T>::beginTimeStep( )
+  {
+    return timeStepControl_.propose();
+  }
+
+  //----------------------------------------------------------------------------
+  template< typename T >
+  void BasicForceGenerator<T>::endTimeStep( Real dt )
+  {
+    const Profiler::Scope scope( profiler_, Profiler::Phase::endTimeStep );
+    endSubstep_( dt );
+    endWindow_();
+  }
+
+  //----------------------------------------------------------------------------
+  template< typename T >
+  void BasicForceGenerator<T>::endSubstep( Real dt )
   {
-    return settings_.dt;
+    const Profiler::Scope scope( profiler_, Profiler::Phase::endTimeStep );
+    endSubstep_( dt );
   }
 
   //----------------------------------------------------------------------------
-  void ForceGenerator::endTimeStep( )
+  template< typename T >
+  void BasicForceGenerator<T>::endWindow( )
   {
-    previousState_ = nullptr;
+    const Profiler::Scope scope( profiler_, Profiler::Phase::endTimeStep );
+    endWindow_();
   }
 
   //----------------------------------------------------------------------------
-  SizeT ForceGenerator::numCoordinates( ) const
+  template< typename T >
+  void BasicForceGenerator<T>::endSubstep_( Real dt )
+  {
+    currentTime_ += dt;
+    timeStepControl_.accept( currentTime_, rigidMotion_.translation );
+  }
+
+  //----------------------------------------------------------------------------
+  template< typename T >
+  void BasicForceGenerator<T>::endWindow_( )
+  {
+    profiler_.endWindow();
+
+    // without checkpoints every window is final, so are its samples; with
+    // them a window is final once the next checkpoint is written
+    // (saveOldState)
+    if( numSavedStates_ == 0 )
+      samplingForce_ -> flush();
+    if( telemetry_ ) publishTelemetry_();
+  }
+
+  //----------------------------------------------------------------------------
+  template< typename T >
+  SizeT BasicForceGenerator<T>::numCoordinates( ) const
   {
     return coords_.size() / dimMesh_;
   }
     
   //----------------------------------------------------------------------------
-  void ForceGenerator::getCoordinates( std::span<Real> coords ) const
+  template< typename T >
+  void BasicForceGenerator<T>::getCoordinates( std::span<Real> coords ) const
   {
-    std::ranges::copy( coords_, coords.begin() );
+    toInput_( coords_, coords );
   }
 
   //----------------------------------------------------------------------------
-  void ForceGenerator::set( std::string_view fieldname,
+  template< typename T >
+  void BasicForceGenerator<T>::set( std::string_view fieldname,
                             std::span<const Real> displacements )
   {
-    if( fieldname == strDisplacements_ )
-      std::ranges::copy( displacements, currentDisplacements_.begin() );
-    else if( fieldname == strDisplacementDeltas_ )
-      std::ranges::transform( displacements,
-                              currentDisplacements_,
-                              currentDisplacements_.begin(),
-                              []( auto dU, auto Unm1 ) { return dU + Unm1; } );
+    const Profiler::Scope scope( profiler_, Profiler::Phase::set );
+    if( fieldname == strDisplacements_ && !order_.empty() ) {
+      // gather, comparing with the field of the last fit on the way
+      bool changed = false;
+      for( SizeT n = 0; n < order_.size(); ++n )
+        for( SizeT a = 0; a < dimMesh_; ++a ) {
+          const T u = static_cast<T>( displacements[dimMesh_*order_[n] + a] );
+          changed |= currentDisplacements_[dimMesh_*n + a] != u;
+          currentDisplacements_[dimMesh_*n + a] = u;
+        }
+      bufferSolved_       = bufferSolved_ && !changed;
+      displacementsStale_ = false;
+    }
+    else if( fieldname == strDisplacements_ ) {
+      if( bufferSolved_ ) {
+        // does the field differ from the one of the last fit, as stored?
+        bool changed = false;
+        for( SizeT i = 0; i < displacements.size(); ++i ) {
+          const T u = static_cast<T>( displacements[i] );
+          changed |= currentDisplacements_[i] != u;
+          currentDisplacements_[i] = u;
+        }
+        bufferSolved_ = !changed;
+      }
+      else
+        std::ranges::copy( displacements, currentDisplacements_.begin() );
+      displacementsStale_ = false;
+    }
+    else if( fieldname == strDisplacementDeltas_ ) {
+      materializeDisplacements_();
+      if( std::ranges::any_of( displacements, []( Real dU ) { return dU != 0; } ) )
+        bufferSolved_ = false;
+      if( !order_.empty() ) {
+        for( SizeT n = 0; n < order_.size(); ++n )
+          for( SizeT a = 0; a < dimMesh_; ++a )
+            currentDisplacements_[dimMesh_*n + a] += displacements[dimMesh_*order_[n] + a];
+      }
+      else
+        std::ranges::transform( displacements,
+                                currentDisplacements_,
+                                currentDisplacements_.begin(),
+                                []( auto dU, auto Unm1 ) { return dU + Unm1; } );
+    }
     else {
       const std::string msg = std::format( "ts::ForceGenerator::set:Invalid fieldname '{}'",
                                            fieldname );
@@ -112,9 +249,11 @@ namespace ts {
   }
 
   //----------------------------------------------------------------------------
-  void ForceGenerator::get( std::string_view fieldname,
+  template< typename T >
+  void BasicForceGenerator<T>::get( std::string_view fieldname,
                             std::span<Real>  forces ) const
   {
+    const Profiler::Scope scope( profiler_, Profiler::Phase::get );
     if( fieldname != strForces_ ) {
       const std::string msg =
         std::format( "ts::ForceGenerator::get::fieldname '{}' is invalid",
@@ -125,31 +264,174 @@ namespace ts {
     const SizeT numForces = forces.size() / dimMesh_;
     if( numForces * dimMesh_ - forces.size() != 0 )
       throw std::runtime_error( "ForceGenerator::getForces():Invalid size" );
+
+    if( settings_.forceField == Settings::ForceField::perVertex ) {
+      if( forces.size() != forceField_.size() )
+        throw std::runtime_error( "ForceGenerator::getForces():Invalid size" );
+      toInput_( forceField_, forces );
+      return;
+    }
+
+    // the total force over all ranks is the solution, spread over the points
+    if( !vertexWeights_.empty() ) {
+      if( numForces != vertexWeights_.size() )
+        throw std::runtime_error( "ForceGenerator::getForces():Invalid size" );
+      for( SizeT n = 0; n < vertexWeights_.size(); ++n ) {
+        const SizeT i = order_.empty() ? n : order_[n];
+        for( SizeT a = 0; a < dimMesh_; ++a )
+          forces[dimMesh_*i + a] = vertexWeights_[n] * solution_[a];
+      }
+      return;
+    }
+    const SizeT numGlobalForces = comm_.size() == 1 ? numForces : numGlobalCoordinates_;
     std::array<Real,dimMesh_> avgSol;
     std::ranges::transform( solution_, avgSol.begin(),
-                            [numForces]( Real f ) { return f/numForces; } );
+                            [numGlobalForces]( Real f ) { return f/numGlobalForces; } );
     for( SizeT n = 0; n < numForces; ++n )
       std::ranges::copy( avgSol, forces.begin() + n*dimMesh_ );
   }
 
   //----------------------------------------------------------------------------
-  void ForceGenerator::saveOldState( )
+  template< typename T >
+  void BasicForceGenerator<T>::saveOldState( )
   {
-    SavedState_ ss;
-    ss.displacements = currentDisplacements_;
-    ss.solution      = solution_;
-    ss.time          = currentTime_;
-    previousState_ = std::make_unique<SavedState_>(std::move(ss));
+    const Profiler::Scope scope( profiler_, Profiler::Phase::checkpointSave );
+    samplingForce_ -> flush(); // of the window accepted before
+    materializeDisplacements_();
+
+    newestState_    = (newestState_ + 1) % savedStates_.size();
+    numSavedStates_ = std::min( numSavedStates_ + 1, savedStates_.size() );
+    auto& state = savedStates_[newestState_];
+
+    // the next set() overwrites all displacements, no need to keep ours
+    if( settings_.inField == strDisplacements_ ) {
+      std::swap( state.displacements, currentDisplacements_ );
+      displacementsStale_ = true;
+      bufferSolved_       = false;
+    }
+    else
+      std::ranges::copy( currentDisplacements_, state.displacements.begin() );
+
+    state.solution    = solution_;
+    state.rigidMotion = rigidMotion_;
+    state.time        = currentTime_;
+    state.timeStepControl = timeStepControl_;
   }
   
   //----------------------------------------------------------------------------
-  void ForceGenerator::reloadOldState( )
+  template< typename T >
+  void BasicForceGenerator<T>::reloadOldState( SizeT windowsBack )
   {
-    if( !previousState_ )
+    if( windowsBack >= numSavedStates_ )
       throw std::runtime_error( "ForceGenerator::reloadOldState::State not available!" );
-    currentDisplacements_ = previousState_ -> displacements;
-    currentTime_          = previousState_ -> time;
-    solution_             = previousState_ -> solution;
+    const Profiler::Scope scope( profiler_, Profiler::Phase::checkpointReload );
+
+    // drop the checkpoints of the windows rolled back over
+    const SizeT n = savedStates_.size();
+    newestState_     = (newestState_ + n - windowsBack) % n;
+    numSavedStates_ -= windowsBack;
+
+    const auto& state = savedStates_[newestState_];
+    displacementsStale_ = true;
+    currentTime_        = state.time;
+    solution_           = state.solution;
+    rigidMotion_        = state.rigidMotion;
+    timeStepControl_    = state.timeStepControl;
+    ++forcesVersion_;
+    samplingForce_ -> pending.clear();
+    ++numReloads_;
+    if( telemetry_ ) publishTelemetry_();
+  }
+
+  //----------------------------------------------------------------------------
+  template< typename T >
+  void BasicForceGenerator<T>::attachTelemetry( Telemetry& telemetry, SizeT slot )
+  {
+    telemetry_     = &telemetry;
+    telemetrySlot_ = slot;
+    publishTelemetry_();
+  }
+
+  //----------------------------------------------------------------------------
+  template< typename T >
+  void BasicForceGenerator<T>::publishTelemetry_( ) const
+  {
+    Telemetry::Counters counters;
+    counters.time          = currentTime_;
+    counters.updated       = Telemetry::now();
+    counters.window        = profiler_.numWindows();
+    counters.iteration     = profiler_.iteration();
+    counters.numIterations = profiler_.numIterations();
+    counters.numReloads    = numReloads_;
+    counters.numSkipped    = numSkipped_;
+    counters.translation   = rigidMotion_.translation;
+    counters.force         = solution_;
+    counters.profiling     = profiler_.enabled();
+    for( SizeT p = 0; p < Profiler::numPhases; ++p ) {
+      const auto phase = static_cast<Profiler::Phase>( p );
+      counters.phaseTotals[p] = profiler_.total( phase );
+      counters.phaseCalls[p]  = profiler_.calls( phase );
+    }
+    telemetry_ -> publish( telemetrySlot_, counters );
+  }
+
+  //----------------------------------------------------------------------------
+  template< typename T >
+  void BasicForceGenerator<T>::materializeDisplacements_( )
+  {
+    if( !displacementsStale_ ) return;
+    std::ranges::copy( savedStates_[newestState_].displacements,
+                       currentDisplacements_.begin() );
+    displacementsStale_ = false;
+    bufferSolved_       = false;
+  }
+
+  //----------------------------------------------------------------------------
+  template< typename T >
+  std::vector<T> BasicForceGenerator<T>::toInternal_( std::span<const Real> values ) const
+  {
+    if( order_.empty() ) return std::vector<T>( values.begin(), values.end() );
+    std::vector<T> internal( values.size() );
+    for( SizeT n = 0; n < order_.size(); ++n )
+      for( SizeT a = 0; a < dimMesh_; ++a )
+        internal[dimMesh_*n + a] = values[dimMesh_*order_[n] + a];
+    return internal;
+  }
+
+  //----------------------------------------------------------------------------
+  template< typename T >
+  void BasicForceGenerator<T>::toInput_( std::span<const T> values, std::span<Real> input ) const
+  {
+    if( order_.empty() ) {
+      std::ranges::copy( values, input.begin() );
+      return;
+    }
+    for( SizeT n = 0; n < order_.size(); ++n )
+      for( SizeT a = 0; a < dimMesh_; ++a )
+        input[dimMesh_*order_[n] + a] = values[dimMesh_*n + a];
+  }
+
+  //----------------------------------------------------------------------------
+  template< typename T >
+  void BasicForceGenerator<T>::SamplingForce_::add( const Row& row, bool convergedOnly )
+  {
+    if( convergedOnly )
+      pending.push_back( row );
+    else if( writer )
+      writer -> push( row );
+  }
+
+  //----------------------------------------------------------------------------
+  template< typename T >
+  void BasicForceGenerator<T>::SamplingForce_::flush( )
+  {
+    if( writer )
+      for( const auto& row : pending ) writer -> push( row );
+    pending.clear();
   }
   
+  //----------------------------------------------------------------------------
+  template class BasicForceGenerator<float>;
+  template class BasicForceGenerator<double>;
+
 }; // end class ForceGenerator
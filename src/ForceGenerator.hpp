@@ -21,20 +21,40 @@
 #include <vector>
 #include <memory>
 #include <string>
+#include <utility>
 
 // own -------------------------------------------------------------------------
 #include "types.hpp"
 #include "Settings.hpp"
+#include "RigidMotion.hpp"
+#include "Communicator.hpp"
+#include "ForceCache.hpp"
+#include "ForceField.hpp"
+#include "Parallel.hpp"
+#include "ForceSampleWriter.hpp"
+#include "VertexOrdering.hpp"
+#include "VoxelDecimation.hpp"
+#include "Profiler.hpp"
+#include "Telemetry.hpp"
+#include "TimeStepControl.hpp"
 
 //------------------------------------------------------------------------------
 namespace ts {
 
-  class ForceGenerator;
+  template< typename T > class BasicForceGenerator;
+
+  //! the adapter's solver, its fields stored as configured (TS_FLOAT_STORAGE)
+  using ForceGenerator = BasicForceGenerator<Storage>;
 
 }
   
 //------------------------------------------------------------------------------
-class ts::ForceGenerator
+/** The dummy solver. It keeps its per-vertex fields, coordinates,
+ *  displacements, checkpoints and force field, as T (float or double);
+ *  the fields passed in and out, the fit and all forces and sums are Real.
+ */
+template< typename T >
+class ts::BasicForceGenerator
 {
   static constexpr Int dimMesh_ = 3;
   static constexpr std::string_view strDisplacements_      = "Displacements";
@@ -42,32 +62,86 @@ class ts::ForceGenerator
   static constexpr std::string_view strForces_             = "Forces";
   
 private:
-  std::vector<Real>         coords_;
-  std::vector<Real>         currentDisplacements_;
+  VoxelDecimation           decimation_; //!< the coupled vertices
+  std::vector<SizeT>        order_;  //!< internal vertex i is input vertex order_[i], empty: same
+  std::vector<T>            coords_;
+  std::vector<T>            currentDisplacements_;
   Settings                  settings_;
+  Communicator              comm_;
+  SizeT                     numGlobalCoordinates_;
   Real                      currentTime_;
   std::array<Real,dimMesh_> solution_; // well, not really a solution just the evaluated force
+  std::shared_ptr<parallel::ThreadPool> pool_; //!< workers of the fit and the force field
+  RigidMotionFit            rigidMotionFit_;
+  RigidMotion               rigidMotion_;
+  std::vector<T>            forceField_; //!< per-vertex forces, ForceField::perVertex only
+  std::vector<Real>         vertexWeights_; //!< share of all points per vertex, decimation only
+  std::array<Real,dimMesh_> pointCenter_;  //!< centroid of all points, decimation only
+  TimeStepControl           timeStepControl_;
+  ForceCache                forceCache_;
+
+  /** Unchanged field skip: while bufferSolved_, currentDisplacements_ holds
+   *  the field of the last fit (even if displacementsStale_), which gave
+   *  solvedMotion_ and solvedSolution_ at solvedTime_. set() compares
+   *  against it while copying, so an implicit iteration that repeats the
+   *  field neither fits nor evaluates again. */
+  bool                      bufferSolved_;
+  Real                      solvedTime_;
+  RigidMotion               solvedMotion_;
+  std::array<Real,dimMesh_> solvedSolution_;
+  SizeT                     numSkipped_;
+  SizeT                     forcesVersion_; //!< see forcesVersion()
   
   struct SavedState_
   {
-    std::vector<Real>         displacements;
+    std::vector<T>            displacements;
     std::array<Real,dimMesh_> solution;
+    RigidMotion               rigidMotion;
     Real                      time;
+    TimeStepControl           timeStepControl;
   };
-  std::unique_ptr<SavedState_> previousState_;
+
+  /** Preallocated ring of the last settings_.numCheckpoints states.
+   *
+   *  Saving swaps buffers instead of copying if the next set() overwrites
+   *  all displacements anyway; reloading only marks the checkpoint as the
+   *  valid displacement field. In both cases currentDisplacements_ is stale
+   *  until the next full set() or until materializeDisplacements_() copies
+   *  the checkpoint back.
+   */
+  std::vector<SavedState_> savedStates_;
+  SizeT                    newestState_;
+  SizeT                    numSavedStates_;
+  bool                     displacementsStale_;
 
   struct SamplingForce_
   {
-    using Row = std::array< Real,6 >;
-    using Table = std::vector<Row>;
+    using Row = ForceSampleWriter::Row;
+
+    std::unique_ptr<ForceSampleWriter> writer;  //!< null before start(), after stop() and off root
+    std::vector<Row>                   pending; //!< current window, if convergedSamplesOnly
 
-    Table samples;
+    void add( const Row& row, bool convergedOnly );
+
+    //! the pending samples are accepted
+    void flush( );
   };
   std::unique_ptr<SamplingForce_> samplingForce_;
+
+  mutable Profiler profiler_; //!< times get(), too
+
+  Telemetry* telemetry_;     //!< live counters, none if null
+  SizeT      telemetrySlot_;
+  SizeT      numReloads_;
   
 public:
-  ForceGenerator( std::span<const Real> coords,
-                  const Settings& settings );
+  /** coords are this rank's part of the point cloud; the force acts on the
+   *  whole cloud and is distributed evenly over the vertices of all ranks,
+   *  or, with ForceField::perVertex, evaluated at every vertex (see
+   *  evalForceField). Only the root rank samples forces, the total ones. */
+  BasicForceGenerator( std::span<const Real> coords,
+                       const Settings& settings,
+                       const Communicator& comm = Communicator() );
 
 
   /** @name static data */
@@ -77,56 +151,163 @@ public:
   
   /** @name solver controls */
   //@{
+  /** Resets the solver and opens the samples file. Forces are sampled only
+   *  between start() and stop(); solves outside, e.g. a get() before the
+   *  first start(), are not recorded. */
   void start( );
 
+  //! flushes the pending samples and closes the samples file
   void stop( );
 
   bool isRunning( ) const;
 
+  //! rigid motion fitted to the displacements in the last solveTimeStep
+  const RigidMotion& rigidMotion( ) const { return rigidMotion_; }
+
+  //! phase timers, shared with the coupling loop; reset by start()
+  Profiler& profiler( ) const { return profiler_; }
+
+  //! memoized force evaluations; reset by start()
+  const ForceCache& forceCache( ) const { return forceCache_; }
+
+  //! solveTimeStep calls that found the field unchanged
+  SizeT numSkipped( ) const { return numSkipped_; }
+
+  /** changes whenever the forces get() fills in may have changed, never 0:
+   *  a caller still holding the forces of this version need not get() them */
+  SizeT forcesVersion( ) const { return forcesVersion_; }
+
+  /** Publish the counters into the telemetry's slot after every solve,
+   *  reload and accepted step; the telemetry must outlive the coupling */
+  void attachTelemetry( Telemetry& telemetry, SizeT slot );
+
+  //! the proposed step size, Settings::dt or the adaptive one
   Real beginTimeStep( );
   
   template< typename FORCE >
   void solveTimeStep( FORCE&& force, bool sampleForce = false );
 
-  void endTimeStep( );
+  //! the step of size dt is accepted and ends the window: endSubstep, endWindow
+  void endTimeStep( Real dt );
+
+  //! a substep of size dt is done; the window goes on (subcycling)
+  void endSubstep( Real dt );
+
+  //! the window, of one or several substeps, is accepted
+  void endWindow( );
+
+  Real currentTime( ) const { return currentTime_; }
   //@}
 
   /** @name mesh information */
   //@{
   SizeT numCoordinates( ) const;
+  SizeT numGlobalCoordinates( ) const { return numGlobalCoordinates_; }
+  //! in the input order, whatever Settings::vertexOrdering
   void getCoordinates( std::span<Real> coords ) const;
+
+  /** the coupled vertices, and the points given to the constructor they
+   *  stand for; undecimated, its coordinates() view those points, so use
+   *  getCoordinates() once they are gone */
+  const VoxelDecimation& decimation( ) const { return decimation_; }
   //@}
 
   /** @name set displacements / get forces ... nothing else */
   //@{
+  //! fields are in the input vertex order, whatever Settings::vertexOrdering
   void set( std::string_view fieldname, std::span<const Real> displacements );
   
+  //! always fills all of forces; see forcesVersion() for when to call it
   void get( std::string_view fieldname, std::span<Real> forces ) const;
   //@}
 
   /** @name save/load state [for implicit schemes] */
   //@{
   void saveOldState( );
-  void reloadOldState( );
+
+  //! restore the newest checkpoint, or roll back windowsBack more windows
+  void reloadOldState( SizeT windowsBack = 0 );
+
+  SizeT numSavedStates( ) const { return numSavedStates_; }
   //@}
+
+private:
+  void materializeDisplacements_( );
+
+  void endSubstep_( Real dt );
+
+  void endWindow_( );
+
+  void publishTelemetry_( ) const;
+
+  //! vertex values in the input order, gathered into the internal one
+  std::vector<T> toInternal_( std::span<const Real> values ) const;
+
+  //! internal vertex values, scattered into the input order
+  void toInput_( std::span<const T> values, std::span<Real> input ) const;
   
-}; // end class ForceGenerator
+}; // end class BasicForceGenerator
 
 //============================================================================
 //
 // IMPLEMENTATION
 //
 //============================================================================
+template< typename T >
 template< typename FORCE >
-void ts::ForceGenerator::solveTimeStep( FORCE&& force, bool sampleForce ) 
+void ts::BasicForceGenerator<T>::solveTimeStep( FORCE&& force, bool sampleForce ) 
 {
-  // this is all about rigid body movement (without rotations!)
-  // Thus, the very first displacement is as good as any other
-  auto U = std::span<const Real,3>{ currentDisplacements_.data(), dimMesh_ };
-  force( currentTime_, U, solution_ );
+  using Phase = Profiler::Phase;
+  profiler_.beginIteration();
+  const Profiler::Scope scope( profiler_, Phase::solve );
+
+  // the field of the last fit, at the same time: same motion, same force;
+  // the fit is collective, so is the decision
+  bool unchanged = bufferSolved_ && !displacementsStale_ && solvedTime_ == currentTime_;
+  if( comm_.size() > 1 )
+    unchanged = comm_.allReduceSum( SizeT( !unchanged ) ) == 0;
+  if( unchanged ) {
+    if( solution_ != solvedSolution_ ) ++forcesVersion_; // after a reload
+    rigidMotion_ = solvedMotion_;
+    solution_    = solvedSolution_;
+    ++numSkipped_;
+  }
+  else {
+    // this is all about rigid body movement: fit it over all vertices, so
+    // that mapping noise on single vertices averages out
+    {
+      const Profiler::Scope fit( profiler_, Phase::fit );
+      materializeDisplacements_();
+      rigidMotion_ = rigidMotionFit_( coords_, currentDisplacements_ );
+    }
+    {
+      const Profiler::Scope eval( profiler_, Phase::force );
+      if( settings_.forceField == Settings::ForceField::perVertex ) {
+        const Real weight = vertexWeights_.empty()
+                          ? Real(1) / static_cast<Real>( numGlobalCoordinates_ ) : Real(1);
+        solution_ = evalForceField( force, currentTime_,
+                                    vertexWeights_.empty() ? rigidMotion_.center : pointCenter_,
+                                    std::span<const T>( coords_ ),
+                                    std::span<const T>( currentDisplacements_ ), weight,
+                                    std::span<T>( forceField_ ), *pool_,
+                                    vertexWeights_ );
+        comm_.allReduceSum( solution_ );
+      }
+      else
+        forceCache_( force, currentTime_, rigidMotion_, solution_ );
+    }
+    ++forcesVersion_;
+    bufferSolved_   = true;
+    solvedTime_     = currentTime_;
+    solvedMotion_   = rigidMotion_;
+    solvedSolution_ = solution_;
+  }
+  timeStepControl_.probe( force, currentTime_, rigidMotion_ );
   if( sampleForce ) {
-    auto& samples = samplingForce_ -> samples;
-    samples.push_back( { U[0], U[1], U[2], solution_[0], solution_[1], solution_[2] } );
+    const auto& U = rigidMotion_.translation;
+    samplingForce_ -> add( { U[0], U[1], U[2], solution_[0], solution_[1], solution_[2] },
+                           settings_.convergedSamplesOnly );
   }
+  if( telemetry_ ) publishTelemetry_();
 }
 
@@ -0,0 +1,71 @@
+//------------------------------------------------------------------------------
+// <preamble>
+//
+//  ______
+// |
+// | TailSiT GmbH
+// | Graz, Austria
+//   www.tailsit.com
+//
+// </preamble>
+//------------------------------------------------------------------------------
+
+//! @author    Lars Kielhorn, Thomas Rüberg, Jürgen Zechner
+//! @date      2024
+//! @copyright TailSiT GmbH
+
+// system ----------------------------------------------------------------------
+#include <format>
+#include <optional>
+#include <stdexcept>
+#include <utility>
+
+// own -------------------------------------------------------------------------
+#include "ForceModels.hpp"
+
+//------------------------------------------------------------------------------
+namespace {
+
+  //----------------------------------------------------------------------------
+  /** the settings block of model M */
+  template< typename M >
+  const typename M::Settings& settingsOf( const ts::ForceModelSettings& settings )
+  {
+    return std::get<const typename M::Settings&>(
+      std::tie( settings.sigmoid, settings.polynomial, settings.table ) );
+  }
+
+} // end anonymous namespace
+
+//------------------------------------------------------------------------------
+namespace ts {
+
+  //----------------------------------------------------------------------------
+  ForceModel makeForceModel( const ForceModelSettings& settings )
+  {
+    std::optional<ForceModel> model;
+    [&]<SizeT... I>( std::index_sequence<I...> ) {
+      ( [&]() {
+          using M = std::variant_alternative_t<I,ForceModel>;
+          if( !model && settings.type == M::name )
+            model.emplace( std::in_place_index<I>, settingsOf<M>( settings ) );
+        }(), ... );
+    }( std::make_index_sequence<std::variant_size_v<ForceModel>>{} );
+
+    if( !model ) {
+      const std::string msg = std::format( "ts::makeForceModel:Unknown force model '{}'",
+                                           settings.type );
+      throw std::runtime_error(msg);
+    }
+    return std::move( *model );
+  }
+
+  //----------------------------------------------------------------------------
+  std::vector<std::string_view> forceModelNames( )
+  {
+    return [&]<SizeT... I>( std::index_sequence<I...> ) {
+      return std::vector<std::string_view>{ std::variant_alternative_t<I,ForceModel>::name... };
+    }( std::make_index_sequence<std::variant_size_v<ForceModel>>{} );
+  }
+
+} // end namespace ts
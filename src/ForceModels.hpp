@@ -0,0 +1,51 @@
+//------------------------------------------------------------------------------
+// <preamble>
+//
+//  ______
+// |
+// | TailSiT GmbH
+// | Graz, Austria
+//   www.tailsit.com
+//
+// </preamble>
+//------------------------------------------------------------------------------
+
+//! @author    Lars Kielhorn, Thomas Rüberg, Jürgen Zechner
+//! @date      2024
+//! @copyright TailSiT GmbH
+#pragma once
+
+// system ----------------------------------------------------------------------
+#include <string_view>
+#include <tuple>
+#include <variant>
+#include <vector>
+
+// own -------------------------------------------------------------------------
+#include "Settings.hpp"
+#include "SigmoidForce.hpp"
+#include "PolynomialForce.hpp"
+#include "TabulatedForce.hpp"
+
+//------------------------------------------------------------------------------
+namespace ts {
+
+  //----------------------------------------------------------------------------
+  /** All force models, selected by ForceModelSettings::type.
+   *
+   *  A model is a functor (time, RigidMotion, F) with a static 'name' and a
+   *  constructor from its 'Settings' member of ForceModelSettings. The
+   *  variant is visited once per run, so every model gets its own, fully
+   *  inlined instantiation of the coupling loop; no virtual dispatch.
+   *  New models are registered by appending them here.
+   */
+  using ForceModel = std::variant< SigmoidForce,
+                                   PolynomialForce,
+                                   TabulatedForce >;
+
+  //----------------------------------------------------------------------------
+  ForceModel makeForceModel( const ForceModelSettings& settings );
+
+  std::vector<std::string_view> forceModelNames( );
+
+} // end namespace ts
@@ -0,0 +1,152 @@
+//------------------------------------------------------------------------------
+// <preamble>
+//
+//  ______
+// |
+// | TailSiT GmbH
+// | Graz, Austria
+//   www.tailsit.com
+//
+// </preamble>
+//------------------------------------------------------------------------------
+
+//! @author    Lars Kielhorn, Thomas Rüberg, Jürgen Zechner
+//! @date      2024
+//! @copyright TailSiT GmbH
+
+// system ----------------------------------------------------------------------
+#include <cstdint>
+#include <format>
+#include <fstream>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+// own -------------------------------------------------------------------------
+#include "ForceSampleWriter.hpp"
+
+//------------------------------------------------------------------------------
+namespace {
+
+  constexpr char          magic[8] = { 'T','S','F','O','R','C','E','\0' };
+  constexpr std::uint32_t version  = 1;
+  constexpr char          names[ts::ForceSampleWriter::numCols][8] =
+    { "U0", "U1", "U2", "F0", "F1", "F2" };
+
+  //----------------------------------------------------------------------------
+  template< typename T >
+  void writeRaw( std::ofstream& out, const T* data, ts::SizeT n )
+  {
+    out.write( reinterpret_cast<const char*>(data),
+               static_cast<std::streamsize>( n * sizeof(T) ) );
+  }
+
+} // end anonymous namespace
+
+//------------------------------------------------------------------------------
+namespace ts {
+
+  //----------------------------------------------------------------------------
+  ForceSampleWriter::ForceSampleWriter( const std::filesystem::path& csvFile,
+                                        bool binary )
+    : csvFile_(csvFile)
+    , binary_(binary)
+    , ring_()
+    , error_()
+    , thread_( [this]() { run_(); } )
+  {
+    // empty
+  }
+
+  //----------------------------------------------------------------------------
+  ForceSampleWriter::~ForceSampleWriter( )
+  {
+    ring_.close();
+  }
+
+  //----------------------------------------------------------------------------
+  std::filesystem::path ForceSampleWriter::binaryPath( const std::filesystem::path& csvFile )
+  {
+    auto path = csvFile;
+    return path.replace_extension( ".bin" );
+  }
+
+  //----------------------------------------------------------------------------
+  void ForceSampleWriter::close( )
+  {
+    if( !thread_.joinable() ) return;
+    ring_.close();
+    thread_.join();
+    if( error_ ) std::rethrow_exception( std::exchange( error_, nullptr ) );
+  }
+
+  //----------------------------------------------------------------------------
+  void ForceSampleWriter::run_( )
+  {
+    try {
+      std::ofstream csv, bin;
+      std::vector<Row> rows( blockRows_ );
+      std::vector<Real> column( blockRows_ );
+      std::string text;
+
+      while( ring_.waitForData() ) {
+        const SizeT n = ring_.pop( rows );
+
+        if( !csv.is_open() ) {
+          csv.open( csvFile_ );
+          if( !csv )
+            throw std::runtime_error(
+              std::format( "ts::ForceSampleWriter::run:Cannot write '{}'", csvFile_.string() ) );
+          csv << std::format("#{:>13s},{:>14s},{:>14s},{:>14s},{:>14s},{:>14s}\n",
+                             "U0", "U1", "U2", "F0", "F1", "F2");
+          if( binary_ ) {
+            bin.open( binaryPath( csvFile_ ), std::ios::binary );
+            if( !bin )
+              throw std::runtime_error(
+                std::format( "ts::ForceSampleWriter::run:Cannot write '{}'",
+                             binaryPath( csvFile_ ).string() ) );
+            const std::uint32_t numColumns = numCols;
+            writeRaw( bin, magic, sizeof(magic) );
+            writeRaw( bin, &version, 1 );
+            writeRaw( bin, &numColumns, 1 );
+            writeRaw( bin, &names[0][0], sizeof(names) );
+          }
+        }
+
+        text.clear();
+        for( SizeT i = 0; i < n; ++i ) {
+          const auto& row = rows[i];
+          std::format_to( std::back_inserter( text ),
+                          "{:>14.7e},{:>14.7e},{:>14.7e},{:>14.7e},{:>14.7e},{:>14.7e}\n",
+                          row[0], row[1], row[2], row[3], row[4], row[5] );
+        }
+        csv << text;
+        if( !csv )
+          throw std::runtime_error(
+            std::format( "ts::ForceSampleWriter::run:Cannot write '{}'", csvFile_.string() ) );
+
+        if( bin.is_open() ) {
+          const std::uint64_t numRows = n;
+          writeRaw( bin, &numRows, 1 );
+          for( SizeT c = 0; c < numCols; ++c ) {
+            for( SizeT i = 0; i < n; ++i ) column[i] = rows[i][c];
+            writeRaw( bin, column.data(), n );
+          }
+          if( !bin )
+            throw std::runtime_error(
+              std::format( "ts::ForceSampleWriter::run:Cannot write '{}'",
+                           binaryPath( csvFile_ ).string() ) );
+        }
+      }
+    }
+    catch( ... ) {
+      error_ = std::current_exception();
+      // keep draining so the producer never blocks on a dead writer
+      std::vector<Row> rows( blockRows_ );
+      while( ring_.waitForData() ) ring_.pop( rows );
+    }
+  }
+
+} // end namespace ts
@@ -0,0 +1,82 @@
+//------------------------------------------------------------------------------
+// <preamble>
+//
+//  ______
+// |
+// | TailSiT GmbH
+// | Graz, Austria
+//   www.tailsit.com
+//
+// </preamble>
+//------------------------------------------------------------------------------
+
+//! @author    Lars Kielhorn, Thomas Rüberg, Jürgen Zechner
+//! @date      2024
+//! @copyright TailSiT GmbH
+#pragma once
+
+// system ----------------------------------------------------------------------
+#include <array>
+#include <exception>
+#include <filesystem>
+#include <thread>
+
+// own -------------------------------------------------------------------------
+#include "types.hpp"
+#include "SpscRing.hpp"
+
+//------------------------------------------------------------------------------
+namespace ts {
+
+  class ForceSampleWriter;
+
+}
+
+//------------------------------------------------------------------------------
+/** Streams force samples (U0,U1,U2,F0,F1,F2) to disk on a background thread.
+ *
+ *  Rows are handed over through a bounded lock-free ring, so the producer
+ *  never allocates and memory does not grow with the run length. Output
+ *  files are created with the first row:
+ *   - the CSV file in the layout ForceGenerator has always written,
+ *   - optionally a binary columnar file next to it (extension '.bin'):
+ *     header { char magic[8] = "TSFORCE", uint32 version, uint32 numCols,
+ *     char names[numCols][8] }, then blocks { uint64 numRows,
+ *     numCols x numRows doubles }, in native byte order.
+ */
+class ts::ForceSampleWriter
+{
+public:
+  static constexpr SizeT numCols = 6;
+  using Row = std::array<Real,numCols>;
+
+private:
+  static constexpr SizeT ringCapacity_ = 4096;
+  static constexpr SizeT blockRows_    = 1024;
+
+  std::filesystem::path       csvFile_;
+  bool                        binary_;
+  SpscRing<Row,ringCapacity_> ring_;
+  std::exception_ptr          error_;
+  std::jthread                thread_;
+
+public:
+  ForceSampleWriter( const std::filesystem::path& csvFile, bool binary );
+
+  ForceSampleWriter( const ForceSampleWriter& ) = delete;
+  ForceSampleWriter& operator=( const ForceSampleWriter& ) = delete;
+
+  ~ForceSampleWriter( );
+
+  static std::filesystem::path binaryPath( const std::filesystem::path& csvFile );
+
+  //! blocks only if the writer is ringCapacity_ rows behind
+  void push( const Row& row ) { ring_.push( row ); }
+
+  //! drains the ring, joins the writer and rethrows its error, if any
+  void close( );
+
+private:
+  void run_( );
+
+}; // end class ForceSampleWriter
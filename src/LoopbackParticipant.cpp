@@ -0,0 +1,185 @@
+//------------------------------------------------------------------------------
+// <preamble>
+//
+//  ______
+// |
+// | TailSiT GmbH
+// | Graz, Austria
+//   www.tailsit.com
+//
+// </preamble>
+//------------------------------------------------------------------------------
+
+//! @author    Lars Kielhorn, Thomas Rüberg, Jürgen Zechner
+//! @date      2024
+//! @copyright TailSiT GmbH
+
+// system ----------------------------------------------------------------------
+#include <algorithm>
+#include <cmath>
+#include <format>
+#include <fstream>
+#include <numeric>
+#include <stdexcept>
+#include <utility>
+
+// own -------------------------------------------------------------------------
+#include "LoopbackParticipant.hpp"
+
+//------------------------------------------------------------------------------
+namespace {
+
+  using Vector = ts::LoopbackParticipant::Vector;
+
+  ts::Real dot( const Vector& x, const Vector& y )
+  {
+    return x[0]*y[0] + x[1]*y[1] + x[2]*y[2];
+  }
+
+} // end anonymous namespace
+
+//------------------------------------------------------------------------------
+namespace ts {
+
+  //----------------------------------------------------------------------------
+  LoopbackParticipant::LoopbackParticipant( const RigidBodySettings& settings,
+                                            Real  dt,
+                                            SizeT numWindows )
+    : settings_(settings)
+    , body_( settings.integrator )
+    , windowStart_(body_)
+    , dt_(dt)
+    , windowTime_(0)
+    , numSteps_(0)
+    , numWindows_(numWindows)
+    , window_(0)
+    , iteration_(0)
+    , readCheckpoint_(false)
+    , displacement_()
+    , force_()
+    , residual_()
+    , omega_( settings.relaxation )
+    , history_()
+  {
+    history_.reserve( numWindows + 1 );
+    history_.push_back( { body_.state(), force_, 0 } );
+  }
+
+  //----------------------------------------------------------------------------
+  SizeT LoopbackParticipant::numIterations( ) const
+  {
+    return std::accumulate( history_.begin(), history_.end(), SizeT{0},
+                            []( SizeT n, const Sample& s ) { return n + s.numIterations; } );
+  }
+
+  //----------------------------------------------------------------------------
+  void LoopbackParticipant::readData( std::string_view      /*meshName*/,
+                                      std::string_view      dataName,
+                                      std::span<const Int>  vertexIds,
+                                      Real                  relativeReadTime,
+                                      std::span<Real>       values ) const
+  {
+    // linear in the window, from its start to the iterate at its end
+    const auto& start = windowStart_.state().U;
+    const auto at = [&]( Real time ) {
+      Vector U;
+      for( SizeT a = 0; a < 3; ++a )
+        U[a] = start[a] + time/dt_ * (displacement_[a] - start[a]);
+      return U;
+    };
+    Vector U = at( windowTime_ + relativeReadTime );
+    if( dataName == "DisplacementDeltas" ) {
+      const Vector Uold = at( windowTime_ );
+      for( SizeT a = 0; a < 3; ++a ) U[a] -= Uold[a];
+    }
+    for( SizeT i = 0; i < vertexIds.size(); ++i )
+      std::ranges::copy( U, values.begin() + 3*i );
+  }
+
+  //----------------------------------------------------------------------------
+  void LoopbackParticipant::writeData( std::string_view      /*meshName*/,
+                                       std::string_view      /*dataName*/,
+                                       std::span<const Int>  vertexIds,
+                                       std::span<const Real> values )
+  {
+    for( SizeT i = 0; i < vertexIds.size(); ++i )
+      for( SizeT a = 0; a < 3; ++a ) force_[a] += values[3*i + a];
+  }
+
+  //----------------------------------------------------------------------------
+  void LoopbackParticipant::advance( Real dt )
+  {
+    const Real m = settings_.mass;
+    const auto& g = settings_.gravity;
+    const Vector F = std::exchange( force_, Vector{} );
+    body_.commit( body_.advance( dt, [&]( Real, const Vector&, const Vector& ) {
+      return Vector{ g[0] + F[0]/m, g[1] + F[1]/m, g[2] + F[2]/m };
+    } ) );
+    ++numSteps_;
+    readCheckpoint_ = false;
+
+    // subcycling, the window goes on
+    windowTime_ += dt;
+    if( windowTime_ < dt_ * (1 - 1e-12) ) return;
+    windowTime_ = 0;
+    ++iteration_;
+
+    if( settings_.scheme == RigidBodySettings::Scheme::serialExplicit ) {
+      accept_( F );
+      return;
+    }
+
+    const auto& U = body_.state().U;
+    Vector r;
+    for( SizeT a = 0; a < 3; ++a ) r[a] = U[a] - displacement_[a];
+    const Real norm = std::sqrt( dot( U, U ) );
+    if( std::sqrt( dot( r, r ) ) <= settings_.tolerance * norm ||
+        iteration_ >= settings_.maxIterations ) {
+      accept_( F );
+      return;
+    }
+
+    // Aitken: omega_k = -omega_k-1 (r_k-1 . (r_k - r_k-1)) / |r_k - r_k-1|^2
+    if( iteration_ == 1 )
+      omega_ = settings_.relaxation;
+    else {
+      Vector dr;
+      for( SizeT a = 0; a < 3; ++a ) dr[a] = r[a] - residual_[a];
+      const Real dr2 = dot( dr, dr );
+      if( dr2 > 0 ) omega_ = -omega_ * dot( residual_, dr ) / dr2;
+    }
+    residual_ = r;
+    for( SizeT a = 0; a < 3; ++a ) displacement_[a] += omega_ * r[a];
+    body_ = windowStart_;
+    readCheckpoint_ = true;
+  }
+
+  //----------------------------------------------------------------------------
+  void LoopbackParticipant::accept_( const Vector& force )
+  {
+    windowStart_ = body_;
+    history_.push_back( { body_.state(), force, iteration_ } );
+    displacement_   = body_.state().U;
+    iteration_      = 0;
+    readCheckpoint_ = false;
+    ++window_;
+  }
+
+  //----------------------------------------------------------------------------
+  void LoopbackParticipant::writeHistory( const std::filesystem::path& file ) const
+  {
+    std::ofstream out( file );
+    if( !out ) {
+      const std::string msg = std::format( "ts::LoopbackParticipant::writeHistory:Cannot write '{}'",
+                                           file.string() );
+      throw std::runtime_error(msg);
+    }
+    out << "# t, U0, U1, U2, V0, V1, V2, F0, F1, F2, iterations\n";
+    for( const auto& [state,F,numIterations] : history_ )
+      out << std::format( "{:.8e},{:.8e},{:.8e},{:.8e},{:.8e},{:.8e},{:.8e},{:.8e},{:.8e},{:.8e},{}\n",
+                          state.t, state.U[0], state.U[1], state.U[2],
+                          state.V[0], state.V[1], state.V[2], F[0], F[1], F[2],
+                          numIterations );
+  }
+
+} // end namespace ts
@@ -0,0 +1,131 @@
+//------------------------------------------------------------------------------
+// <preamble>
+//
+//  ______
+// |
+// | TailSiT GmbH
+// | Graz, Austria
+//   www.tailsit.com
+//
+// </preamble>
+//------------------------------------------------------------------------------
+
+//! @author    Lars Kielhorn, Thomas Rüberg, Jürgen Zechner
+//! @date      2024
+//! @copyright TailSiT GmbH
+#pragma once
+
+// system ----------------------------------------------------------------------
+#include <array>
+#include <filesystem>
+#include <span>
+#include <string_view>
+#include <vector>
+
+// own -------------------------------------------------------------------------
+#include "types.hpp"
+#include "Settings.hpp"
+#include "RigidBody.hpp"
+
+//------------------------------------------------------------------------------
+namespace ts {
+
+  class LoopbackParticipant;
+
+}
+
+//------------------------------------------------------------------------------
+/** The rigid body solver of example/lenz_*.xml as an in-process participant.
+ *
+ *  Offers the precice::Participant calls of the coupling loop and answers
+ *  them with a RigidBody driven by the total force written in an iteration
+ *  (the sum over all vertices of all meshes, as a conservative mapping
+ *  would deliver it):
+ *   - serialExplicit: the adapter goes first; every window reads the
+ *     displacement of the previous window end, advance() integrates the
+ *     body with the forces just written.
+ *   - parallelImplicit: every window iterates with checkpoints until the
+ *     displacement integrated from the written forces changes the one read
+ *     by at most tolerance (relative), or maxIterations is reached. The
+ *     displacement iterates are Aitken-relaxed, starting with relaxation.
+ *  Steps shorter than the window subcycle it, as with preCICE: the body
+ *  takes the same steps, each with the forces written in it, and reads
+ *  within the window interpolate linearly between the displacement at the
+ *  window start and the iterate at its end. Convergence is checked, and
+ *  checkpoints are asked for, at window ends only.
+ *  No sockets, no exchange directory.
+ */
+class ts::LoopbackParticipant
+{
+public:
+  using Vector = RigidBody::Vector;
+
+  struct Sample
+  {
+    RigidBody::State state;
+    Vector           force;
+    SizeT            numIterations;
+  };
+
+private:
+  RigidBodySettings   settings_;
+  RigidBody           body_;
+  RigidBody           windowStart_;  //!< body_ at the start of the window
+  Real                dt_;
+  Real                windowTime_;   //!< elapsed in the window
+  SizeT               numSteps_;
+  SizeT               numWindows_;
+  SizeT               window_;
+  SizeT               iteration_;
+  bool                readCheckpoint_;
+  Vector              displacement_; //!< iterate handed to the adapter
+  Vector              force_;        //!< total force written this iteration
+  Vector              residual_;     //!< of the previous iteration, for Aitken
+  Real                omega_;
+  std::vector<Sample> history_;      //!< accepted windows
+
+public:
+  LoopbackParticipant( const RigidBodySettings& settings, Real dt, SizeT numWindows );
+
+  const std::vector<Sample>& history( ) const { return history_; }
+
+  SizeT numIterations( ) const;
+
+  //! advance() calls, all iterations and subcycles
+  SizeT numSteps( ) const { return numSteps_; }
+
+  //! t,U0,U1,U2,V0,V1,V2,F0,F1,F2,iterations per accepted window
+  void writeHistory( const std::filesystem::path& file ) const;
+
+  /** @name the precice::Participant calls of the coupling loop */
+  //@{
+  bool isCouplingOngoing( ) const { return window_ < numWindows_; }
+
+  bool requiresWritingCheckpoint( ) const
+  {
+    return settings_.scheme == RigidBodySettings::Scheme::parallelImplicit &&
+           iteration_ == 0 && windowTime_ == 0;
+  }
+
+  bool requiresReadingCheckpoint( ) const { return readCheckpoint_; }
+
+  Real getMaxTimeStepSize( ) const { return dt_ - windowTime_; }
+
+  void readData( std::string_view      meshName,
+                 std::string_view      dataName,
+                 std::span<const Int>  vertexIds,
+                 Real                  relativeReadTime,
+                 std::span<Real>       values ) const;
+
+  void writeData( std::string_view      meshName,
+                  std::string_view      dataName,
+                  std::span<const Int>  vertexIds,
+                  std::span<const Real> values );
+
+  void advance( Real dt );
+  //@}
+
+private:
+  void accept_( const Vector& force );
+
+}; // end class LoopbackParticipant
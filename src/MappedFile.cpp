@@ -0,0 +1,116 @@
+//------------------------------------------------------------------------------
+// <preamble>
+//
+//  ______
+// |
+// | TailSiT GmbH
+// | Graz, Austria
+//   www.tailsit.com
+//
+// </preamble>
+//------------------------------------------------------------------------------
+
+//! @author    Lars Kielhorn, Thomas Rüberg, Jürgen Zechner
+//! @date      2024
+//! @copyright TailSiT GmbH
+
+// system ----------------------------------------------------------------------
+#include <stdexcept>
+#include <format>
+#include <cerrno>
+#include <cstring>
+#include <utility>
+
+// posix -----------------------------------------------------------------------
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+// own -------------------------------------------------------------------------
+#include "MappedFile.hpp"
+
+//------------------------------------------------------------------------------
+namespace ts {
+
+  //----------------------------------------------------------------------------
+  MappedFile::MappedFile( ) noexcept
+    : data_(nullptr)
+    , size_(0)
+  {
+    // empty
+  }
+
+  //----------------------------------------------------------------------------
+  MappedFile::MappedFile( const std::filesystem::path& file )
+    : MappedFile()
+  {
+    const int fd = ::open( file.c_str(), O_RDONLY );
+    if( fd < 0 ) {
+      const std::string msg = std::format( "ts::MappedFile::MappedFile:File '{}' not found",
+                                           file.string() );
+      throw std::runtime_error(msg);
+    }
+
+    struct stat st;
+    if( ::fstat( fd, &st ) != 0 ) {
+      ::close( fd );
+      const std::string msg = std::format( "ts::MappedFile::MappedFile:Cannot stat '{}': {}",
+                                           file.string(), std::strerror(errno) );
+      throw std::runtime_error(msg);
+    }
+
+    const SizeT size = static_cast<SizeT>( st.st_size );
+    if( size > 0 ) {
+      void* ptr = ::mmap( nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0 );
+      if( ptr == MAP_FAILED ) {
+        ::close( fd );
+        const std::string msg = std::format( "ts::MappedFile::MappedFile:Cannot map '{}': {}",
+                                             file.string(), std::strerror(errno) );
+        throw std::runtime_error(msg);
+      }
+      // we read front to back, tell the kernel so
+      ::madvise( ptr, size, MADV_SEQUENTIAL );
+      data_ = static_cast<const char*>(ptr);
+      size_ = size;
+    }
+
+    // the mapping stays valid after closing the descriptor
+    ::close( fd );
+  }
+
+  //----------------------------------------------------------------------------
+  MappedFile::MappedFile( MappedFile&& other ) noexcept
+    : data_( std::exchange( other.data_, nullptr ) )
+    , size_( std::exchange( other.size_, 0 ) )
+  {
+    // empty
+  }
+
+  //----------------------------------------------------------------------------
+  MappedFile& MappedFile::operator=( MappedFile&& other ) noexcept
+  {
+    if( this != &other ) {
+      release_();
+      data_ = std::exchange( other.data_, nullptr );
+      size_ = std::exchange( other.size_, 0 );
+    }
+    return *this;
+  }
+
+  //----------------------------------------------------------------------------
+  MappedFile::~MappedFile( )
+  {
+    release_();
+  }
+
+  //----------------------------------------------------------------------------
+  void MappedFile::release_( ) noexcept
+  {
+    if( data_ )
+      ::munmap( const_cast<char*>(data_), size_ );
+    data_ = nullptr;
+    size_ = 0;
+  }
+
+} // end namespace ts
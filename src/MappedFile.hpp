@@ -0,0 +1,71 @@
+//------------------------------------------------------------------------------
+// <preamble>
+//
+//  ______
+// |
+// | TailSiT GmbH
+// | Graz, Austria
+//   www.tailsit.com
+//
+// </preamble>
+//------------------------------------------------------------------------------
+
+//! @author    Lars Kielhorn, Thomas Rüberg, Jürgen Zechner
+//! @date      2024
+//! @copyright TailSiT GmbH
+#pragma once
+
+// system ----------------------------------------------------------------------
+#include <filesystem>
+#include <string_view>
+#include <span>
+
+// own -------------------------------------------------------------------------
+#include "types.hpp"
+
+//------------------------------------------------------------------------------
+namespace ts {
+
+  class MappedFile;
+
+}
+
+//------------------------------------------------------------------------------
+/** Read-only memory mapping of a whole file (POSIX mmap).
+ *
+ *  Move-only; the mapping is released on destruction. An empty file yields
+ *  an empty view without an actual mapping.
+ */
+class ts::MappedFile
+{
+private:
+  const char* data_;
+  SizeT       size_;
+
+public:
+  MappedFile( ) noexcept;
+
+  explicit MappedFile( const std::filesystem::path& file );
+
+  MappedFile( const MappedFile& ) = delete;
+  MappedFile& operator=( const MappedFile& ) = delete;
+
+  MappedFile( MappedFile&& other ) noexcept;
+  MappedFile& operator=( MappedFile&& other ) noexcept;
+
+  ~MappedFile( );
+
+  SizeT size( ) const noexcept { return size_; }
+  bool  empty( ) const noexcept { return size_ == 0; }
+
+  std::string_view view( ) const noexcept { return { data_, size_ }; }
+
+  std::span<const std::byte> bytes( ) const noexcept
+  {
+    return { reinterpret_cast<const std::byte*>(data_), size_ };
+  }
+
+private:
+  void release_( ) noexcept;
+
+}; // end class MappedFile
@@ -0,0 +1,658 @@
+//------------------------------------------------------------------------------
+// <preamble>
+//
+//  ______
+// |
+// | TailSiT GmbH
+// | Graz, Austria
+//   www.tailsit.com
+//
+// </preamble>
+//------------------------------------------------------------------------------
+
+//! @author    Lars Kielhorn, Thomas Rüberg, Jürgen Zechner
+//! @date      2024
+//! @copyright TailSiT GmbH
+
+// system ----------------------------------------------------------------------
+#include <algorithm>
+#include <array>
+#include <cctype>
+#include <charconv>
+#include <cstring>
+#include <format>
+#include <map>
+#include <set>
+#include <span>
+#include <stdexcept>
+#include <tuple>
+#include <utility>
+
+// own -------------------------------------------------------------------------
+#include "MeshReaders.hpp"
+#include "MappedFile.hpp"
+#include "Parallel.hpp"
+
+//------------------------------------------------------------------------------
+namespace {
+
+  using ts::Real;
+  using ts::SizeT;
+
+  static constexpr SizeT dim  = 3;
+  static constexpr SizeT none = static_cast<SizeT>(-1);
+
+  // don't bother spawning threads for less than this
+  static constexpr SizeT minChunkBytes = SizeT{1} << 20;
+
+  //! where errors come from: the throwing method and the file
+  struct Context
+  {
+    std::string_view where;
+    std::string_view source;
+
+    [[noreturn]] void fail( std::string_view what ) const
+    {
+      throw std::runtime_error( std::format( "{}:'{}': {}", where, source, what ) );
+    }
+  };
+
+  //----------------------------------------------------------------------------
+  //! pos moved forward to the next line start
+  SizeT lineStart( std::string_view content, SizeT pos )
+  {
+    if( pos == 0 ) return 0;
+    const auto nl = content.find( '\n', pos - 1 );
+    return (nl == std::string_view::npos) ? content.size() : nl + 1;
+  }
+
+  //! the line at pos without its '\n', pos moved to the next one
+  std::string_view nextLine( std::string_view content, SizeT& pos )
+  {
+    const void* nl  = std::memchr( content.data() + pos, '\n', content.size() - pos );
+    const SizeT eol = nl ? static_cast<const char*>(nl) - content.data() : content.size();
+    const auto line = content.substr( pos, eol - pos );
+    pos = std::min( eol + 1, content.size() );
+    return line;
+  }
+
+  //----------------------------------------------------------------------------
+  /** f(line, out) for every line of content, in line aligned chunks that run
+   *  concurrently; the outputs of the chunks are concatenated in order */
+  template< typename T, typename F >
+  std::vector<T> mapLines( std::string_view content, SizeT numThreads, F&& f )
+  {
+    const SizeT size = content.size();
+    const SizeT numChunks =
+      std::min( ts::parallel::numThreads( numThreads ), size / minChunkBytes + 1 );
+
+    std::vector<SizeT> bounds( numChunks + 1, size );
+    bounds[0] = 0;
+    for( SizeT c = 1; c < numChunks; ++c )
+      bounds[c] = lineStart( content, std::max( c * (size / numChunks), bounds[c-1] ) );
+
+    std::vector<std::vector<T>> outputs( numChunks );
+    ts::parallel::forEachChunk( numChunks, numChunks,
+                                [&]( SizeT, SizeT cBegin, SizeT cEnd ) {
+                                  for( SizeT c = cBegin; c < cEnd; ++c ) {
+                                    const auto chunk = content.substr( bounds[c], bounds[c+1] - bounds[c] );
+                                    for( SizeT pos = 0; pos < chunk.size(); )
+                                      f( nextLine( chunk, pos ), outputs[c] );
+                                  }
+                                } );
+
+    if( numChunks == 1 ) return std::move( outputs.front() );
+    SizeT numValues = 0;
+    for( const auto& output : outputs ) numValues += output.size();
+    std::vector<T> result;
+    result.reserve( numValues );
+    for( const auto& output : outputs )
+      result.insert( result.end(), output.begin(), output.end() );
+    return result;
+  }
+
+  //! position after n lines from pos, npos if there are fewer; the line
+  //! ends are counted in chunks concurrently
+  SizeT skipLines( std::string_view content, SizeT pos, SizeT n, SizeT numThreads )
+  {
+    content = content.substr( pos );
+    const SizeT size = content.size();
+    const SizeT numChunks =
+      std::min( ts::parallel::numThreads( numThreads ), size / minChunkBytes + 1 );
+    std::vector<SizeT> counts( numChunks );
+    ts::parallel::forEachChunk( size, numChunks, [&]( SizeT c, SizeT begin, SizeT end ) {
+      counts[c] = std::count( content.data() + begin, content.data() + end, '\n' );
+    } );
+
+    for( SizeT c = 0; c < numChunks; ++c ) {
+      if( counts[c] < n ) { n -= counts[c]; continue; }
+      SizeT at = ts::parallel::blockRange( size, numChunks, c ).first;
+      for( ; n > 0; --n ) nextLine( content, at );
+      return pos + at;
+    }
+    // the last line may lack its '\n'
+    if( n == 1 && size > 0 && content.back() != '\n' ) return pos + size;
+    return std::string_view::npos;
+  }
+
+  //----------------------------------------------------------------------------
+  bool isSeparator( char c ) { return c == ' ' || c == ',' || c == '\t' || c == '\r'; }
+
+  //! the tokens of a line separated by blanks or commas
+  struct Tokens
+  {
+    const char* pos;
+    const char* end;
+
+    explicit Tokens( std::string_view line )
+      : pos( line.data() )
+      , end( line.data() + line.size() )
+    {
+      // empty
+    }
+
+    bool empty( )
+    {
+      while( pos != end && isSeparator( *pos ) ) ++pos;
+      return pos == end;
+    }
+
+    std::string_view next( )
+    {
+      empty();
+      const char* begin = pos;
+      while( pos != end && !isSeparator( *pos ) ) ++pos;
+      return { begin, pos };
+    }
+  };
+
+  template< typename T >
+  bool toNumber( std::string_view token, T& value )
+  {
+    if( !token.empty() && token.front() == '+' ) token.remove_prefix( 1 );
+    const auto [ptr,ec] = std::from_chars( token.data(), token.data() + token.size(), value );
+    return ec == std::errc() && ptr == token.data() + token.size() && !token.empty();
+  }
+
+  template< typename T >
+  T number( std::string_view token, std::string_view line, const Context& context )
+  {
+    T value;
+    if( !toNumber( token, value ) )
+      context.fail( std::format( "cannot convert '{}' in '{}'", token, line ) );
+    return value;
+  }
+
+  //----------------------------------------------------------------------------
+  struct Node
+  {
+    SizeT                id;
+    std::array<Real,dim> x;
+  };
+
+  std::string_view trim( std::string_view text )
+  {
+    const auto first = text.find_first_not_of( " \t\r" );
+    if( first == std::string_view::npos ) return {};
+    const auto last = text.find_last_not_of( " \t\r" );
+    return text.substr( first, last - first + 1 );
+  }
+
+  //! blank lines and CalculiX '**' comments
+  bool isDataLine( std::string_view line )
+  {
+    return !line.starts_with( "**" ) && !trim( line ).empty();
+  }
+
+  //! the rows 'id x y z' of block, other lines skipped
+  std::vector<Node> parseNodes( std::string_view block, SizeT numThreads, const Context& context )
+  {
+    return mapLines<Node>( block, numThreads, [&]( std::string_view line, std::vector<Node>& nodes ) {
+      if( !isDataLine( line ) ) return;
+      Tokens tokens( line );
+      Node& node = nodes.emplace_back();
+      node.id = number<SizeT>( tokens.next(), line, context );
+      for( auto& x : node.x ) {
+        if( tokens.empty() ) context.fail( std::format( "missing coordinate in '{}'", line ) );
+        x = number<Real>( tokens.next(), line, context );
+      }
+      if( !tokens.empty() ) context.fail( std::format( "more than {} coordinates in '{}'", dim, line ) );
+    } );
+  }
+
+  //! coordinates of all nodes
+  std::vector<Real> coordinates( std::span<const Node> nodes )
+  {
+    std::vector<Real> coords;
+    coords.reserve( nodes.size() * dim );
+    for( const auto& node : nodes )
+      coords.insert( coords.end(), node.x.begin(), node.x.end() );
+    return coords;
+  }
+
+  //! coordinates of the nodes listed in selected, in the order of nodes
+  std::vector<Real> coordinates( std::span<const Node>  nodes,
+                                 std::span<const SizeT> selected,
+                                 const Context&         context )
+  {
+    SizeT maxId = 0;
+    for( const auto& node : nodes ) maxId = std::max( maxId, node.id );
+
+    // 1 defined, 2 defined and selected
+    std::vector<unsigned char> state( maxId + 1, 0 );
+    for( const auto& node : nodes ) state[node.id] = 1;
+    for( const SizeT id : selected ) {
+      if( id > maxId || state[id] == 0 )
+        context.fail( std::format( "node {} of the region is not defined", id ) );
+      state[id] = 2;
+    }
+
+    std::vector<Real> coords;
+    coords.reserve( selected.size() * dim );
+    for( const auto& node : nodes )
+      if( state[node.id] == 2 ) {
+        coords.insert( coords.end(), node.x.begin(), node.x.end() );
+        state[node.id] = 1;
+      }
+    return coords;
+  }
+
+  //----------------------------------------------------------------------------
+  /** Element records are stored flat: shape, number of nodes, node ids.
+   *  The faces of solids are given by their local corner numbers. */
+  enum class Shape : SizeT { nodes, hexahedron, tetrahedron, wedge };
+
+  using Face = std::array<SizeT,4>;
+
+  static constexpr std::array<Face,6> hexahedronFaces = {{
+    { 0, 1, 2, 3 }, { 4, 7, 6, 5 }, { 0, 4, 5, 1 },
+    { 1, 5, 6, 2 }, { 2, 6, 7, 3 }, { 3, 7, 4, 0 } }};
+  static constexpr std::array<Face,4> tetrahedronFaces = {{
+    { 0, 1, 2, none }, { 0, 3, 1, none }, { 1, 3, 2, none }, { 2, 3, 0, none } }};
+  static constexpr std::array<Face,5> wedgeFaces = {{
+    { 0, 1, 2, none }, { 3, 4, 5, none },
+    { 0, 1, 4, 3 }, { 1, 2, 5, 4 }, { 2, 0, 3, 5 } }};
+
+  //! the local faces of a shape and its number of corners
+  std::pair<std::span<const Face>,SizeT> facesOf( Shape shape )
+  {
+    switch( shape ) {
+    case Shape::hexahedron:  return { hexahedronFaces,  8 };
+    case Shape::tetrahedron: return { tetrahedronFaces, 4 };
+    case Shape::wedge:       return { wedgeFaces,       6 };
+    default:                 return { {}, 0 };
+    }
+  }
+
+  //! offsets of all records
+  std::vector<SizeT> recordOffsets( std::span<const SizeT> records )
+  {
+    std::vector<SizeT> offsets;
+    for( SizeT r = 0; r < records.size(); r += 2 + records[r+1] )
+      offsets.push_back( r );
+    return offsets;
+  }
+
+  /** Nodes of the surface of the elements at offsets in records, unsorted
+   *  and repeated. A face shared by two solids is interior; the faces are
+   *  bucketed by their smallest node in two passes, counting and placing,
+   *  which is cheaper than sorting them all. */
+  std::vector<SizeT> surfaceNodes( std::span<const SizeT> records,
+                                   std::span<const SizeT> offsets )
+  {
+    std::vector<SizeT> nodes;
+    std::vector<SizeT> buckets;
+    std::vector<std::array<SizeT,3>> faces;
+
+    // the nodes of other elements are taken in the counting pass
+    auto forEachFace = [&]( bool counting, auto&& f ) {
+      for( const SizeT r : offsets ) {
+        const auto   shape    = static_cast<Shape>( records[r] );
+        const SizeT  numNodes = records[r+1];
+        const SizeT* element  = records.data() + r + 2;
+        const auto [localFaces,numCorners] = facesOf( shape );
+        if( localFaces.empty() || numNodes < numCorners ) {
+          if( counting ) nodes.insert( nodes.end(), element, element + numNodes );
+          continue;
+        }
+        for( const Face& local : localFaces ) {
+          Face face;
+          for( SizeT i = 0; i < face.size(); ++i )
+            face[i] = local[i] == none ? none : element[local[i]];
+          std::ranges::sort( face );
+          f( face );
+        }
+      }
+    };
+
+    SizeT maxId = 0;
+    for( const SizeT r : offsets )
+      for( SizeT i = 0; i < records[r+1]; ++i )
+        maxId = std::max( maxId, records[r+2+i] );
+
+    buckets.assign( maxId + 2, 0 );
+    SizeT numFaces = 0;
+    forEachFace( true, [&]( const Face& face ) { ++buckets[face[0]+1]; ++numFaces; } );
+    if( numFaces == 0 ) return nodes;
+    for( SizeT id = 0; id <= maxId; ++id ) buckets[id+1] += buckets[id];
+    faces.resize( numFaces );
+    forEachFace( false, [&]( const Face& face ) {
+      faces[buckets[face[0]]++] = { face[1], face[2], face[3] };
+    } );
+
+    for( SizeT begin = 0, id = 0; id <= maxId; ++id ) {
+      const auto bucket = std::span( faces ).subspan( begin, buckets[id] - begin );
+      begin = buckets[id];
+      std::ranges::sort( bucket );
+      for( SizeT a = 0; a < bucket.size(); ) {
+        SizeT b = a + 1;
+        while( b < bucket.size() && bucket[b] == bucket[a] ) ++b;
+        if( b == a + 1 ) {
+          nodes.push_back( id );
+          for( const SizeT node : bucket[a] )
+            if( node != none ) nodes.push_back( node );
+        }
+        a = b;
+      }
+    }
+    return nodes;
+  }
+
+  //----------------------------------------------------------------------------
+  std::string upper( std::string_view text )
+  {
+    std::string result( text );
+    for( char& c : result ) c = static_cast<char>( std::toupper( static_cast<unsigned char>(c) ) );
+    return result;
+  }
+
+  //! a CalculiX keyword line: its upper case name and options
+  struct Keyword
+  {
+    std::string                       name;
+    std::map<std::string,std::string> options; //!< upper case keys
+
+    explicit Keyword( std::string_view line )
+    {
+      line.remove_prefix( 1 );
+      SizeT pos = line.find( ',' );
+      name = upper( trim( line.substr( 0, pos ) ) );
+      while( pos != std::string_view::npos ) {
+        const SizeT next = line.find( ',', pos + 1 );
+        const auto option = line.substr( pos + 1, next == std::string_view::npos ? next : next - pos - 1 );
+        const SizeT eq = option.find( '=' );
+        if( !trim( option ).empty() )
+          options[upper( trim( option.substr( 0, eq ) ) )] =
+            eq == std::string_view::npos ? std::string() : std::string( trim( option.substr( eq + 1 ) ) );
+        pos = next;
+      }
+    }
+
+    std::string option( const std::string& key ) const
+    {
+      const auto it = options.find( key );
+      return it == options.end() ? std::string() : it -> second;
+    }
+  };
+
+  //! shape and number of nodes of a CalculiX element type
+  std::pair<Shape,SizeT> elementType( const std::string& type, const Context& context )
+  {
+    static const std::array<std::tuple<std::string_view,Shape,SizeT>,27> types = {{
+      { "C3D20", Shape::hexahedron, 20 }, { "C3D8",  Shape::hexahedron,  8 },
+      { "C3D10", Shape::tetrahedron, 10 }, { "C3D4", Shape::tetrahedron,  4 },
+      { "C3D15", Shape::wedge, 15 },       { "C3D6",  Shape::wedge,        6 },
+      { "CPS8", Shape::nodes, 8 }, { "CPS6", Shape::nodes, 6 }, { "CPS4", Shape::nodes, 4 },
+      { "CPS3", Shape::nodes, 3 }, { "CPE8", Shape::nodes, 8 }, { "CPE6", Shape::nodes, 6 },
+      { "CPE4", Shape::nodes, 4 }, { "CPE3", Shape::nodes, 3 }, { "CAX8", Shape::nodes, 8 },
+      { "CAX6", Shape::nodes, 6 }, { "CAX4", Shape::nodes, 4 }, { "CAX3", Shape::nodes, 3 },
+      { "M3D8", Shape::nodes, 8 }, { "M3D4", Shape::nodes, 4 },
+      { "S8",   Shape::nodes, 8 }, { "S6",   Shape::nodes, 6 }, { "S4",   Shape::nodes, 4 },
+      { "S3",   Shape::nodes, 3 }, { "B32",  Shape::nodes, 3 }, { "B31",  Shape::nodes, 2 },
+      { "T3D2", Shape::nodes, 2 } }};
+    for( const auto& [prefix,shape,numNodes] : types )
+      if( type.starts_with( prefix ) ) return { shape, numNodes };
+    context.fail( std::format( "element type '{}' not supported", type ) );
+  }
+
+  //----------------------------------------------------------------------------
+  //! a *NSET or *ELSET: ids and the names of member sets
+  struct Set
+  {
+    std::vector<SizeT>       ids;
+    std::vector<std::string> members;
+  };
+
+  //! what a deck and its includes define
+  struct Deck
+  {
+    bool                                withElements = false;
+    std::vector<Node>                   nodes;
+    std::vector<SizeT>                  records;  //!< of all elements, if withElements
+    std::vector<std::pair<SizeT,SizeT>> elements; //!< id and record offset
+    std::map<std::string,Set>           nsets;
+    std::map<std::string,Set>           elsets;
+    std::vector<ts::MappedFile>         includes;
+  };
+
+  //! ids of a set and its members, recursively
+  void collect( const std::map<std::string,Set>& sets,
+                const std::string&               name,
+                std::set<std::string>&           visited,
+                std::vector<SizeT>&              ids,
+                const Context&                   context )
+  {
+    if( !visited.insert( name ).second ) return;
+    const auto it = sets.find( name );
+    if( it == sets.end() ) context.fail( std::format( "set '{}' is not defined", name ) );
+    ids.insert( ids.end(), it -> second.ids.begin(), it -> second.ids.end() );
+    for( const auto& member : it -> second.members )
+      collect( sets, member, visited, ids, context );
+  }
+
+  void readDeck( Deck&                        deck,
+                 std::string_view             content,
+                 const Context&               context,
+                 const std::filesystem::path& directory,
+                 SizeT                        numThreads )
+  {
+    // keyword lines start with a single '*'
+    const auto keywords = mapLines<SizeT>( content, numThreads,
+                                           [content]( std::string_view line, std::vector<SizeT>& out ) {
+                                             if( line.starts_with( '*' ) && !line.starts_with( "**" ) )
+                                               out.push_back( line.data() - content.data() );
+                                           } );
+
+    for( SizeT k = 0; k < keywords.size(); ++k ) {
+      SizeT pos = keywords[k];
+      const Keyword keyword( nextLine( content, pos ) );
+      const SizeT end = k + 1 < keywords.size() ? keywords[k+1] : content.size();
+      const auto block = content.substr( pos, end - pos );
+
+      if( keyword.name == "NODE" ) {
+        auto nodes = parseNodes( block, numThreads, context );
+        if( const auto nset = upper( keyword.option( "NSET" ) ); !nset.empty() )
+          for( const auto& node : nodes ) deck.nsets[nset].ids.push_back( node.id );
+        deck.nodes.insert( deck.nodes.end(), nodes.begin(), nodes.end() );
+      }
+      else if( keyword.name == "ELEMENT" && deck.withElements ) {
+        // records may continue on the next line, so ids are read as one stream
+        const auto [shape,numNodes] = elementType( upper( keyword.option( "TYPE" ) ), context );
+        const auto ids = mapLines<SizeT>( block, numThreads,
+                                          [&]( std::string_view line, std::vector<SizeT>& out ) {
+                                            if( !isDataLine( line ) ) return;
+                                            for( Tokens tokens( line ); !tokens.empty(); )
+                                              out.push_back( number<SizeT>( tokens.next(), line, context ) );
+                                          } );
+        if( ids.size() % (numNodes + 1) != 0 )
+          context.fail( std::format( "incomplete element of type '{}'", keyword.option( "TYPE" ) ) );
+        Set* elset = nullptr;
+        if( const auto name = upper( keyword.option( "ELSET" ) ); !name.empty() )
+          elset = &deck.elsets[name];
+        for( SizeT i = 0; i < ids.size(); i += numNodes + 1 ) {
+          deck.elements.emplace_back( ids[i], deck.records.size() );
+          deck.records.push_back( static_cast<SizeT>( shape ) );
+          deck.records.push_back( numNodes );
+          deck.records.insert( deck.records.end(), ids.begin() + i + 1, ids.begin() + i + 1 + numNodes );
+          if( elset ) elset -> ids.push_back( ids[i] );
+        }
+      }
+      else if( keyword.name == "NSET" || keyword.name == "ELSET" ) {
+        const bool isNset = keyword.name == "NSET";
+        Set& set = (isNset ? deck.nsets : deck.elsets)[upper( keyword.option( keyword.name ) )];
+        const bool generate = keyword.options.contains( "GENERATE" );
+        for( SizeT at = 0; at < block.size(); ) {
+          const auto line = nextLine( block, at );
+          if( !isDataLine( line ) ) continue;
+          if( generate ) {
+            std::array<SizeT,3> range = { 0, 0, 1 };
+            Tokens tokens( line );
+            for( SizeT i = 0; i < range.size() && !tokens.empty(); ++i )
+              range[i] = number<SizeT>( tokens.next(), line, context );
+            if( range[2] == 0 ) context.fail( std::format( "zero increment in '{}'", line ) );
+            for( SizeT id = range[0]; id <= range[1]; id += range[2] ) set.ids.push_back( id );
+            continue;
+          }
+          for( Tokens tokens( line ); !tokens.empty(); ) {
+            const auto token = tokens.next();
+            SizeT id;
+            if( toNumber( token, id ) ) set.ids.push_back( id );
+            else                        set.members.push_back( upper( token ) );
+          }
+        }
+      }
+      else if( keyword.name == "INCLUDE" ) {
+        const std::filesystem::path file = directory / keyword.option( "INPUT" );
+        if( !std::filesystem::exists( file ) )
+          context.fail( std::format( "included file '{}' not found", file.string() ) );
+        const auto& mapped = deck.includes.emplace_back( file );
+        const std::string source = file.string();
+        readDeck( deck, mapped.view(), { context.where, source }, file.parent_path(), numThreads );
+      }
+    }
+  }
+
+} // end anonymous namespace
+
+//------------------------------------------------------------------------------
+namespace ts {
+
+  //----------------------------------------------------------------------------
+  std::vector<Real> TailsitMeshReader::operator()( const std::filesystem::path& file ) const
+  {
+    if( !std::filesystem::exists( file ) ) {
+      const std::string msg = "ts::TailsitMeshReader::operator():File '" + file.string() + "' not found";
+      throw std::runtime_error(msg);
+    }
+
+    const MappedFile mapped( file );
+    return parse( mapped.view(), file.string() );
+  }
+
+  //----------------------------------------------------------------------------
+  std::vector<Real> TailsitMeshReader::parse( std::string_view content,
+                                              std::string_view source ) const
+  {
+    const Context context{ "ts::TailsitMeshReader::parse", source };
+
+    // comment lines, then the header: dimension, numbers of nodes and elements
+    SizeT pos = 0;
+    std::vector<SizeT> header;
+    while( pos < content.size() && header.empty() ) {
+      const auto line = nextLine( content, pos );
+      if( line.starts_with( '#' ) ) continue;
+      for( Tokens tokens( line ); !tokens.empty(); )
+        header.push_back( number<SizeT>( tokens.next(), line, context ) );
+    }
+    if( header.size() < 3 ) context.fail( "header 'dim numNodes numElements' missing" );
+    if( header[0] != dim ) context.fail( std::format( "dimension {} instead of {}", header[0], dim ) );
+
+    const SizeT numNodes = header[1];
+    const SizeT nodesEnd = skipLines( content, pos, numNodes, numThreads );
+    if( nodesEnd == std::string_view::npos )
+      context.fail( std::format( "fewer than {} node rows", numNodes ) );
+    const auto nodes = parseNodes( content.substr( pos, nodesEnd - pos ), numThreads, context );
+    if( nodes.size() != numNodes )
+      context.fail( std::format( "{} node rows instead of {}", nodes.size(), numNodes ) );
+    if( region.empty() ) return coordinates( nodes );
+
+    // the region's elements 'type region nodes...'; type 13 are hexahedra
+    SizeT regionId;
+    if( !toNumber( std::string_view( region ), regionId ) )
+      context.fail( std::format( "region '{}' is not a number", region ) );
+    const auto records = mapLines<SizeT>( content.substr( nodesEnd ), numThreads,
+                                          [&]( std::string_view line, std::vector<SizeT>& out ) {
+                                            Tokens tokens( line );
+                                            if( tokens.empty() ) return;
+                                            const auto type = number<SizeT>( tokens.next(), line, context );
+                                            if( tokens.empty() || number<SizeT>( tokens.next(), line, context ) != regionId )
+                                              return;
+                                            const SizeT head = out.size();
+                                            out.push_back( static_cast<SizeT>( type == 13 ? Shape::hexahedron : Shape::nodes ) );
+                                            out.push_back( 0 );
+                                            while( !tokens.empty() )
+                                              out.push_back( number<SizeT>( tokens.next(), line, context ) );
+                                            out[head+1] = out.size() - head - 2;
+                                          } );
+    if( records.empty() )
+      context.fail( std::format( "no elements in region {}", region ) );
+    return coordinates( nodes, surfaceNodes( records, recordOffsets( records ) ), context );
+  }
+
+  //----------------------------------------------------------------------------
+  std::vector<Real> CalculixMeshReader::operator()( const std::filesystem::path& file ) const
+  {
+    if( !std::filesystem::exists( file ) ) {
+      const std::string msg = "ts::CalculixMeshReader::operator():File '" + file.string() + "' not found";
+      throw std::runtime_error(msg);
+    }
+
+    const MappedFile mapped( file );
+    return parse( mapped.view(), file.string(), file.parent_path() );
+  }
+
+  //----------------------------------------------------------------------------
+  std::vector<Real> CalculixMeshReader::parse( std::string_view             content,
+                                               std::string_view             source,
+                                               const std::filesystem::path& directory ) const
+  {
+    const Context context{ "ts::CalculixMeshReader::parse", source };
+
+    Deck deck;
+    deck.withElements = !region.empty();
+    readDeck( deck, content, context, directory, numThreads );
+    if( deck.nodes.empty() ) context.fail( "no *NODE" );
+
+    if( region.empty() ) return coordinates( deck.nodes );
+
+    std::vector<SizeT> selected;
+    std::set<std::string> visited;
+    const std::string name = upper( region );
+    if( deck.nsets.contains( name ) )
+      collect( deck.nsets, name, visited, selected, context );
+    else if( deck.elsets.contains( name ) ) {
+      std::vector<SizeT> elementIds;
+      collect( deck.elsets, name, visited, elementIds, context );
+      std::ranges::sort( elementIds );
+      const auto [first,last] = std::ranges::unique( elementIds );
+      elementIds.erase( first, last );
+
+      // elements are mostly numbered in order already
+      if( !std::ranges::is_sorted( deck.elements ) ) std::ranges::sort( deck.elements );
+      std::vector<SizeT> offsets;
+      offsets.reserve( elementIds.size() );
+      for( const SizeT id : elementIds ) {
+        const auto it = std::ranges::lower_bound( deck.elements, id, {}, &std::pair<SizeT,SizeT>::first );
+        if( it == deck.elements.end() || it -> first != id )
+          context.fail( std::format( "element {} of ELSET '{}' is not defined", id, region ) );
+        offsets.push_back( it -> second );
+      }
+      selected = surfaceNodes( deck.records, offsets );
+    }
+    else
+      context.fail( std::format( "no NSET or ELSET '{}'", region ) );
+
+    return coordinates( deck.nodes, selected, context );
+  }
+
+} // end namespace ts
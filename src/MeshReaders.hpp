@@ -0,0 +1,90 @@
+//------------------------------------------------------------------------------
+// <preamble>
+//
+//  ______
+// |
+// | TailSiT GmbH
+// | Graz, Austria
+//   www.tailsit.com
+//
+// </preamble>
+//------------------------------------------------------------------------------
+
+//! @author    Lars Kielhorn, Thomas Rüberg, Jürgen Zechner
+//! @date      2024
+//! @copyright TailSiT GmbH
+#pragma once
+
+// system ----------------------------------------------------------------------
+#include <filesystem>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// own -------------------------------------------------------------------------
+#include "types.hpp"
+
+//------------------------------------------------------------------------------
+namespace ts {
+
+  //----------------------------------------------------------------------------
+  /** Reader of the nodes of a TAILSIT GridData file (.mesh).
+   *
+   *  The file holds '#' comment lines, the header 'dim numNodes numElements
+   *  ...', numNodes rows 'id x y z' and then one row 'type region nodes...'
+   *  per element. It is memory mapped and split at line boundaries into
+   *  chunks that are parsed concurrently, as in CSVParser.
+   *
+   *  With a region (its number) only the nodes of the region's elements are
+   *  kept: all nodes of its surface elements, and of its hexahedra (type 13)
+   *  those on faces no other hexahedron of the region shares. The nodes are
+   *  returned as row-major coordinates in file order.
+   */
+  struct TailsitMeshReader
+  {
+    //! number of parser threads, zero means all hardware threads
+    SizeT numThreads = 0;
+
+    //! region number, all nodes if empty
+    std::string region;
+
+    std::vector<Real> operator()( const std::filesystem::path& file ) const;
+
+    std::vector<Real> parse( std::string_view content,
+                             std::string_view source = "<memory>" ) const;
+
+  }; // end class TailsitMeshReader
+
+  //----------------------------------------------------------------------------
+  /** Reader of the nodes of a CalculiX (Abaqus) input deck (.inp).
+   *
+   *  The deck is memory mapped, files it '*INCLUDE's as well. Its keyword
+   *  lines are found in chunks scanned concurrently; the data lines of the
+   *  *NODE and *ELEMENT blocks are then parsed in chunks concurrently, too.
+   *  Other keywords are skipped.
+   *
+   *  With a region only the nodes of the *NSET of that name are kept, or
+   *  if there is none, the surface nodes of the *ELSET: all nodes of its
+   *  shell, plane and beam elements, and of its solids those on faces no
+   *  other solid of the set shares. Of quadratic solids only the corner
+   *  nodes count. Set names are case insensitive, and sets may list other
+   *  sets. The nodes are returned as row-major coordinates in file order.
+   */
+  struct CalculixMeshReader
+  {
+    //! number of parser threads, zero means all hardware threads
+    SizeT numThreads = 0;
+
+    //! NSET or ELSET name, all nodes if empty
+    std::string region;
+
+    std::vector<Real> operator()( const std::filesystem::path& file ) const;
+
+    //! includes are looked up relative to directory
+    std::vector<Real> parse( std::string_view content,
+                             std::string_view source = "<memory>",
+                             const std::filesystem::path& directory = {} ) const;
+
+  }; // end class CalculixMeshReader
+
+} // end namespace ts
@@ -0,0 +1,285 @@
+//------------------------------------------------------------------------------
+// <preamble>
+//
+//  ______
+// |
+// | TailSiT GmbH
+// | Graz, Austria
+//   www.tailsit.com
+//
+// </preamble>
+//------------------------------------------------------------------------------
+
+//! @author    Lars Kielhorn, Thomas Rüberg, Jürgen Zechner
+//! @date      2024
+//! @copyright TailSiT GmbH
+#pragma once
+
+// system ----------------------------------------------------------------------
+#include <algorithm>
+#include <condition_variable>
+#include <exception>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+// own -------------------------------------------------------------------------
+#include "types.hpp"
+
+//------------------------------------------------------------------------------
+namespace ts {
+  namespace parallel {
+
+    //--------------------------------------------------------------------------
+    /** Number of worker threads to use; zero requests all hardware threads. */
+    inline SizeT numThreads( SizeT requested = 0 )
+    {
+      if( requested > 0 ) return requested;
+      return std::max<SizeT>( 1, std::thread::hardware_concurrency() );
+    }
+
+    //--------------------------------------------------------------------------
+    /** Range [begin,end) of block c when [0,n) is split into numBlocks
+     *  contiguous blocks whose sizes differ by at most one. */
+    inline std::pair<SizeT,SizeT> blockRange( SizeT n, SizeT numBlocks, SizeT c )
+    {
+      const SizeT base = n / numBlocks;
+      const SizeT rest = n % numBlocks;
+      auto begin = [base,rest]( SizeT b ) { return b*base + std::min( b, rest ); };
+      return { begin(c), begin(c+1) };
+    }
+
+    //--------------------------------------------------------------------------
+    /** Split [0,n) into at most numChunks contiguous ranges and call
+     *  f(chunk, begin, end) for each of them concurrently.
+     *
+     *  Chunk 0 runs on the calling thread. The first exception thrown by any
+     *  chunk is rethrown after all chunks have finished.
+     */
+    template< typename F >
+    void forEachChunk( SizeT n, SizeT numChunks, F&& f )
+    {
+      numChunks = std::clamp<SizeT>( numChunks, 1, std::max<SizeT>( n, 1 ) );
+      auto range = [n,numChunks]( SizeT c ) { return blockRange( n, numChunks, c ); };
+
+      if( numChunks == 1 ) {
+        f( SizeT{0}, SizeT{0}, n );
+        return;
+      }
+
+      std::vector<std::exception_ptr> errors( numChunks );
+      {
+        std::vector<std::jthread> workers;
+        workers.reserve( numChunks - 1 );
+        for( SizeT c = 1; c < numChunks; ++c )
+          workers.emplace_back( [&f,&errors,&range,c]() {
+            try { const auto [b,e] = range(c); f( c, b, e ); }
+            catch( ... ) { errors[c] = std::current_exception(); }
+          } );
+        try { const auto [b,e] = range(0); f( SizeT{0}, b, e ); }
+        catch( ... ) { errors[0] = std::current_exception(); }
+      } // joins
+
+      for( const auto& e : errors )
+        if( e ) std::rethrow_exception( e );
+    }
+
+    //--------------------------------------------------------------------------
+    /** Workers for repeated forEachChunk calls, e.g. one per implicit
+     *  iteration, without starting threads every time.
+     *
+     *  The workers are started on the first call needing more than one chunk
+     *  and then wait for the next call; they are joined on destruction. Chunk
+     *  0 runs on the calling thread. Calls must not overlap: a pool serves
+     *  one caller, e.g. one solver.
+     */
+    class ThreadPool
+    {
+    private:
+      struct Job_
+      {
+        void        (*run)( const void*, SizeT ) = nullptr; //!< runs chunk c
+        const void*  context   = nullptr;
+        SizeT        numChunks = 0;
+      };
+
+      SizeT                    numThreads_; //!< including the caller
+      std::mutex               mutex_;
+      std::condition_variable  wake_;
+      std::condition_variable  done_;
+      Job_                     job_;
+      SizeT                    generation_ = 0;
+      SizeT                    pending_    = 0;
+      bool                     stop_       = false;
+      std::vector<std::jthread> workers_; //!< last: joined before the rest goes
+
+    public:
+      //! zero means all hardware threads
+      explicit ThreadPool( SizeT numThreads = 0 )
+        : numThreads_( parallel::numThreads( numThreads ) )
+      {}
+
+      ThreadPool( const ThreadPool& ) = delete;
+      ThreadPool& operator=( const ThreadPool& ) = delete;
+
+      ~ThreadPool( )
+      {
+        {
+          std::scoped_lock lock( mutex_ );
+          stop_ = true;
+        }
+        wake_.notify_all();
+      } // joins
+
+      SizeT size( ) const { return numThreads_; }
+
+      //! as parallel::forEachChunk, on at most size() threads
+      template< typename F >
+      void forEachChunk( SizeT n, SizeT numChunks, F&& f )
+      {
+        numChunks = std::clamp<SizeT>( numChunks, 1, std::min( numThreads_, std::max<SizeT>( n, 1 ) ) );
+        if( numChunks == 1 ) {
+          f( SizeT{0}, SizeT{0}, n );
+          return;
+        }
+
+        struct Context
+        {
+          F&                               f;
+          SizeT                            n;
+          SizeT                            numChunks;
+          std::vector<std::exception_ptr>  errors;
+        } context{ f, n, numChunks, std::vector<std::exception_ptr>( numChunks ) };
+        const auto run = []( const void* ptr, SizeT c ) {
+          auto& ctx = *static_cast<Context*>( const_cast<void*>( ptr ) );
+          try { const auto [b,e] = blockRange( ctx.n, ctx.numChunks, c ); ctx.f( c, b, e ); }
+          catch( ... ) { ctx.errors[c] = std::current_exception(); }
+        };
+
+        start_();
+        {
+          std::scoped_lock lock( mutex_ );
+          job_     = { run, &context, numChunks };
+          pending_ = workers_.size();
+          ++generation_;
+        }
+        wake_.notify_all();
+        run( &context, 0 );
+        {
+          std::unique_lock lock( mutex_ );
+          done_.wait( lock, [this]() { return pending_ == 0; } );
+        }
+
+        for( const auto& e : context.errors )
+          if( e ) std::rethrow_exception( e );
+      }
+
+    private:
+      void start_( )
+      {
+        if( !workers_.empty() ) return;
+        workers_.reserve( numThreads_ - 1 );
+        for( SizeT w = 1; w < numThreads_; ++w )
+          workers_.emplace_back( [this,w]() { work_( w ); } );
+      }
+
+      //! worker w runs chunk w of every job that has one
+      void work_( SizeT w )
+      {
+        SizeT seen = 0;
+        while( true ) {
+          Job_ job;
+          {
+            std::unique_lock lock( mutex_ );
+            wake_.wait( lock, [&]() { return stop_ || generation_ != seen; } );
+            if( stop_ ) return;
+            seen = generation_;
+            job  = job_;
+          }
+          if( w < job.numChunks ) job.run( job.context, w );
+          std::scoped_lock lock( mutex_ );
+          if( --pending_ == 0 ) done_.notify_one();
+        }
+      }
+    };
+
+    //--------------------------------------------------------------------------
+    /** Call f(task) for every task in [0,n) on up to numThreads threads.
+     *
+     *  For tasks of uneven cost, e.g. whole runs: every thread starts on its
+     *  own contiguous block of tasks; a thread running out of work steals
+     *  the upper half of the largest remaining block. Thread 0 is the
+     *  calling thread. A thread stops at the first exception it catches,
+     *  which is rethrown after all threads have finished.
+     */
+    template< typename F >
+    void forEachTask( SizeT n, SizeT numThreads, F&& f )
+    {
+      struct Block
+      {
+        std::mutex mutex;
+        SizeT      next = 0;
+        SizeT      end  = 0;
+      };
+
+      numThreads = std::clamp<SizeT>( numThreads, 1, std::max<SizeT>( n, 1 ) );
+      std::vector<Block> blocks( numThreads );
+      for( SizeT t = 0; t < numThreads; ++t )
+        std::tie( blocks[t].next, blocks[t].end ) = blockRange( n, numThreads, t );
+
+      auto pop = [&blocks,numThreads]( SizeT self ) -> std::optional<SizeT> {
+        {
+          std::scoped_lock lock( blocks[self].mutex );
+          if( blocks[self].next < blocks[self].end ) return blocks[self].next++;
+        }
+        while( true ) {
+          SizeT victim = self, most = 0;
+          for( SizeT t = 0; t < numThreads; ++t ) {
+            std::scoped_lock lock( blocks[t].mutex );
+            if( blocks[t].end - blocks[t].next > most ) {
+              most   = blocks[t].end - blocks[t].next;
+              victim = t;
+            }
+          }
+          if( most == 0 ) return std::nullopt;
+
+          SizeT begin, end;
+          {
+            std::scoped_lock lock( blocks[victim].mutex );
+            const SizeT rest = blocks[victim].end - blocks[victim].next;
+            if( rest == 0 ) continue;
+            end   = blocks[victim].end;
+            begin = end - (rest + 1) / 2;
+            blocks[victim].end = begin;
+          }
+          std::scoped_lock lock( blocks[self].mutex );
+          blocks[self].next = begin + 1;
+          blocks[self].end  = end;
+          return begin;
+        }
+      };
+
+      std::vector<std::exception_ptr> errors( numThreads );
+      auto work = [&f,&errors,&pop]( SizeT self ) {
+        try {
+          while( const auto task = pop( self ) ) f( *task );
+        }
+        catch( ... ) { errors[self] = std::current_exception(); }
+      };
+      {
+        std::vector<std::jthread> workers;
+        workers.reserve( numThreads - 1 );
+        for( SizeT t = 1; t < numThreads; ++t )
+          workers.emplace_back( work, t );
+        work( SizeT{0} );
+      } // joins
+
+      for( const auto& e : errors )
+        if( e ) std::rethrow_exception( e );
+    }
+
+  } // end namespace parallel
+} // end namespace ts
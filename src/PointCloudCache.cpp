@@ -0,0 +1,194 @@
+//------------------------------------------------------------------------------
+// <preamble>
+//
+//  ______
+// |
+// | TailSiT GmbH
+// | Graz, Austria
+//   www.tailsit.com
+//
+// </preamble>
+//------------------------------------------------------------------------------
+
+//! @author    Lars Kielhorn, Thomas Rüberg, Jürgen Zechner
+//! @date      2024
+//! @copyright TailSiT GmbH
+
+// system ----------------------------------------------------------------------
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <system_error>
+
+// posix -----------------------------------------------------------------------
+#include <stdlib.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+// own -------------------------------------------------------------------------
+#include "PointCloudCache.hpp"
+#include "Parallel.hpp"
+
+//------------------------------------------------------------------------------
+namespace {
+
+  constexpr char          magic[8] = { 'T','S','C','L','O','U','D','\0' };
+  constexpr std::uint32_t version  = 1;
+
+} // end anonymous namespace
+
+//------------------------------------------------------------------------------
+namespace ts {
+
+  //----------------------------------------------------------------------------
+  PointCloudCache::PointCloudCache( )
+    : mapped_()
+    , parsed_()
+    , coords_()
+    , fromCache_(false)
+  {
+    // empty
+  }
+
+  //----------------------------------------------------------------------------
+  auto PointCloudCache::stamp_( const std::filesystem::path& file ) -> Stamp_
+  {
+    // -1 never matches a recorded value
+    Stamp_ stamp{ -1, -1, -1 };
+    struct stat status;
+    if( ::stat( file.c_str(), &status ) != 0 ) return stamp;
+    std::error_code ec;
+    const auto mtime = std::filesystem::last_write_time( file, ec );
+    stamp.size  = status.st_size;
+    stamp.mtime = ec ? -1 : mtime.time_since_epoch().count();
+    stamp.ctime = std::int64_t{ status.st_ctim.tv_sec } * 1'000'000'000 + status.st_ctim.tv_nsec;
+    return stamp;
+  }
+
+  //----------------------------------------------------------------------------
+  std::filesystem::path PointCloudCache::cachePath( const std::filesystem::path& csvFile )
+  {
+    auto path = csvFile;
+    path += extension;
+    return path;
+  }
+
+  //----------------------------------------------------------------------------
+  std::uint64_t PointCloudCache::hash( std::span<const std::byte> bytes )
+  {
+    std::uint64_t h = 0xcbf29ce484222325ull;
+    for( const auto b : bytes ) {
+      h ^= static_cast<std::uint64_t>( b );
+      h *= 0x100000001b3ull;
+    }
+    return h;
+  }
+
+  //----------------------------------------------------------------------------
+  bool PointCloudCache::tryMap_( const std::filesystem::path& csvFile, SizeT dim )
+  {
+    const auto binFile = cachePath( csvFile );
+    std::error_code ec;
+    if( !std::filesystem::exists( binFile, ec ) || !std::filesystem::exists( csvFile, ec ) )
+      return false;
+
+    MappedFile mapped( binFile );
+    if( mapped.size() < sizeof(Header) ) return false;
+
+    Header header;
+    std::memcpy( &header, mapped.view().data(), sizeof(Header) );
+    if( std::memcmp( header.magic, magic, sizeof(magic) ) != 0 ||
+        header.version  != version ||
+        header.dim      != dim ||
+        header.realSize != sizeof(Real) ||
+        mapped.size()   != sizeof(Header) + header.numVertices * dim * sizeof(Real) )
+      return false;
+
+    // stale check: size and times first, the hash if any time moved
+    const Stamp_ stamp = stamp_( csvFile );
+    if( static_cast<std::int64_t>( header.sourceSize ) != stamp.size ) return false;
+    if( header.sourceMTime != stamp.mtime || header.sourceCTime != stamp.ctime ) {
+      if( header.sourceHash != hash( MappedFile( csvFile ).bytes() ) ) return false;
+
+      // same content, just touched or copied: refresh the recorded times
+      header.sourceMTime = stamp.mtime;
+      header.sourceCTime = stamp.ctime;
+      std::fstream out( binFile, std::ios::binary | std::ios::in | std::ios::out );
+      if( out ) out.write( reinterpret_cast<const char*>(&header), sizeof(Header) );
+    }
+
+    mapped_    = std::move( mapped );
+    coords_    = { reinterpret_cast<const Real*>( mapped_.view().data() + sizeof(Header) ),
+                   header.numVertices * dim };
+    fromCache_ = true;
+    return true;
+  }
+
+  //----------------------------------------------------------------------------
+  void PointCloudCache::slice_( SizeT dim, SizeT part, SizeT numParts )
+  {
+    if( numParts <= 1 ) return;
+    const auto [begin,end] = parallel::blockRange( coords_.size() / dim, numParts, part );
+    coords_ = coords_.subspan( begin * dim, (end - begin) * dim );
+  }
+
+  //----------------------------------------------------------------------------
+  void PointCloudCache::adopt_( const std::filesystem::path& csvFile,
+                                SizeT dim,
+                                const Stamp_& stamp,
+                                std::span<const std::byte> source,
+                                std::vector<Real>&& coords )
+  {
+    parsed_    = std::move( coords );
+    coords_    = parsed_;
+    fromCache_ = false;
+
+    Header header{};
+    std::ranges::copy( magic, header.magic );
+    header.version     = version;
+    header.dim         = static_cast<std::uint32_t>( dim );
+    header.realSize    = sizeof(Real);
+    header.numVertices = parsed_.size() / dim;
+    header.sourceSize  = static_cast<std::uint64_t>( stamp.size );
+    header.sourceMTime = stamp.mtime;
+    header.sourceCTime = stamp.ctime;
+    header.sourceHash  = hash( source );
+
+    // a source changed while it was parsed is not cached at all
+    if( stamp.size < 0 || static_cast<std::int64_t>( source.size() ) != stamp.size ||
+        stamp_( csvFile ) != stamp )
+      return;
+
+    // write to a temporary of this process and rename, so concurrent runs
+    // never see half a cache; an unwritable directory merely means no cache
+    const auto binFile = cachePath( csvFile );
+    std::string tmpName = binFile.string() + ".XXXXXX";
+    const int fd = ::mkstemp( tmpName.data() );
+    if( fd < 0 ) return;
+    ::fchmod( fd, 0644 );
+    ::close( fd );
+    const std::filesystem::path tmpFile = tmpName;
+    {
+      std::ofstream out( tmpFile, std::ios::binary | std::ios::trunc );
+      if( !out ) {
+        std::error_code ec;
+        std::filesystem::remove( tmpFile, ec );
+        return;
+      }
+      out.write( reinterpret_cast<const char*>(&header), sizeof(Header) );
+      out.write( reinterpret_cast<const char*>( parsed_.data() ),
+                 static_cast<std::streamsize>( parsed_.size() * sizeof(Real) ) );
+      if( !out ) {
+        out.close();
+        std::error_code ec;
+        std::filesystem::remove( tmpFile, ec );
+        return;
+      }
+    }
+    std::error_code ec;
+    std::filesystem::rename( tmpFile, binFile, ec );
+    if( ec ) std::filesystem::remove( tmpFile, ec );
+  }
+
+} // end namespace ts
@@ -0,0 +1,175 @@
+//------------------------------------------------------------------------------
+// <preamble>
+//
+//  ______
+// |
+// | TailSiT GmbH
+// | Graz, Austria
+//   www.tailsit.com
+//
+// </preamble>
+//------------------------------------------------------------------------------
+
+//! @author    Lars Kielhorn, Thomas Rüberg, Jürgen Zechner
+//! @date      2024
+//! @copyright TailSiT GmbH
+#pragma once
+
+// system ----------------------------------------------------------------------
+#include <cstdint>
+#include <filesystem>
+#include <span>
+#include <string_view>
+#include <vector>
+
+// own -------------------------------------------------------------------------
+#include "types.hpp"
+#include "MappedFile.hpp"
+#include "CSVParser.hpp"
+
+//------------------------------------------------------------------------------
+namespace ts {
+
+  class PointCloudCache;
+
+}
+
+//------------------------------------------------------------------------------
+/** Binary cache of a parsed coordinate file.
+ *
+ *  The cache lives next to the source as '<source>.tsbin': a fixed 64 byte
+ *  header followed by the raw row-major coordinates in native byte order.
+ *  A cache is reused if its header matches the source's size, mtime and
+ *  ctime. If only the times differ the source is hashed and the cache kept
+ *  when the hash still matches. The ctime cannot be set by tools, so a
+ *  rewrite that keeps size and mtime (cp -p, touch -r) is still hashed.
+ *  Otherwise the source is parsed and the cache is rewritten, through a
+ *  temporary of the process and a rename; a source that changes while it
+ *  is parsed is not cached. Reused caches are memory mapped, no parsing
+ *  takes place.
+ *
+ *  Partitioned loads (numParts > 1) keep only the rows of one part: a valid
+ *  cache is mapped and sliced, otherwise just the part's slice of the source
+ *  is parsed. They never write the cache, as no rank holds all rows; a
+ *  serial run creates it.
+ */
+class ts::PointCloudCache
+{
+public:
+  static constexpr std::string_view extension = ".tsbin";
+
+  struct Header
+  {
+    char          magic[8];
+    std::uint32_t version;
+    std::uint32_t dim;
+    std::uint32_t realSize;    //!< precision, sizeof(Real)
+    std::uint32_t reserved;
+    std::uint64_t numVertices;
+    std::uint64_t sourceSize;
+    std::int64_t  sourceMTime; //!< ticks of std::filesystem::file_time_type
+    std::uint64_t sourceHash;  //!< FNV-1a of the source bytes
+    std::int64_t  sourceCTime; //!< status change time in ns, zero in old caches
+  };
+  static_assert( sizeof(Header) == 64 );
+
+private:
+  MappedFile        mapped_;
+  std::vector<Real> parsed_;
+  std::span<const Real> coords_;
+  bool              fromCache_;
+
+public:
+  /** Load coordinates with DIM columns from csvFile, going through the cache */
+  template< SizeT DIM >
+  static PointCloudCache load( const std::filesystem::path& csvFile,
+                               SizeT part     = 0,
+                               SizeT numParts = 1 );
+
+  /** Coordinates read by other means, e.g. the nodes of a mesh file, kept
+   *  without a cache file; a partitioned load keeps the rows of one part */
+  template< SizeT DIM >
+  static PointCloudCache adopt( std::vector<Real>&& coords,
+                                SizeT part     = 0,
+                                SizeT numParts = 1 );
+
+  static std::filesystem::path cachePath( const std::filesystem::path& csvFile );
+
+  static std::uint64_t hash( std::span<const std::byte> bytes );
+
+  std::span<const Real> coordinates( ) const { return coords_; }
+
+  //! true if the coordinates were mapped from an existing cache file
+  bool fromCache( ) const { return fromCache_; }
+
+private:
+  //! size and times of a source, as recorded in the header; -1 if unknown
+  struct Stamp_
+  {
+    std::int64_t size;
+    std::int64_t mtime;
+    std::int64_t ctime;
+
+    bool operator==( const Stamp_& ) const = default;
+  };
+
+  PointCloudCache( );
+
+  static Stamp_ stamp_( const std::filesystem::path& file );
+
+  bool tryMap_( const std::filesystem::path& csvFile, SizeT dim );
+
+  void slice_( SizeT dim, SizeT part, SizeT numParts );
+
+  void adopt_( const std::filesystem::path& csvFile,
+               SizeT dim,
+               const Stamp_& stamp,
+               std::span<const std::byte> source,
+               std::vector<Real>&& coords );
+
+}; // end class PointCloudCache
+
+//============================================================================
+//
+// IMPLEMENTATION
+//
+//============================================================================
+template< ts::SizeT DIM >
+ts::PointCloudCache ts::PointCloudCache::load( const std::filesystem::path& csvFile,
+                                               SizeT part,
+                                               SizeT numParts )
+{
+  PointCloudCache cache;
+  if( cache.tryMap_( csvFile, DIM ) ) {
+    cache.slice_( DIM, part, numParts );
+  }
+  else if( numParts > 1 ) {
+    CSVParser<DIM,Real> parser;
+    parser.part     = part;
+    parser.numParts = numParts;
+    cache.parsed_   = parser( csvFile );
+    cache.coords_   = cache.parsed_;
+  }
+  else {
+    // parse and hash the same bytes, stamped before they were mapped, so a
+    // source rewritten meanwhile is never cached with its old coordinates
+    const Stamp_     stamp = stamp_( csvFile );
+    const MappedFile mapped( csvFile );
+    cache.adopt_( csvFile, DIM, stamp, mapped.bytes(),
+                  CSVParser<DIM,Real>().parse( mapped.view(), ',', '#', csvFile.string() ) );
+  }
+  return cache;
+}
+
+//------------------------------------------------------------------------------
+template< ts::SizeT DIM >
+ts::PointCloudCache ts::PointCloudCache::adopt( std::vector<Real>&& coords,
+                                                SizeT part,
+                                                SizeT numParts )
+{
+  PointCloudCache cache;
+  cache.parsed_ = std::move( coords );
+  cache.coords_ = cache.parsed_;
+  cache.slice_( DIM, part, numParts );
+  return cache;
+}
@@ -0,0 +1,75 @@
+//------------------------------------------------------------------------------
+// <preamble>
+//
+//  ______
+// |
+// | TailSiT GmbH
+// | Graz, Austria
+//   www.tailsit.com
+//
+// </preamble>
+//------------------------------------------------------------------------------
+
+//! @author    Lars Kielhorn, Thomas Rüberg, Jürgen Zechner
+//! @date      2024
+//! @copyright TailSiT GmbH
+#pragma once
+
+// system ----------------------------------------------------------------------
+#include <algorithm>
+#include <cmath>
+#include <span>
+#include <string_view>
+#include <vector>
+
+// own -------------------------------------------------------------------------
+#include "types.hpp"
+#include "Settings.hpp"
+#include "RigidMotion.hpp"
+
+//------------------------------------------------------------------------------
+namespace ts {
+
+  class PolynomialForce;
+
+}
+
+//------------------------------------------------------------------------------
+/** Polynomial in the axial displacement s = |U[axis]|,
+ *
+ *    F[axis] = sum_i c_i s^i.
+ */
+class ts::PolynomialForce
+{
+public:
+  using Settings = PolynomialForceSettings;
+  static constexpr std::string_view name = "polynomial";
+
+private:
+  std::vector<Real> coefficients_;
+  SizeT             axis_;
+
+public:
+  explicit PolynomialForce( const Settings& settings = {} )
+    : coefficients_( settings.coefficients )
+    , axis_( settings.axis )
+  {}
+
+  Real eval( Real s ) const
+  {
+    // Horner
+    Real p = 0;
+    for( auto c = coefficients_.rbegin(); c != coefficients_.rend(); ++c )
+      p = p*s + *c;
+    return p;
+  }
+
+  void operator()( Real               /*time*/,
+                   const RigidMotion& motion,
+                   std::span<Real>    Feval ) const
+  {
+    std::ranges::fill( Feval, 0 );
+    Feval[axis_] = this->eval( std::abs(motion.translation[axis_]) );
+  }
+
+}; // end class PolynomialForce
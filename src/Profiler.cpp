@@ -0,0 +1,132 @@
+//------------------------------------------------------------------------------
+// <preamble>
+//
+//  ______
+// |
+// | TailSiT GmbH
+// | Graz, Austria
+//   www.tailsit.com
+//
+// </preamble>
+//------------------------------------------------------------------------------
+
+//! @author    Lars Kielhorn, Thomas Rüberg, Jürgen Zechner
+//! @date      2024
+//! @copyright TailSiT GmbH
+
+// system ----------------------------------------------------------------------
+#include <algorithm>
+#include <format>
+#include <fstream>
+#include <stdexcept>
+
+// own -------------------------------------------------------------------------
+#include "Profiler.hpp"
+
+//------------------------------------------------------------------------------
+namespace ts {
+
+  //----------------------------------------------------------------------------
+  Profiler::Profiler( const ProfilingSettings& settings )
+    : enabled_( settings.enabled )
+    , settings_( settings )
+    , origin_( Clock::now() )
+    , stats_()
+    , events_()
+    , droppedEvents_(0)
+    , window_(0)
+    , iteration_(0)
+    , numIterations_(0)
+    , maxIterations_(0)
+  {
+    if( enabled_ && !settings_.traceFile.empty() )
+      events_.reserve( std::min<SizeT>( settings_.maxTraceEvents, SizeT{1} << 16 ) );
+  }
+
+  //----------------------------------------------------------------------------
+  void Profiler::reset( )
+  {
+    origin_ = Clock::now();
+    stats_  = {};
+    events_.clear();
+    droppedEvents_ = 0;
+    window_        = 0;
+    iteration_     = 0;
+    numIterations_ = 0;
+    maxIterations_ = 0;
+  }
+
+  //----------------------------------------------------------------------------
+  void Profiler::endWindow( )
+  {
+    maxIterations_ = std::max( maxIterations_, iteration_ );
+    iteration_ = 0;
+    ++window_;
+  }
+
+  //----------------------------------------------------------------------------
+  void Profiler::record_( Phase phase, Clock::time_point begin, Clock::time_point end )
+  {
+    const Real seconds = std::chrono::duration<Real>( end - begin ).count();
+    auto& s = stats_[static_cast<SizeT>( phase )];
+    s.min    = s.calls ? std::min( s.min, seconds ) : seconds;
+    s.max    = std::max( s.max, seconds );
+    s.total += seconds;
+    ++s.calls;
+
+    if( settings_.traceFile.empty() ) return;
+    if( events_.size() < settings_.maxTraceEvents )
+      events_.push_back( { phase, begin, end, window_, iteration_ } );
+    else
+      ++droppedEvents_;
+  }
+
+  //----------------------------------------------------------------------------
+  std::ostream& Profiler::writeSummary( std::ostream& out ) const
+  {
+    const Real wall = std::chrono::duration<Real>( Clock::now() - origin_ ).count();
+    out << std::format( "# PROFILE: {} windows, {} iterations ({:.2f} per window, max {})\n",
+                        window_, numIterations_,
+                        window_ ? Real( numIterations_ ) / window_ : Real( 0 ),
+                        std::max( maxIterations_, iteration_ ) )
+        << std::format( "# {:<18s} {:>10s} {:>12s} {:>12s} {:>12s} {:>12s} {:>7s}\n",
+                        "phase", "calls", "total [s]", "mean [s]", "min [s]", "max [s]", "wall %" );
+    for( SizeT p = 0; p < numPhases; ++p ) {
+      const auto& s = stats_[p];
+      if( s.calls == 0 ) continue;
+      out << std::format( "  {:<18s} {:>10d} {:>12.4e} {:>12.4e} {:>12.4e} {:>12.4e} {:>7.2f}\n",
+                          phaseNames[p], s.calls, s.total, s.total / s.calls, s.min, s.max,
+                          wall > 0 ? 100 * s.total / wall : Real( 0 ) );
+    }
+    if( droppedEvents_ )
+      out << std::format( "# {} trace events dropped (maxTraceEvents)\n", droppedEvents_ );
+    return out;
+  }
+
+  //----------------------------------------------------------------------------
+  void Profiler::writeTrace( const std::filesystem::path& file, SizeT pid ) const
+  {
+    std::ofstream out( file );
+    if( !out ) {
+      const std::string msg = std::format( "ts::Profiler::writeTrace:Cannot write '{}'",
+                                           file.string() );
+      throw std::runtime_error(msg);
+    }
+
+    auto micro = [this]( Clock::time_point t ) {
+      return std::chrono::duration<Real,std::micro>( t - origin_ ).count();
+    };
+    out << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+    for( SizeT e = 0; e < events_.size(); ++e ) {
+      const auto& ev = events_[e];
+      out << (e ? ",\n" : "\n")
+          << std::format( "{{\"name\":\"{}\",\"ph\":\"X\",\"ts\":{:.3f},\"dur\":{:.3f},"
+                          "\"pid\":{},\"tid\":0,\"args\":{{\"window\":{},\"iteration\":{}}}}}",
+                          phaseNames[static_cast<SizeT>( ev.phase )],
+                          micro( ev.begin ), micro( ev.end ) - micro( ev.begin ),
+                          pid, ev.window, ev.iteration );
+    }
+    out << "\n]}\n";
+  }
+
+} // end namespace ts
@@ -0,0 +1,159 @@
+//------------------------------------------------------------------------------
+// <preamble>
+//
+//  ______
+// |
+// | TailSiT GmbH
+// | Graz, Austria
+//   www.tailsit.com
+//
+// </preamble>
+//------------------------------------------------------------------------------
+
+//! @author    Lars Kielhorn, Thomas Rüberg, Jürgen Zechner
+//! @date      2024
+//! @copyright TailSiT GmbH
+#pragma once
+
+// system ----------------------------------------------------------------------
+#include <array>
+#include <chrono>
+#include <filesystem>
+#include <ostream>
+#include <string_view>
+#include <vector>
+
+// own -------------------------------------------------------------------------
+#include "types.hpp"
+#include "Settings.hpp"
+
+//------------------------------------------------------------------------------
+namespace ts {
+
+  class Profiler;
+
+}
+
+//------------------------------------------------------------------------------
+/** Scoped timers for the phases of the coupling loop.
+ *
+ *  Every phase accumulates calls and time; the window and iteration counters
+ *  are advanced by the ForceGenerator. With a trace file set, every scope is
+ *  also kept as an event (up to settings.maxTraceEvents) and written as
+ *  Chrome trace-event JSON (chrome://tracing, Perfetto). Switched off, a
+ *  scope costs a single predictable branch.
+ */
+class ts::Profiler
+{
+public:
+  enum class Phase { checkpointSave,
+                     readData,
+                     set,
+                     solve,
+                     fit,        //!< rigid motion, inside solve
+                     force,      //!< force model, inside solve
+                     get,
+                     writeData,
+                     advance,
+                     checkpointReload,
+                     endTimeStep,
+                     numPhases };
+
+  static constexpr SizeT numPhases = static_cast<SizeT>( Phase::numPhases );
+  static constexpr std::array<std::string_view,numPhases> phaseNames =
+    { "checkpointSave", "readData", "set", "solve", "fit", "force",
+      "get", "writeData", "advance", "checkpointReload", "endTimeStep" };
+
+  using Clock = std::chrono::steady_clock;
+
+  //----------------------------------------------------------------------------
+  class Scope
+  {
+  private:
+    Profiler*         profiler_;
+    Phase             phase_;
+    Clock::time_point begin_;
+
+  public:
+    Scope( Profiler& profiler, Phase phase )
+      : profiler_( profiler.enabled_ ? &profiler : nullptr )
+      , phase_( phase )
+    {
+      if( profiler_ ) begin_ = Clock::now();
+    }
+
+    Scope( const Scope& ) = delete;
+    Scope& operator=( const Scope& ) = delete;
+
+    ~Scope( )
+    {
+      if( profiler_ ) profiler_ -> record_( phase_, begin_, Clock::now() );
+    }
+  };
+
+private:
+  struct Stats_
+  {
+    SizeT calls = 0;
+    Real  total = 0;
+    Real  min   = 0;
+    Real  max   = 0;
+  };
+
+  struct Event_
+  {
+    Phase             phase;
+    Clock::time_point begin;
+    Clock::time_point end;
+    SizeT             window;
+    SizeT             iteration;
+  };
+
+  bool                          enabled_;
+  ProfilingSettings             settings_;
+  Clock::time_point             origin_;
+  std::array<Stats_,numPhases>  stats_;
+  std::vector<Event_>           events_;
+  SizeT                         droppedEvents_;
+  SizeT                         window_;        //!< accepted windows so far
+  SizeT                         iteration_;     //!< iterations of the current window
+  SizeT                         numIterations_; //!< over all windows
+  SizeT                         maxIterations_; //!< per window
+
+public:
+  explicit Profiler( const ProfilingSettings& settings = {} );
+
+  bool enabled( ) const { return enabled_; }
+
+  //! forget everything recorded so far
+  void reset( );
+
+  /** @name counters, advanced by the ForceGenerator */
+  //@{
+  void beginIteration( ) { ++iteration_; ++numIterations_; }
+
+  void endWindow( );
+
+  SizeT numWindows( ) const { return window_; }
+  SizeT iteration( ) const { return iteration_; }
+  SizeT numIterations( ) const { return numIterations_; }
+  //@}
+
+  /** @name accumulated phases, while running */
+  //@{
+  SizeT calls( Phase phase ) const { return stats_[static_cast<SizeT>( phase )].calls; }
+  Real  total( Phase phase ) const { return stats_[static_cast<SizeT>( phase )].total; }
+  //@}
+
+  /** @name output at finalize */
+  //@{
+  std::ostream& writeSummary( std::ostream& out ) const;
+
+  //! trace events of all scopes, pid identifies the rank
+  void writeTrace( const std::filesystem::path& file, SizeT pid = 0 ) const;
+  //@}
+
+private:
+  void record_( Phase phase, Clock::time_point begin, Clock::time_point end );
+
+}; // end class Profiler
@@ -0,0 +1,103 @@
+//------------------------------------------------------------------------------
+// <preamble>
+//
+//  ______
+// |
+// | TailSiT GmbH
+// | Graz, Austria
+//   www.tailsit.com
+//
+// </preamble>
+//------------------------------------------------------------------------------
+
+//! @author    Lars Kielhorn, Thomas Rüberg, Jürgen Zechner
+//! @date      2024
+//! @copyright TailSiT GmbH
+#pragma once
+
+// system ----------------------------------------------------------------------
+#include <algorithm>
+#include <span>
+#include <string_view>
+#include <vector>
+
+// own -------------------------------------------------------------------------
+#include "types.hpp"
+#include "CouplingTrace.hpp"
+
+//------------------------------------------------------------------------------
+namespace ts {
+
+  template< typename PARTICIPANT >
+  class RecordingParticipant;
+
+}
+
+//------------------------------------------------------------------------------
+/** Passes the coupling calls on to PARTICIPANT and streams every iteration
+ *  to a CouplingTrace: the checkpoint flags, the step size advanced by, the
+ *  displacements read and the forces written. A record is complete once
+ *  the participant has advanced.
+ */
+template< typename PARTICIPANT >
+class ts::RecordingParticipant
+{
+private:
+  PARTICIPANT&           participant_;
+  CouplingTrace::Writer& trace_;
+  bool                   writeCheckpoint_;
+  std::vector<Real>      displacements_;
+  std::vector<Real>      forces_;
+
+public:
+  RecordingParticipant( PARTICIPANT& participant, CouplingTrace::Writer& trace )
+    : participant_(participant)
+    , trace_(trace)
+    , writeCheckpoint_(false)
+    , displacements_()
+    , forces_()
+  {}
+
+  /** @name the precice::Participant calls of the coupling loop */
+  //@{
+  bool isCouplingOngoing( ) const { return participant_.isCouplingOngoing(); }
+
+  bool requiresWritingCheckpoint( )
+  {
+    writeCheckpoint_ = participant_.requiresWritingCheckpoint();
+    return writeCheckpoint_;
+  }
+
+  bool requiresReadingCheckpoint( ) const { return participant_.requiresReadingCheckpoint(); }
+
+  Real getMaxTimeStepSize( ) const { return participant_.getMaxTimeStepSize(); }
+
+  void readData( std::string_view      meshName,
+                 std::string_view      dataName,
+                 std::span<const Int>  vertexIds,
+                 Real                  relativeReadTime,
+                 std::span<Real>       values )
+  {
+    participant_.readData( meshName, dataName, vertexIds, relativeReadTime, values );
+    displacements_.assign( values.begin(), values.end() );
+  }
+
+  void writeData( std::string_view      meshName,
+                  std::string_view      dataName,
+                  std::span<const Int>  vertexIds,
+                  std::span<const Real> values )
+  {
+    forces_.assign( values.begin(), values.end() );
+    participant_.writeData( meshName, dataName, vertexIds, values );
+  }
+
+  void advance( Real dt )
+  {
+    participant_.advance(dt);
+    trace_.write( dt, writeCheckpoint_, participant_.requiresReadingCheckpoint(),
+                  displacements_, forces_ );
+    writeCheckpoint_ = false;
+  }
+  //@}
+
+}; // end class RecordingParticipant
@@ -0,0 +1,139 @@
+//------------------------------------------------------------------------------
+// <preamble>
+//
+//  ______
+// |
+// | TailSiT GmbH
+// | Graz, Austria
+//   www.tailsit.com
+//
+// </preamble>
+//------------------------------------------------------------------------------
+
+//! @author    Lars Kielhorn, Thomas Rüberg, Jürgen Zechner
+//! @date      2024
+//! @copyright TailSiT GmbH
+#pragma once
+
+// system ----------------------------------------------------------------------
+#include <algorithm>
+#include <array>
+#include <span>
+#include <string_view>
+
+// own -------------------------------------------------------------------------
+#include "types.hpp"
+#include "Trajectory.hpp"
+
+//------------------------------------------------------------------------------
+namespace ts {
+
+  class ReplayParticipant;
+
+}
+
+//------------------------------------------------------------------------------
+/** Stand-in for precice::Participant that replays a prescribed trajectory.
+ *
+ *  Windows have length dt; a read at relativeReadTime r after the current
+ *  time t delivers U(t+r) on all vertices, as 'Displacements' or as
+ *  'DisplacementDeltas' U(t+r) - U(t), depending on the data name read.
+ *  The time moves by the steps passed to advance(), so steps shorter than
+ *  the window (adaptive steps) follow the trajectory, too; a window ends
+ *  when its steps add up to dt. Every window takes numIterations implicit
+ *  iterations: the first asks for a checkpoint at the window start, all
+ *  but the last ask to reload it at the window end. Earlier iterations see
+ *  the displacement off by iterationError per outstanding iteration, as an
+ *  accelerated implicit scheme would deliver it. Written forces are summed.
+ */
+class ts::ReplayParticipant
+{
+private:
+  const Trajectory& trajectory_;
+  Real              dt_;
+  SizeT             numWindows_;
+  SizeT             numIterations_;
+  Real              iterationError_;
+  SizeT             window_;
+  Real              windowTime_;   //!< time advanced within the window
+  SizeT             iteration_;
+  bool              readCheckpoint_;
+  Real              forceSum_;
+
+public:
+  ReplayParticipant( const Trajectory& trajectory,
+                     Real              dt,
+                     SizeT             numWindows,
+                     SizeT             numIterations  = 1,
+                     Real              iterationError = 1e-4 )
+    : trajectory_(trajectory)
+    , dt_(dt)
+    , numWindows_(numWindows)
+    , numIterations_( std::max<SizeT>( 1, numIterations ) )
+    , iterationError_(iterationError)
+    , window_(0)
+    , windowTime_(0)
+    , iteration_(0)
+    , readCheckpoint_(false)
+    , forceSum_(0)
+  {}
+
+  //! sum of all forces written
+  Real forceSum( ) const { return forceSum_; }
+
+  /** @name the precice::Participant calls of the coupling loop */
+  //@{
+  bool isCouplingOngoing( ) const { return window_ < numWindows_; }
+
+  bool requiresWritingCheckpoint( ) const
+  {
+    return numIterations_ > 1 && iteration_ == 0 && windowTime_ == 0;
+  }
+
+  bool requiresReadingCheckpoint( ) const { return readCheckpoint_; }
+
+  Real getMaxTimeStepSize( ) const { return dt_ - windowTime_; }
+
+  void readData( std::string_view      /*meshName*/,
+                 std::string_view      dataName,
+                 std::span<const Int>  vertexIds,
+                 Real                  relativeReadTime,
+                 std::span<Real>       values ) const
+  {
+    const Real error = (numIterations_ - 1 - iteration_) * iterationError_;
+    const Real time  = window_ * dt_ + windowTime_;
+    auto U = trajectory_( time + relativeReadTime );
+    if( dataName == "DisplacementDeltas" ) {
+      const auto Uold = trajectory_( time );
+      for( SizeT a = 0; a < 3; ++a ) U[a] -= Uold[a];
+    }
+    for( auto& u : U ) u += error;
+    for( SizeT i = 0; i < vertexIds.size(); ++i )
+      std::ranges::copy( U, values.begin() + 3*i );
+  }
+
+  void writeData( std::string_view      /*meshName*/,
+                  std::string_view      /*dataName*/,
+                  std::span<const Int>  /*vertexIds*/,
+                  std::span<const Real> values )
+  {
+    for( const auto v : values ) forceSum_ += v;
+  }
+
+  void advance( Real dt )
+  {
+    // a step within the window
+    windowTime_ += dt;
+    readCheckpoint_ = false;
+    if( windowTime_ < dt_ * (1 - 1e-12) ) return;
+
+    windowTime_     = 0;
+    readCheckpoint_ = ++iteration_ < numIterations_;
+    if( !readCheckpoint_ ) {
+      iteration_ = 0;
+      ++window_;
+    }
+  }
+  //@}
+
+}; // end class ReplayParticipant
@@ -0,0 +1,163 @@
+//------------------------------------------------------------------------------
+// <preamble>
+//
+//  ______
+// |
+// | TailSiT GmbH
+// | Graz, Austria
+//   www.tailsit.com
+//
+// </preamble>
+//------------------------------------------------------------------------------
+
+//! @author    Lars Kielhorn, Thomas Rüberg, Jürgen Zechner
+//! @date      2024
+//! @copyright TailSiT GmbH
+#pragma once
+
+// system ----------------------------------------------------------------------
+#include <algorithm>
+#include <array>
+#include <cmath>
+
+// own -------------------------------------------------------------------------
+#include "types.hpp"
+#include "Settings.hpp"
+
+//------------------------------------------------------------------------------
+namespace ts {
+
+  class RigidBody;
+
+}
+
+//------------------------------------------------------------------------------
+/** Translation of a rigid body, U'' = a(t,U,V), the C++ counterpart of
+ *  ode_solver/ode_solver.py.
+ *
+ *  advance() computes a step from the committed state without changing it,
+ *  so implicit coupling iterations simply repeat it; commit() accepts the
+ *  step. The implicit integrators (implicit Euler, BDF2) solve their stage
+ *  equation by fixed point iteration, which converges for the time steps
+ *  the coupling uses. BDF2 starts with an implicit Euler step; its
+ *  coefficients follow the ratio of the step to the previous one, so
+ *  adaptive steps and substeps of different sizes keep second order.
+ */
+class ts::RigidBody
+{
+public:
+  using Vector     = std::array<Real,3>;
+  using Integrator = RigidBodySettings::Integrator;
+
+  struct State
+  {
+    Real   t = 0;
+    Vector U = { 0, 0, 0 };
+    Vector V = { 0, 0, 0 };
+  };
+
+private:
+  static constexpr SizeT maxFixedPointIterations_ = 100;
+
+  Integrator integrator_;
+  State      state_;
+  State      previous_;    //!< for BDF2
+  bool       hasPrevious_;
+
+public:
+  explicit RigidBody( Integrator integrator )
+    : RigidBody( integrator, State() )
+  {}
+
+  RigidBody( Integrator integrator, const State& initial )
+    : integrator_(integrator)
+    , state_(initial)
+    , previous_()
+    , hasPrevious_(false)
+  {}
+
+  const State& state( ) const { return state_; }
+
+  //! the step of size dt from state(); accel(t,U,V) is the acceleration
+  template< typename ACCEL >
+  State advance( Real dt, ACCEL&& accel ) const;
+
+  void commit( const State& next )
+  {
+    previous_    = state_;
+    hasPrevious_ = true;
+    state_       = next;
+  }
+
+private:
+  static Vector axpy( Vector x, Real alpha, const Vector& y )
+  {
+    for( SizeT a = 0; a < 3; ++a ) x[a] += alpha*y[a];
+    return x;
+  }
+
+}; // end class RigidBody
+
+//============================================================================
+//
+// IMPLEMENTATION
+//
+//============================================================================
+template< typename ACCEL >
+auto ts::RigidBody::advance( Real dt, ACCEL&& accel ) const -> State
+{
+  const State& s = state_;
+  State next;
+  next.t = s.t + dt;
+
+  switch( integrator_ ) {
+  case Integrator::explicitEuler: {
+    const Vector A = accel( s.t, s.U, s.V );
+    next.U = axpy( s.U, dt, s.V );
+    next.V = axpy( s.V, dt, A );
+    break;
+  }
+  case Integrator::rk4: {
+    const Real h = dt/2;
+    const Vector A1 = accel( s.t, s.U, s.V );
+    const Vector V2 = axpy( s.V, h, A1 ), U2 = axpy( s.U, h, s.V );
+    const Vector A2 = accel( s.t + h, U2, V2 );
+    const Vector V3 = axpy( s.V, h, A2 ), U3 = axpy( s.U, h, V2 );
+    const Vector A3 = accel( s.t + h, U3, V3 );
+    const Vector V4 = axpy( s.V, dt, A3 ), U4 = axpy( s.U, dt, V3 );
+    const Vector A4 = accel( next.t, U4, V4 );
+    for( SizeT a = 0; a < 3; ++a ) {
+      next.U[a] = s.U[a] + dt/6 * (s.V[a] + 2*V2[a] + 2*V3[a] + V4[a]);
+      next.V[a] = s.V[a] + dt/6 * (A1[a] + 2*A2[a] + 2*A3[a] + A4[a]);
+    }
+    break;
+  }
+  case Integrator::implicitEuler:
+  case Integrator::bdf2: {
+    // Y1 = c0 Y0 + c1 Y-1 + beta dt Y1'; variable step BDF2 with the step
+    // ratio w = dt / (t0 - t-1), which is 4/3, -1/3, 2/3 for equal steps
+    const bool bdf  = integrator_ == Integrator::bdf2 && hasPrevious_ && s.t > previous_.t;
+    const Real w    = bdf ? dt / (s.t - previous_.t) : 0;
+    const Real c0   = (1 + w)*(1 + w) / (1 + 2*w);
+    const Real c1   = -w*w / (1 + 2*w);
+    const Real beta = (1 + w) / (1 + 2*w);
+    next.U = axpy( s.U, dt, s.V );
+    next.V = s.V;
+    for( SizeT k = 0; k < maxFixedPointIterations_; ++k ) {
+      const Vector A = accel( next.t, next.U, next.V );
+      Real change = 0, scale = 0;
+      for( SizeT a = 0; a < 3; ++a ) {
+        const Real V = c0*s.V[a] + c1*previous_.V[a] + beta*dt*A[a];
+        const Real U = c0*s.U[a] + c1*previous_.U[a] + beta*dt*V;
+        change = std::max( change, std::abs( U - next.U[a] ) );
+        scale  = std::max( scale, std::abs( U ) );
+        next.U[a] = U;
+        next.V[a] = V;
+      }
+      if( change <= 1e-14 * scale ) break;
+    }
+    break;
+  }
+  }
+  return next;
+}
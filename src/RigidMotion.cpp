@@ -0,0 +1,285 @@
+//------------------------------------------------------------------------------
+// <preamble>
+//
+//  ______
+// |
+// | TailSiT GmbH
+// | Graz, Austria
+//   www.tailsit.com
+//
+// </preamble>
+//------------------------------------------------------------------------------
+
+//! @author    Lars Kielhorn, Thomas Rüberg, Jürgen Zechner
+//! @date      2024
+//! @copyright TailSiT GmbH
+
+// system ----------------------------------------------------------------------
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+// own -------------------------------------------------------------------------
+#include "RigidMotion.hpp"
+#include "Parallel.hpp"
+
+//------------------------------------------------------------------------------
+namespace {
+
+  using ts::Real;
+  using ts::SizeT;
+
+  //----------------------------------------------------------------------------
+  /** Eigenvector to the largest eigenvalue of a symmetric 4x4 matrix (Jacobi) */
+  std::array<Real,4> dominantEigenvector( std::array<std::array<Real,4>,4> A )
+  {
+    std::array<std::array<Real,4>,4> V = {{ {1,0,0,0}, {0,1,0,0}, {0,0,1,0}, {0,0,0,1} }};
+
+    for( int sweep = 0; sweep < 50; ++sweep ) {
+      Real off = 0, diag = 0;
+      for( int p = 0; p < 4; ++p ) {
+        diag += A[p][p]*A[p][p];
+        for( int q = p+1; q < 4; ++q ) off += A[p][q]*A[p][q];
+      }
+      if( off <= 1e-30 * diag || off == 0 ) break;
+
+      for( int p = 0; p < 3; ++p )
+        for( int q = p+1; q < 4; ++q ) {
+          if( A[p][q] == 0 ) continue;
+          const Real theta = (A[q][q] - A[p][p]) / (2*A[p][q]);
+          const Real t = std::copysign( 1., theta ) / (std::abs(theta) + std::sqrt(theta*theta + 1));
+          const Real c = 1 / std::sqrt(t*t + 1);
+          const Real s = t*c;
+          for( int k = 0; k < 4; ++k ) {
+            const Real akp = A[k][p], akq = A[k][q];
+            A[k][p] = c*akp - s*akq;
+            A[k][q] = s*akp + c*akq;
+          }
+          for( int k = 0; k < 4; ++k ) {
+            const Real apk = A[p][k], aqk = A[q][k];
+            A[p][k] = c*apk - s*aqk;
+            A[q][k] = s*apk + c*aqk;
+          }
+          for( int k = 0; k < 4; ++k ) {
+            const Real vkp = V[k][p], vkq = V[k][q];
+            V[k][p] = c*vkp - s*vkq;
+            V[k][q] = s*vkp + c*vkq;
+          }
+        }
+    }
+
+    int imax = 0;
+    for( int i = 1; i < 4; ++i )
+      if( A[i][i] > A[imax][imax] ) imax = i;
+    std::array<Real,4> v = { V[0][imax], V[1][imax], V[2][imax], V[3][imax] };
+    if( v[0] < 0 ) for( auto& vi : v ) vi = -vi;
+    return v;
+  }
+
+} // end anonymous namespace
+
+//------------------------------------------------------------------------------
+namespace ts {
+
+  //----------------------------------------------------------------------------
+  std::array<Real,9> RigidMotion::rotationMatrix( ) const
+  {
+    const auto [w,x,y,z] = rotation;
+    return { 1 - 2*(y*y + z*z),     2*(x*y - w*z),     2*(x*z + w*y),
+                 2*(x*y + w*z), 1 - 2*(x*x + z*z),     2*(y*z - w*x),
+                 2*(x*z - w*y),     2*(y*z + w*x), 1 - 2*(x*x + y*y) };
+  }
+
+  //----------------------------------------------------------------------------
+  std::array<Real,3> RigidMotion::displacement( std::span<const Real,3> x ) const
+  {
+    const auto R = rotationMatrix();
+    const Real d[3] = { x[0] - center[0], x[1] - center[1], x[2] - center[2] };
+    std::array<Real,3> u;
+    for( SizeT a = 0; a < 3; ++a )
+      u[a] = R[3*a]*d[0] + R[3*a+1]*d[1] + R[3*a+2]*d[2] - d[a] + translation[a];
+    return u;
+  }
+
+  //----------------------------------------------------------------------------
+  RigidMotionFit::RigidMotionFit( )
+    : center_()
+    , covariance_()
+    , pool_( std::make_shared<parallel::ThreadPool>( 1 ) )
+    , comm_()
+    , numGlobalVertices_(0)
+  {
+    // empty
+  }
+
+  //----------------------------------------------------------------------------
+  RigidMotionFit::RigidMotionFit( std::span<const double> coords,
+                                  SizeT numThreads,
+                                  const Communicator& comm,
+                                  std::shared_ptr<parallel::ThreadPool> pool )
+    : center_()
+    , covariance_()
+    , pool_( pool ? std::move( pool ) : std::make_shared<parallel::ThreadPool>( numThreads ) )
+    , comm_( comm )
+    , numGlobalVertices_( comm.allReduceSum( coords.size() / dim_ ) )
+  {
+    init_( coords );
+  }
+
+  //----------------------------------------------------------------------------
+  RigidMotionFit::RigidMotionFit( std::span<const float> coords,
+                                  SizeT numThreads,
+                                  const Communicator& comm,
+                                  std::shared_ptr<parallel::ThreadPool> pool )
+    : center_()
+    , covariance_()
+    , pool_( pool ? std::move( pool ) : std::make_shared<parallel::ThreadPool>( numThreads ) )
+    , comm_( comm )
+    , numGlobalVertices_( comm.allReduceSum( coords.size() / dim_ ) )
+  {
+    init_( coords );
+  }
+
+  //----------------------------------------------------------------------------
+  template< typename T >
+  void RigidMotionFit::init_( std::span<const T> coords )
+  {
+    const SizeT numVertices = coords.size() / dim_;
+    if( numGlobalVertices_ == 0 ) return;
+
+    for( SizeT i = 0; i < numVertices; ++i )
+      for( SizeT a = 0; a < dim_; ++a ) center_[a] += coords[dim_*i + a];
+    comm_.allReduceSum( center_ );
+    for( auto& c : center_ ) c /= numGlobalVertices_;
+
+    for( SizeT i = 0; i < numVertices; ++i )
+      for( SizeT a = 0; a < dim_; ++a )
+        for( SizeT b = 0; b < dim_; ++b )
+          covariance_[dim_*a + b] += (coords[dim_*i + a] - center_[a]) * (coords[dim_*i + b] - center_[b]);
+    comm_.allReduceSum( covariance_ );
+  }
+
+  //----------------------------------------------------------------------------
+  std::array<Real,12> RigidMotionFit::reduce( std::span<const double> coords,
+                                              std::span<const double> displacements ) const
+  {
+    return reduce_( coords, displacements );
+  }
+
+  //----------------------------------------------------------------------------
+  std::array<Real,12> RigidMotionFit::reduce( std::span<const float> coords,
+                                              std::span<const float> displacements ) const
+  {
+    return reduce_( coords, displacements );
+  }
+
+  //----------------------------------------------------------------------------
+  template< typename T >
+  std::array<Real,12> RigidMotionFit::reduce_( std::span<const T> coords,
+                                               std::span<const T> displacements ) const
+  {
+    if( coords.size() != displacements.size() )
+      throw std::runtime_error( "ts::RigidMotionFit::reduce:Size mismatch" );
+
+    const SizeT numVertices = coords.size() / dim_;
+    const SizeT numChunks =
+      std::min( pool_->size(), std::max<SizeT>( 1, numVertices / minVerticesPerThread_ ) );
+    std::vector<std::array<Real,12>> partials( numChunks );
+
+    const T*    X = coords.data();
+    const T*    U = displacements.data();
+    const auto  c = center_;
+    pool_->forEachChunk( numVertices, numChunks,
+                         [&]( SizeT chunk, SizeT begin, SizeT end ) {
+      // independent accumulators per lane break the dependency chains; float
+      // fields are widened as they are read, the sums are always Real
+      static constexpr SizeT lanes = 4;
+      Real acc[12][lanes] = {};
+      SizeT i = begin;
+      for( ; i + lanes <= end; i += lanes )
+        for( SizeT l = 0; l < lanes; ++l ) {
+          const T*   x = X + dim_*(i+l);
+          const T*   u = U + dim_*(i+l);
+          const Real d0 = x[0] - c[0], d1 = x[1] - c[1], d2 = x[2] - c[2];
+          acc[ 0][l] += u[0];    acc[ 1][l] += u[1];    acc[ 2][l] += u[2];
+          acc[ 3][l] += d0*u[0]; acc[ 4][l] += d0*u[1]; acc[ 5][l] += d0*u[2];
+          acc[ 6][l] += d1*u[0]; acc[ 7][l] += d1*u[1]; acc[ 8][l] += d1*u[2];
+          acc[ 9][l] += d2*u[0]; acc[10][l] += d2*u[1]; acc[11][l] += d2*u[2];
+        }
+      for( ; i < end; ++i ) {
+        const T*   x = X + dim_*i;
+        const T*   u = U + dim_*i;
+        const Real d[3] = { x[0] - c[0], x[1] - c[1], x[2] - c[2] };
+        for( SizeT a = 0; a < dim_; ++a ) {
+          acc[a][0] += u[a];
+          for( SizeT b = 0; b < dim_; ++b ) acc[3 + dim_*a + b][0] += d[a]*u[b];
+        }
+      }
+      auto& sums = partials[chunk];
+      for( SizeT k = 0; k < 12; ++k ) {
+        sums[k] = 0;
+        for( SizeT l = 0; l < lanes; ++l ) sums[k] += acc[k][l];
+      }
+    } );
+
+    std::array<Real,12> sums = {};
+    for( const auto& p : partials )
+      for( SizeT k = 0; k < 12; ++k ) sums[k] += p[k];
+    return sums;
+  }
+
+  //----------------------------------------------------------------------------
+  RigidMotion RigidMotionFit::solve( const std::array<Real,12>& sums,
+                                     SizeT numVertices ) const
+  {
+    RigidMotion motion;
+    motion.center = center_;
+    if( numVertices == 0 ) return motion;
+
+    for( SizeT a = 0; a < dim_; ++a ) motion.translation[a] = sums[a] / numVertices;
+
+    // cross covariance of reference and deformed cloud, sum (x-c)(y-c_y)^T
+    // with y = x + u; note that sum (x-c) = 0
+    std::array<Real,9> S;
+    for( SizeT k = 0; k < 9; ++k ) S[k] = covariance_[k] + sums[3 + k];
+    const Real Sxx = S[0], Sxy = S[1], Sxz = S[2];
+    const Real Syx = S[3], Syy = S[4], Syz = S[5];
+    const Real Szx = S[6], Szy = S[7], Szz = S[8];
+
+    const std::array<std::array<Real,4>,4> N = {{
+      { Sxx + Syy + Szz, Syz - Szy,        Szx - Sxz,        Sxy - Syx       },
+      { Syz - Szy,       Sxx - Syy - Szz,  Sxy + Syx,        Szx + Sxz       },
+      { Szx - Sxz,       Sxy + Syx,       -Sxx + Syy - Szz,  Syz + Szy       },
+      { Sxy - Syx,       Szx + Sxz,        Syz + Szy,       -Sxx - Syy + Szz }
+    }};
+    motion.rotation = dominantEigenvector( N );
+    return motion;
+  }
+
+  //----------------------------------------------------------------------------
+  RigidMotion RigidMotionFit::operator()( std::span<const double> coords,
+                                          std::span<const double> displacements ) const
+  {
+    return fit_( coords, displacements );
+  }
+
+  //----------------------------------------------------------------------------
+  RigidMotion RigidMotionFit::operator()( std::span<const float> coords,
+                                          std::span<const float> displacements ) const
+  {
+    return fit_( coords, displacements );
+  }
+
+  //----------------------------------------------------------------------------
+  template< typename T >
+  RigidMotion RigidMotionFit::fit_( std::span<const T> coords,
+                                    std::span<const T> displacements ) const
+  {
+    auto sums = reduce_( coords, displacements );
+    comm_.allReduceSum( sums );
+    return solve( sums, comm_.size() == 1 ? coords.size() / dim_ : numGlobalVertices_ );
+  }
+
+} // end namespace ts
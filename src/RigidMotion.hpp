@@ -0,0 +1,127 @@
+//------------------------------------------------------------------------------
+// <preamble>
+//
+//  ______
+// |
+// | TailSiT GmbH
+// | Graz, Austria
+//   www.tailsit.com
+//
+// </preamble>
+//------------------------------------------------------------------------------
+
+//! @author    Lars Kielhorn, Thomas Rüberg, Jürgen Zechner
+//! @date      2024
+//! @copyright TailSiT GmbH
+#pragma once
+
+// system ----------------------------------------------------------------------
+#include <array>
+#include <memory>
+#include <span>
+
+// own -------------------------------------------------------------------------
+#include "types.hpp"
+#include "Communicator.hpp"
+#include "Parallel.hpp"
+
+//------------------------------------------------------------------------------
+namespace ts {
+
+  struct RigidMotion;
+  class  RigidMotionFit;
+
+}
+
+//------------------------------------------------------------------------------
+/** Rigid body motion x -> R (x - center) + center + translation */
+struct ts::RigidMotion
+{
+  std::array<Real,3> translation = {0,0,0};
+  std::array<Real,4> rotation    = {1,0,0,0}; //!< unit quaternion (w,x,y,z)
+  std::array<Real,3> center      = {0,0,0};   //!< centroid of the reference cloud
+
+  //! row-major rotation matrix
+  std::array<Real,9> rotationMatrix( ) const;
+
+  //! displacement of the (reference) point x
+  std::array<Real,3> displacement( std::span<const Real,3> x ) const;
+};
+
+//------------------------------------------------------------------------------
+/** Least squares fit of a rigid motion to a displacement field.
+ *
+ *  Minimizes sum_i |R (x_i - c) + c + t - (x_i + u_i)|^2 (Kabsch problem),
+ *  solved with Horn's quaternion formulation. The centroid and covariance of
+ *  the reference cloud are precomputed, so each fit is a single streaming
+ *  reduction of 12 sums over the displacements followed by a 4x4 symmetric
+ *  eigenproblem. The reduction runs in lane-blocked accumulators that the
+ *  compiler vectorizes and is split across threads for large clouds; the
+ *  threads come from a pool kept for the fit's lifetime, which a solver can
+ *  share with its other per-iteration loops.
+ *
+ *  In a partitioned run every rank holds a part of the cloud; the centroid,
+ *  covariance and fit sums are then summed over the communicator, so all
+ *  ranks obtain the motion of the whole cloud.
+ */
+class ts::RigidMotionFit
+{
+  static constexpr SizeT dim_ = 3;
+  static constexpr SizeT minVerticesPerThread_ = SizeT{1} << 16;
+
+private:
+  std::array<Real,dim_>      center_;
+  std::array<Real,dim_*dim_> covariance_; //!< sum (x-c)(x-c)^T
+  std::shared_ptr<parallel::ThreadPool> pool_;
+  Communicator               comm_;
+  SizeT                      numGlobalVertices_;
+
+public:
+  RigidMotionFit( );
+
+  /** The fields may be stored in either precision (see Storage); all sums
+   *  are taken in Real.
+   *  @param numThreads zero means all hardware threads
+   *  @param pool       use these workers instead of an own pool of
+   *                    numThreads; must not be used concurrently elsewhere */
+  explicit RigidMotionFit( std::span<const double> coords,
+                           SizeT numThreads = 0,
+                           const Communicator& comm = Communicator(),
+                           std::shared_ptr<parallel::ThreadPool> pool = nullptr );
+
+  explicit RigidMotionFit( std::span<const float> coords,
+                           SizeT numThreads = 0,
+                           const Communicator& comm = Communicator(),
+                           std::shared_ptr<parallel::ThreadPool> pool = nullptr );
+
+  RigidMotion operator()( std::span<const double> coords,
+                          std::span<const double> displacements ) const;
+
+  RigidMotion operator()( std::span<const float> coords,
+                          std::span<const float> displacements ) const;
+
+  /** @name building blocks, exposed for benchmarking */
+  //@{
+  //! local sum u (3 values) followed by sum (x-c) u^T (9 values, row-major)
+  std::array<Real,12> reduce( std::span<const double> coords,
+                              std::span<const double> displacements ) const;
+
+  std::array<Real,12> reduce( std::span<const float> coords,
+                              std::span<const float> displacements ) const;
+
+  RigidMotion solve( const std::array<Real,12>& sums, SizeT numVertices ) const;
+  //@}
+
+private:
+  template< typename T >
+  void init_( std::span<const T> coords );
+
+  template< typename T >
+  std::array<Real,12> reduce_( std::span<const T> coords,
+                               std::span<const T> displacements ) const;
+
+  template< typename T >
+  RigidMotion fit_( std::span<const T> coords,
+                    std::span<const T> displacements ) const;
+
+}; // end class RigidMotionFit
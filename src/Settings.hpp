@@ -16,7 +16,9 @@
 #pragma once
 
 // system ----------------------------------------------------------------------
+#include <array>
 #include <string>
+#include <vector>
 
 // own -------------------------------------------------------------------------
 #include "types.hpp"
@@ -25,15 +27,211 @@
 namespace ts
 {
 
+  //----------------------------------------------------------------------------
+  struct ForceTableSettings
+  {
+    enum class Grid { axial,      //!< 1D in U2
+                      cartesian   //!< 3D in U0,U1,U2
+    };
+    enum class Interpolation { linear, cubic };
+
+    std::string   file;           //!< U0,U1,U2,F0,F1,F2 rows, as in forces.csv
+    Grid          grid          = Grid::axial;
+    Interpolation interpolation = Interpolation::linear;
+    SizeT         resolution    = 0;    //!< grid nodes per axis, zero: per grid default
+  };
+
+  //----------------------------------------------------------------------------
+  /** m g sum_i w_i / (1 + exp(o_i - k s)), s = |U[axis]| */
+  struct SigmoidForceSettings
+  {
+    using Term = std::array<Real,2>; //!< weight w_i, offset o_i
+
+    Real              mass    = 6e-3;
+    Real              gravity = 9.81;
+    Real              slope   = 1000;  //!< k
+    std::vector<Term> terms   = { {2,20}, {-1,25}, {-1,85} };
+    SizeT             axis    = 2;
+  };
+
+  //----------------------------------------------------------------------------
+  /** sum_i c_i s^i, s = |U[axis]| */
+  struct PolynomialForceSettings
+  {
+    std::vector<Real> coefficients = { 0 };
+    SizeT             axis         = 2;
+  };
+
+  //----------------------------------------------------------------------------
+  struct ForceModelSettings
+  {
+    std::string             type = "sigmoid"; //!< sigmoid, polynomial or tabulated
+    SigmoidForceSettings    sigmoid;
+    PolynomialForceSettings polynomial;
+    ForceTableSettings      table;
+  };
+
+  //----------------------------------------------------------------------------
+  /** Memo of the force model over the rigid motion, for expensive models;
+   *  the model must not depend on time */
+  struct ForceCacheSettings
+  {
+    bool  enabled          = false;
+    Real  tolerance        = 0;    //!< translation quantum, exact keys if zero
+    Real  angularTolerance = 0;    //!< rotation quantum [rad], exact keys if zero
+    SizeT capacity         = 1024; //!< entries, direct mapped
+  };
+
+  //----------------------------------------------------------------------------
+  /** Point cloud thinned to one vertex per occupied voxel, at the centroid of
+   *  its points; voxelSize wins over targetCount */
+  struct DecimationSettings
+  {
+    bool  enabled     = false;
+    Real  voxelSize   = 0; //!< edge length of the voxels
+    SizeT targetCount = 0; //!< else the voxels giving at most this many vertices
+  };
+
+  //----------------------------------------------------------------------------
+  struct ProfilingSettings
+  {
+    bool        enabled        = false;
+    std::string traceFile;                //!< Chrome trace JSON, none if empty
+    SizeT       maxTraceEvents = 1000000; //!< later events are only counted
+  };
+
+  //----------------------------------------------------------------------------
+  /** Live counters in shared memory, for ts_telemetry */
+  struct TelemetrySettings
+  {
+    bool        enabled = false;
+    std::string name;    //!< shared memory object, the solverName if empty
+  };
+
+  //----------------------------------------------------------------------------
+  /** Step size control of the solver; preCICE cuts the proposed step at the
+   *  end of the coupling window, so steps below the window size subcycle */
+  struct TimeStepSettings
+  {
+    bool adaptive   = false; //!< fixed steps of Settings::dt if false
+    Real dtMin      = 1e-5;
+    Real dtMax      = 5e-2;
+    Real tolerance  = 1e-2;  //!< force change per step, relative to forceScale
+    Real forceScale = 0;     //!< or the largest force seen, if larger
+    Real safety     = 0.9;
+    Real maxGrowth  = 2;     //!< largest ratio of two proposals in a row
+  };
+
+  //----------------------------------------------------------------------------
+  /** Several force evaluations per coupling step, at the displacements read
+   *  at intermediate times of the window; the time average of the forces
+   *  is written once per step */
+  struct SubcyclingSettings
+  {
+    bool  enabled     = false;
+    SizeT numSubsteps = 4; //!< of equal size, unless the time step is adaptive
+  };
+
+  //----------------------------------------------------------------------------
+  /** One of several meshes coupled by the same adapter; entries not given
+   *  in the YAML are taken from the enclosing settings */
+  struct MeshSettings
+  {
+    std::string        meshName;
+    std::string        pointCloud;  //!< coordinate file, the command line one if empty
+    std::string        pointCloudRegion; //!< of a mesh file, the settings' one if empty
+    std::string        inField;
+    std::string        outField;
+    std::string        samplesFile; //!< '<samplesFile stem>_<meshName>' if empty
+    ForceModelSettings forceModel;
+  };
+
   //----------------------------------------------------------------------------
   struct Settings
   {
+    //! the total force spread evenly, or the model evaluated at every vertex
+    enum class ForceField { uniform, perVertex };
+
+    //! vertex order inside the solver, along a space-filling curve if not input
+    enum class VertexOrdering { input, morton, hilbert };
+
     std::string solverName = "ts_dummy_adapter";
     std::string meshName   = "dummy_magnet";
     std::string inField    = "Displacements";
     std::string outField   = "Forces";
     Real        dt         = 5e-3;
     Real        endt       = 3e-1;
+
+    SizeT       numCheckpoints = 2; //!< windows kept for reloadOldState
+    SizeT       numThreads     = 0; //!< for the rigid motion fit, zero means all
+    std::string    pointCloudRegion; //!< NSET, ELSET or region of a mesh file, all nodes if empty
+    VertexOrdering vertexOrdering = VertexOrdering::input; //!< set/get keep the input order
+    DecimationSettings decimation; //!< coupled vertices, before the ordering
+
+    // step size, dt is the first and with fixed steps every step
+    TimeStepSettings   timeStep;
+    SubcyclingSettings subcycling;
+
+    // force sampling
+    std::string samplesFile          = "forces.csv";
+    bool        convergedSamplesOnly = false; //!< drop samples of rejected iterations
+    bool        binarySamples        = false; //!< columnar copy next to samplesFile
+
+    // force model
+    ForceModelSettings forceModel;
+    ForceField         forceField = ForceField::uniform;
+    ForceCacheSettings forceCache;
+
+    // phase timers
+    ProfilingSettings profiling;
+    TelemetrySettings telemetry;
+
+    // coupling traffic, for replay without preCICE
+    std::string recordFile; //!< none if empty
+
+    // several meshes in one adapter, instead of meshName, inField, ...
+    std::vector<MeshSettings> meshes;
+  };
+
+  //----------------------------------------------------------------------------
+  /** Built-in rigid body partner, m U'' = m g + F, coupled in process */
+  struct RigidBodySettings
+  {
+    enum class Integrator { explicitEuler, implicitEuler, rk4, bdf2 };
+    enum class Scheme { serialExplicit, parallelImplicit };
+
+    Real               mass          = 6e-3;
+    std::array<Real,3> gravity       = { 0, 0, -9.81 };
+    Integrator         integrator    = Integrator::implicitEuler;
+    Scheme             scheme        = Scheme::parallelImplicit;
+    SizeT              maxIterations = 100;   //!< per window, parallelImplicit
+    Real               tolerance     = 1e-3;  //!< relative displacement change
+    Real               relaxation    = 0.1;   //!< initial Aitken relaxation
+    Real               windowSize    = 0;     //!< coupling window, Settings::dt if zero
+    std::string        output        = "trajectory.csv";
+  };
+
+  //----------------------------------------------------------------------------
+  /** Prescribed rigid translation U(t) replayed instead of a coupling partner */
+  struct TrajectorySettings
+  {
+    std::string type    = "freeFall"; //!< freeFall or file
+    std::string file;                 //!< t,U0,U1,U2 rows
+    Real        gravity = 9.81;       //!< freeFall: U[axis] = -g t^2 / 2
+    SizeT       axis    = 2;
+  };
+
+  //----------------------------------------------------------------------------
+  /** Offline runs over all combinations of the listed values; an empty list
+   *  keeps the value of the base settings */
+  struct SweepSettings
+  {
+    std::string                     output     = "sweep/forces_{}.csv"; //!< {} is the run
+    SizeT                           numThreads = 0; //!< concurrent runs, zero means all
+    TrajectorySettings              trajectory;
+    std::vector<Real>               dt;
+    std::vector<Real>               endt;
+    std::vector<ForceModelSettings> forceModels;
   };
   
 }
@@ -0,0 +1,115 @@
+//------------------------------------------------------------------------------
+// <preamble>
+//
+//  ______
+// |
+// | TailSiT GmbH
+// | Graz, Austria
+//   www.tailsit.com
+//
+// </preamble>
+//------------------------------------------------------------------------------
+
+//! @author    Lars Kielhorn, Thomas Rüberg, Jürgen Zechner
+//! @date      2024
+//! @copyright TailSiT GmbH
+#pragma once
+
+// system ----------------------------------------------------------------------
+#include <algorithm>
+#include <cmath>
+#include <span>
+#include <string_view>
+#include <vector>
+
+// own -------------------------------------------------------------------------
+#include "types.hpp"
+#include "Settings.hpp"
+#include "RigidMotion.hpp"
+#include "Simd.hpp"
+
+//------------------------------------------------------------------------------
+namespace ts {
+
+  class SigmoidForce;
+
+}
+
+//------------------------------------------------------------------------------
+/** Sum of logistic sigmoids in the axial displacement s = |U[axis]|,
+ *
+ *    F[axis] = m g sum_i w_i / (1 + exp(o_i - k s)).
+ *
+ *  The defaults reproduce the falling magnet of ode_solver/ode_solver.py.
+ */
+class ts::SigmoidForce
+{
+public:
+  using Settings = SigmoidForceSettings;
+  static constexpr std::string_view name = "sigmoid";
+
+private:
+  Real                        scale_; //!< m g
+  Real                        slope_;
+  std::vector<Settings::Term> terms_;
+  SizeT                       axis_;
+
+public:
+  explicit SigmoidForce( const Settings& settings = {} )
+    : scale_( settings.mass * settings.gravity )
+    , slope_( settings.slope )
+    , terms_( settings.terms )
+    , axis_( settings.axis )
+  {}
+
+  SizeT axis( ) const { return axis_; }
+
+  Real eval( Real s ) const
+  {
+    Real sum = 0;
+    for( const auto& [w,o] : terms_ )
+      sum += w / (1. + std::exp(o - slope_*s));
+    return scale_*sum;
+  }
+
+  //! F[j] = eval(s[j]), simd::Pack::size values at a time
+  void evalAxial( std::span<const Real> s, std::span<Real> F ) const
+  {
+    using simd::Pack;
+    if constexpr( Pack::size == 1 ) {
+      std::ranges::transform( s, F.begin(), [this]( Real x ) { return eval( x ); } );
+      return;
+    }
+    const Pack one   = Pack::broadcast( 1 );
+    const Pack slope = Pack::broadcast( -slope_ );
+    const Pack scale = Pack::broadcast( scale_ );
+    const auto kernel = [&]( const Real* in, Real* out ) {
+      const Pack x = Pack::load( in );
+      Pack sum = Pack::broadcast( 0 );
+      for( const auto& [w,o] : terms_ )
+        sum = sum + Pack::broadcast( w ) / (one + simd::exp( fma( slope, x, Pack::broadcast( o ) ) ));
+      (scale * sum).store( out );
+    };
+
+    const SizeT n = s.size();
+    SizeT j = 0;
+    for( ; j + Pack::size <= n; j += Pack::size )
+      kernel( s.data() + j, F.data() + j );
+    if( j < n ) {
+      // the remainder, padded to a full pack
+      Real in[Pack::size] = {}, out[Pack::size];
+      std::copy( s.begin() + j, s.end(), in );
+      kernel( in, out );
+      std::copy( out, out + (n - j), F.begin() + j );
+    }
+  }
+
+  void operator()( Real               /*time*/,
+                   const RigidMotion& motion,
+                   std::span<Real>    Feval ) const
+  {
+    std::ranges::fill( Feval, 0 );
+    Feval[axis_] = this->eval( std::abs(motion.translation[axis_]) );
+  }
+
+}; // end class SigmoidForce
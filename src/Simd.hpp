@@ -0,0 +1,165 @@
+//------------------------------------------------------------------------------
+// <preamble>
+//
+//  ______
+// |
+// | TailSiT GmbH
+// | Graz, Austria
+//   www.tailsit.com
+//
+// </preamble>
+//------------------------------------------------------------------------------
+
+//! @author    Lars Kielhorn, Thomas Rüberg, Jürgen Zechner
+//! @date      2024
+//! @copyright TailSiT GmbH
+#pragma once
+
+// system ----------------------------------------------------------------------
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+
+#if defined(__AVX512F__) || defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+// own -------------------------------------------------------------------------
+#include "types.hpp"
+
+//------------------------------------------------------------------------------
+/** Packs of doubles in the widest vector registers the build targets:
+ *  AVX-512 (8 lanes), AVX2 with FMA (4 lanes) or a scalar fallback. The
+ *  instruction set is chosen at compile time, see TS_NATIVE_ARCH.
+ */
+namespace ts {
+  namespace simd {
+
+#if defined(__AVX512F__)
+    //--------------------------------------------------------------------------
+    struct Pack
+    {
+      static constexpr SizeT size = 8;
+      static constexpr const char* isa = "AVX-512";
+      __m512d v;
+
+      static Pack load( const Real* p ) { return { _mm512_loadu_pd( p ) }; }
+      static Pack broadcast( Real x ) { return { _mm512_set1_pd( x ) }; }
+      void store( Real* p ) const { _mm512_storeu_pd( p, v ); }
+
+      friend Pack operator+( Pack a, Pack b ) { return { _mm512_add_pd( a.v, b.v ) }; }
+      friend Pack operator*( Pack a, Pack b ) { return { _mm512_mul_pd( a.v, b.v ) }; }
+      friend Pack operator/( Pack a, Pack b ) { return { _mm512_div_pd( a.v, b.v ) }; }
+      //! a*b + c
+      friend Pack fma( Pack a, Pack b, Pack c ) { return { _mm512_fmadd_pd( a.v, b.v, c.v ) }; }
+      friend Pack clamp( Pack a, Real lo, Real hi )
+      {
+        return { _mm512_min_pd( _mm512_max_pd( a.v, _mm512_set1_pd( lo ) ), _mm512_set1_pd( hi ) ) };
+      }
+      friend Pack round( Pack a )
+      {
+        return { _mm512_roundscale_pd( a.v, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC ) };
+      }
+      //! 2^n for integral n in [-1022,1023]
+      friend Pack pow2( Pack n )
+      {
+        const __m512d magic = _mm512_set1_pd( 0x1.8p52 );
+        __m512i e = _mm512_sub_epi64( _mm512_castpd_si512( _mm512_add_pd( n.v, magic ) ),
+                                      _mm512_castpd_si512( magic ) );
+        e = _mm512_slli_epi64( _mm512_add_epi64( e, _mm512_set1_epi64( 1023 ) ), 52 );
+        return { _mm512_castsi512_pd( e ) };
+      }
+    };
+
+#elif defined(__AVX2__) && defined(__FMA__)
+    //--------------------------------------------------------------------------
+    struct Pack
+    {
+      static constexpr SizeT size = 4;
+      static constexpr const char* isa = "AVX2";
+      __m256d v;
+
+      static Pack load( const Real* p ) { return { _mm256_loadu_pd( p ) }; }
+      static Pack broadcast( Real x ) { return { _mm256_set1_pd( x ) }; }
+      void store( Real* p ) const { _mm256_storeu_pd( p, v ); }
+
+      friend Pack operator+( Pack a, Pack b ) { return { _mm256_add_pd( a.v, b.v ) }; }
+      friend Pack operator*( Pack a, Pack b ) { return { _mm256_mul_pd( a.v, b.v ) }; }
+      friend Pack operator/( Pack a, Pack b ) { return { _mm256_div_pd( a.v, b.v ) }; }
+      //! a*b + c
+      friend Pack fma( Pack a, Pack b, Pack c ) { return { _mm256_fmadd_pd( a.v, b.v, c.v ) }; }
+      friend Pack clamp( Pack a, Real lo, Real hi )
+      {
+        return { _mm256_min_pd( _mm256_max_pd( a.v, _mm256_set1_pd( lo ) ), _mm256_set1_pd( hi ) ) };
+      }
+      friend Pack round( Pack a )
+      {
+        return { _mm256_round_pd( a.v, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC ) };
+      }
+      //! 2^n for integral n in [-1022,1023]
+      friend Pack pow2( Pack n )
+      {
+        const __m256d magic = _mm256_set1_pd( 0x1.8p52 );
+        __m256i e = _mm256_sub_epi64( _mm256_castpd_si256( _mm256_add_pd( n.v, magic ) ),
+                                      _mm256_castpd_si256( magic ) );
+        e = _mm256_slli_epi64( _mm256_add_epi64( e, _mm256_set1_epi64x( 1023 ) ), 52 );
+        return { _mm256_castsi256_pd( e ) };
+      }
+    };
+
+#else
+    //--------------------------------------------------------------------------
+    struct Pack
+    {
+      static constexpr SizeT size = 1;
+      static constexpr const char* isa = "scalar";
+      Real v;
+
+      static Pack load( const Real* p ) { return { *p }; }
+      static Pack broadcast( Real x ) { return { x }; }
+      void store( Real* p ) const { *p = v; }
+
+      friend Pack operator+( Pack a, Pack b ) { return { a.v + b.v }; }
+      friend Pack operator*( Pack a, Pack b ) { return { a.v * b.v }; }
+      friend Pack operator/( Pack a, Pack b ) { return { a.v / b.v }; }
+      //! a*b + c
+      friend Pack fma( Pack a, Pack b, Pack c ) { return { std::fma( a.v, b.v, c.v ) }; }
+      friend Pack clamp( Pack a, Real lo, Real hi ) { return { std::clamp( a.v, lo, hi ) }; }
+      friend Pack round( Pack a ) { return { std::nearbyint( a.v ) }; }
+      //! 2^n for integral n in [-1022,1023]
+      friend Pack pow2( Pack n ) { return { std::ldexp( 1., static_cast<int>( n.v ) ) }; }
+    };
+#endif
+
+    //--------------------------------------------------------------------------
+    /** e^x lane by lane, within a few ulp: x = n ln2 + r with |r| <= ln2/2,
+     *  e^r by its Taylor polynomial of degree 12, times 2^n. Arguments are
+     *  clamped to [-708,709], so there are neither infinities nor
+     *  denormals. The scalar fallback calls std::exp. */
+#if defined(__AVX512F__) || (defined(__AVX2__) && defined(__FMA__))
+    inline Pack exp( Pack x )
+    {
+      static constexpr Real log2e = 1.4426950408889634;
+      static constexpr Real ln2Hi = 6.93147180369123816490e-01;
+      static constexpr Real ln2Lo = 1.90821492927058770002e-10;
+      static constexpr Real c[13] = { 1., 1., 1./2, 1./6, 1./24, 1./120, 1./720,
+                                      1./5040, 1./40320, 1./362880, 1./3628800,
+                                      1./39916800, 1./479001600 };
+      x = clamp( x, -708., 709. );
+      const Pack n = round( x * Pack::broadcast( log2e ) );
+      Pack r = fma( n, Pack::broadcast( -ln2Hi ), x );
+      r = fma( n, Pack::broadcast( -ln2Lo ), r );
+      Pack p = Pack::broadcast( c[12] );
+      for( int k = 11; k >= 0; --k )
+        p = fma( p, r, Pack::broadcast( c[k] ) );
+      return p * pow2( n );
+    }
+#else
+    inline Pack exp( Pack x )
+    {
+      return { std::exp( std::clamp( x.v, -708., 709. ) ) };
+    }
+#endif
+
+  } // end namespace simd
+} // end namespace ts
@@ -0,0 +1,117 @@
+//------------------------------------------------------------------------------
+// <preamble>
+//
+//  ______
+// |
+// | TailSiT GmbH
+// | Graz, Austria
+//   www.tailsit.com
+//
+// </preamble>
+//------------------------------------------------------------------------------
+
+//! @author    Lars Kielhorn, Thomas Rüberg, Jürgen Zechner
+//! @date      2024
+//! @copyright TailSiT GmbH
+#pragma once
+
+// system ----------------------------------------------------------------------
+#include <algorithm>
+#include <atomic>
+#include <limits>
+#include <memory>
+#include <span>
+
+// own -------------------------------------------------------------------------
+#include "types.hpp"
+
+//------------------------------------------------------------------------------
+namespace ts {
+
+  template< typename T, SizeT CAPACITY >
+  class SpscRing;
+
+}
+
+//------------------------------------------------------------------------------
+/** Bounded lock-free single-producer/single-consumer ring buffer.
+ *
+ *  push() blocks (std::atomic::wait) while the ring is full, so memory stays
+ *  bounded by CAPACITY elements. The consumer blocks in waitForData() until
+ *  elements arrive or the producer has called close().
+ */
+template< typename T, ts::SizeT CAPACITY >
+class ts::SpscRing
+{
+  static_assert( CAPACITY > 0 && (CAPACITY & (CAPACITY - 1)) == 0,
+                 "ts::SpscRing:CAPACITY must be a power of two" );
+
+  static constexpr SizeT mask_      = CAPACITY - 1;
+  // set in head_ by close(), which also wakes a waiting consumer
+  static constexpr SizeT closedBit_ = SizeT{1} << (std::numeric_limits<SizeT>::digits - 1);
+
+private:
+  alignas(64) std::atomic<SizeT> head_; //!< written by the producer
+  alignas(64) std::atomic<SizeT> tail_; //!< written by the consumer
+  std::unique_ptr<T[]>           buffer_;
+
+public:
+  SpscRing( )
+    : head_(0), tail_(0), buffer_( std::make_unique<T[]>( CAPACITY ) )
+  {}
+
+  static constexpr SizeT capacity( ) { return CAPACITY; }
+
+  /** @name producer side */
+  //@{
+  void push( const T& value )
+  {
+    const SizeT head = head_.load( std::memory_order_relaxed ) & ~closedBit_;
+    SizeT tail = tail_.load( std::memory_order_acquire );
+    while( head - tail == CAPACITY ) {
+      tail_.wait( tail, std::memory_order_acquire );
+      tail = tail_.load( std::memory_order_acquire );
+    }
+    buffer_[head & mask_] = value;
+    head_.store( head + 1, std::memory_order_release );
+    head_.notify_one();
+  }
+
+  void close( )
+  {
+    head_.fetch_or( closedBit_, std::memory_order_release );
+    head_.notify_one();
+  }
+  //@}
+
+  /** @name consumer side */
+  //@{
+  //! pops up to out.size() elements, returns their number
+  SizeT pop( std::span<T> out )
+  {
+    const SizeT tail = tail_.load( std::memory_order_relaxed );
+    const SizeT head = head_.load( std::memory_order_acquire ) & ~closedBit_;
+    const SizeT n = std::min<SizeT>( head - tail, out.size() );
+    for( SizeT i = 0; i < n; ++i )
+      out[i] = buffer_[(tail + i) & mask_];
+    if( n > 0 ) {
+      tail_.store( tail + n, std::memory_order_release );
+      tail_.notify_one();
+    }
+    return n;
+  }
+
+  //! blocks while empty; returns false once empty and closed
+  bool waitForData( )
+  {
+    const SizeT tail = tail_.load( std::memory_order_relaxed );
+    SizeT head = head_.load( std::memory_order_acquire );
+    while( head == tail ) {
+      head_.wait( head, std::memory_order_acquire );
+      head = head_.load( std::memory_order_acquire );
+    }
+    return (head & ~closedBit_) != tail;
+  }
+  //@}
+
+}; // end class SpscRing
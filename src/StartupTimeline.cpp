@@ -0,0 +1,96 @@
+//------------------------------------------------------------------------------
+// <preamble>
+//
+//  ______
+// |
+// | TailSiT GmbH
+// | Graz, Austria
+//   www.tailsit.com
+//
+// </preamble>
+//------------------------------------------------------------------------------
+
+//! @author    Lars Kielhorn, Thomas Rüberg, Jürgen Zechner
+//! @date      2024
+//! @copyright TailSiT GmbH
+
+// system ----------------------------------------------------------------------
+#include <algorithm>
+#include <format>
+
+// own -------------------------------------------------------------------------
+#include "StartupTimeline.hpp"
+
+//------------------------------------------------------------------------------
+namespace ts {
+
+  //----------------------------------------------------------------------------
+  StartupTimeline::StartupTimeline( )
+    : origin_( Clock::now() )
+    , mainThread_( std::this_thread::get_id() )
+    , intervals_()
+    , mutex_()
+  {}
+
+  //----------------------------------------------------------------------------
+  void StartupTimeline::record_( std::string name, Clock::time_point begin, Clock::time_point end )
+  {
+    const bool mainThread = std::this_thread::get_id() == mainThread_;
+    const std::scoped_lock lock( mutex_ );
+    intervals_.push_back( { std::move( name ), begin, end, mainThread } );
+  }
+
+  //----------------------------------------------------------------------------
+  Real StartupTimeline::wall( ) const
+  {
+    const std::scoped_lock lock( mutex_ );
+    std::vector<Interval_> sorted = intervals_;
+    std::ranges::sort( sorted, {}, &Interval_::begin );
+
+    // length of the union of all intervals
+    Clock::duration covered{};
+    Clock::time_point reach{};
+    for( SizeT i = 0; i < sorted.size(); ++i ) {
+      const auto begin = i ? std::max( sorted[i].begin, reach ) : sorted[i].begin;
+      if( sorted[i].end > begin ) covered += sorted[i].end - begin;
+      reach = i ? std::max( reach, sorted[i].end ) : sorted[i].end;
+    }
+    return std::chrono::duration<Real>( covered ).count();
+  }
+
+  //----------------------------------------------------------------------------
+  Real StartupTimeline::overlapped( ) const
+  {
+    Real total = 0;
+    {
+      const std::scoped_lock lock( mutex_ );
+      for( const auto& interval : intervals_ )
+        total += std::chrono::duration<Real>( interval.end - interval.begin ).count();
+    }
+    return total - wall();
+  }
+
+  //----------------------------------------------------------------------------
+  std::ostream& StartupTimeline::writeSummary( std::ostream& out ) const
+  {
+    const Real wallTime = wall(), overlap = overlapped();
+    out << std::format( "# STARTUP: {:.4e} s, {:.4e} s of stages overlapped ({:.1f} %)\n",
+                        wallTime, overlap,
+                        wallTime + overlap > 0 ? 100 * overlap / ( wallTime + overlap ) : Real(0) )
+        << std::format( "# {:<36s} {:>8s} {:>12s} {:>12s} {:>12s}\n",
+                        "stage", "thread", "begin [s]", "end [s]", "time [s]" );
+    const std::scoped_lock lock( mutex_ );
+    std::vector<Interval_> sorted = intervals_;
+    std::ranges::sort( sorted, {}, &Interval_::begin );
+    const auto seconds = [this]( Clock::time_point t ) {
+      return std::chrono::duration<Real>( t - origin_ ).count();
+    };
+    for( const auto& interval : sorted )
+      out << std::format( "  {:<36s} {:>8s} {:>12.4e} {:>12.4e} {:>12.4e}\n",
+                          interval.name, interval.mainThread ? "main" : "worker",
+                          seconds( interval.begin ), seconds( interval.end ),
+                          seconds( interval.end ) - seconds( interval.begin ) );
+    return out;
+  }
+
+} // end namespace ts
@@ -0,0 +1,99 @@
+//------------------------------------------------------------------------------
+// <preamble>
+//
+//  ______
+// |
+// | TailSiT GmbH
+// | Graz, Austria
+//   www.tailsit.com
+//
+// </preamble>
+//------------------------------------------------------------------------------
+
+//! @author    Lars Kielhorn, Thomas Rüberg, Jürgen Zechner
+//! @date      2024
+//! @copyright TailSiT GmbH
+#pragma once
+
+// system ----------------------------------------------------------------------
+#include <chrono>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+// own -------------------------------------------------------------------------
+#include "types.hpp"
+
+//------------------------------------------------------------------------------
+namespace ts {
+
+  class StartupTimeline;
+
+}
+
+//------------------------------------------------------------------------------
+/** Wall-clock intervals of the startup stages, recorded from any thread.
+ *
+ *  Stages running concurrently overlap; the summary reports the sum of all
+ *  stage times, the time covered by at least one of them, and the
+ *  difference, which is the time saved by running them concurrently.
+ */
+class ts::StartupTimeline
+{
+public:
+  using Clock = std::chrono::steady_clock;
+
+  //----------------------------------------------------------------------------
+  class Stage
+  {
+  private:
+    StartupTimeline&  timeline_;
+    std::string       name_;
+    Clock::time_point begin_;
+
+  public:
+    Stage( StartupTimeline& timeline, std::string name )
+      : timeline_( timeline )
+      , name_( std::move( name ) )
+      , begin_( Clock::now() )
+    {}
+
+    Stage( const Stage& ) = delete;
+    Stage& operator=( const Stage& ) = delete;
+
+    ~Stage( ) { timeline_.record_( std::move( name_ ), begin_, Clock::now() ); }
+  };
+
+private:
+  struct Interval_
+  {
+    std::string       name;
+    Clock::time_point begin;
+    Clock::time_point end;
+    bool              mainThread;
+  };
+
+  Clock::time_point      origin_;
+  std::thread::id        mainThread_;
+  std::vector<Interval_> intervals_;
+  mutable std::mutex     mutex_;
+
+public:
+  //! the constructing thread is the main one
+  StartupTimeline( );
+
+  //! time covered by at least one stage
+  Real wall( ) const;
+
+  //! sum of the stage times minus wall()
+  Real overlapped( ) const;
+
+  std::ostream& writeSummary( std::ostream& out ) const;
+
+private:
+  void record_( std::string name, Clock::time_point begin, Clock::time_point end );
+
+}; // end class StartupTimeline
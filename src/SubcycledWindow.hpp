@@ -0,0 +1,108 @@
+//------------------------------------------------------------------------------
+// <preamble>
+//
+//  ______
+// |
+// | TailSiT GmbH
+// | Graz, Austria
+//   www.tailsit.com
+//
+// </preamble>
+//------------------------------------------------------------------------------
+
+//! @author    Lars Kielhorn, Thomas Rüberg, Jürgen Zechner
+//! @date      2024
+//! @copyright TailSiT GmbH
+#pragma once
+
+// system ----------------------------------------------------------------------
+#include <algorithm>
+#include <span>
+#include <utility>
+#include <vector>
+
+// own -------------------------------------------------------------------------
+#include "types.hpp"
+
+//------------------------------------------------------------------------------
+namespace ts {
+
+  class SubcycledWindow;
+
+}
+
+//------------------------------------------------------------------------------
+/** Bookkeeping of a coupling step split into substeps.
+ *
+ *  The forces evaluated at the substep ends are averaged over the step with
+ *  the trapezoidal rule, starting from the forces at the window start (the
+ *  end of the previous accepted window). Substeps end at the times read
+ *  relative to the window start, where absolute displacements are read.
+ *  The values of all meshes are held in one buffer.
+ */
+class ts::SubcycledWindow
+{
+private:
+  std::vector<Real> startForces_;    //!< at the window start
+  std::vector<Real> previousForces_; //!< at the end of the previous substep
+  std::vector<Real> substepForces_;  //!< at the end of the current substep
+  bool              hasStartForces_;
+  Real              dt_;
+  Real              time_;           //!< end of the current substep
+
+public:
+  explicit SubcycledWindow( SizeT size )
+    : startForces_(size)
+    , previousForces_(size)
+    , substepForces_(size)
+    , hasStartForces_(false)
+    , dt_(0)
+    , time_(0)
+  {}
+
+  //! false until the forces at the first window start are set
+  bool hasStartForces( ) const { return hasStartForces_; }
+
+  std::span<Real> startForces( )
+  {
+    hasStartForces_ = true;
+    return startForces_;
+  }
+
+  //! a step of dt, average is zeroed
+  void begin( Real dt, std::span<Real> average )
+  {
+    dt_   = dt;
+    time_ = 0;
+    std::ranges::copy( startForces_, previousForces_.begin() );
+    std::ranges::fill( average, 0 );
+  }
+
+  bool done( ) const { return time_ >= dt_; }
+
+  //! end of the current substep, relative to the window start
+  Real time( ) const { return time_; }
+
+  //! moves on by step, or to the step end; the size of the substep
+  Real next( Real step )
+  {
+    const Real previous = time_;
+    time_ = time_ + step < dt_ * (1 - 1e-9) ? time_ + step : dt_;
+    return time_ - previous;
+  }
+
+  std::span<Real> substepForces( ) { return substepForces_; }
+
+  //! adds the substep of size h to average
+  void add( Real h, std::span<Real> average )
+  {
+    const Real w = h / (2*dt_);
+    for( SizeT i = 0; i < average.size(); ++i )
+      average[i] += w * (previousForces_[i] + substepForces_[i]);
+    std::swap( previousForces_, substepForces_ );
+  }
+
+  //! the step is accepted, its end starts the next window
+  void accept( ) { std::swap( startForces_, previousForces_ ); }
+
+}; // end class SubcycledWindow
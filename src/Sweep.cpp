@@ -0,0 +1,119 @@
+//------------------------------------------------------------------------------
+// <preamble>
+//
+//  ______
+// |
+// | TailSiT GmbH
+// | Graz, Austria
+//   www.tailsit.com
+//
+// </preamble>
+//------------------------------------------------------------------------------
+
+//! @author    Lars Kielhorn, Thomas Rüberg, Jürgen Zechner
+//! @date      2024
+//! @copyright TailSiT GmbH
+
+// system ----------------------------------------------------------------------
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <exception>
+#include <format>
+#include <numeric>
+#include <stdexcept>
+#include <variant>
+
+// own -------------------------------------------------------------------------
+#include "Sweep.hpp"
+#include "Coupling.hpp"
+#include "ForceGenerator.hpp"
+#include "ForceModels.hpp"
+#include "Parallel.hpp"
+#include "ReplayParticipant.hpp"
+#include "Trajectory.hpp"
+
+//------------------------------------------------------------------------------
+namespace ts {
+
+  //----------------------------------------------------------------------------
+  Sweep::Sweep( const Settings& base, const SweepSettings& sweep )
+    : sweep_(sweep)
+    , runs_()
+  {
+    const auto dts    = sweep.dt.empty()          ? std::vector<Real>{ base.dt }     : sweep.dt;
+    const auto endts  = sweep.endt.empty()        ? std::vector<Real>{ base.endt }   : sweep.endt;
+    const auto models = sweep.forceModels.empty() ? std::vector{ base.forceModel } : sweep.forceModels;
+
+    for( const auto& model : models )
+      for( const auto endt : endts )
+        for( const auto dt : dts ) {
+          const SizeT run = runs_.size();
+          Settings settings    = base;
+          settings.dt          = dt;
+          settings.endt        = endt;
+          settings.forceModel  = model;
+          settings.numThreads  = 1;
+          settings.samplesFile = std::vformat( sweep.output, std::make_format_args( run ) );
+          runs_.push_back( std::move( settings ) );
+        }
+
+    // runs sharing a samples file would overwrite each other's
+    if( runs_.size() > 1 && runs_[0].samplesFile == runs_[1].samplesFile )
+      throw std::runtime_error(
+        std::format( "ts::Sweep::Sweep:output '{}' needs a '{{}}' for the run number "
+                     "with {} runs", sweep.output, runs_.size() ) );
+  }
+
+  //----------------------------------------------------------------------------
+  SizeT Sweep::numWindows( const Settings& settings )
+  {
+    // a window ending within rounding of endt still counts
+    return static_cast<SizeT>( std::ceil( settings.endt / settings.dt - 1e-9 ) );
+  }
+
+  //----------------------------------------------------------------------------
+  auto Sweep::run( std::span<const Real> coords ) const -> std::vector<Result>
+  {
+    Real maxEndt = 0;
+    for( const auto& settings : runs_ ) maxEndt = std::max( maxEndt, settings.endt );
+    const Trajectory trajectory = Trajectory::make( sweep_.trajectory, maxEndt );
+
+    std::vector<Result> results( runs_.size() );
+    parallel::forEachTask( runs_.size(),
+                           parallel::numThreads( sweep_.numThreads ),
+                           [&]( SizeT r ) {
+      using Clock = std::chrono::steady_clock;
+      const auto  t0       = Clock::now();
+      const auto& settings = runs_[r];
+      auto&       result   = results[r];
+      result.run         = r;
+      result.numWindows  = numWindows( settings );
+      result.samplesFile = settings.samplesFile;
+      try {
+        if( result.samplesFile.has_parent_path() )
+          std::filesystem::create_directories( result.samplesFile.parent_path() );
+
+        const ForceModel forceModel = makeForceModel( settings.forceModel );
+        ForceGenerator solver( coords, settings );
+        ReplayParticipant participant( trajectory, settings.dt, result.numWindows );
+
+        solver.start();
+        std::vector<Int> vertexIds( solver.numCoordinates() );
+        std::iota( vertexIds.begin(), vertexIds.end(), 0 );
+        std::visit( [&]( const auto& force ) {
+                      couple( participant, solver, settings, vertexIds, force );
+                    },
+                    forceModel );
+        solver.stop();
+        result.forceSum = participant.forceSum();
+      }
+      catch( const std::exception& e ) {
+        result.error = e.what();
+      }
+      result.seconds = std::chrono::duration<Real>( Clock::now() - t0 ).count();
+    } );
+    return results;
+  }
+
+} // end namespace ts
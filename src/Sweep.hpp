@@ -0,0 +1,73 @@
+//------------------------------------------------------------------------------
+// <preamble>
+//
+//  ______
+// |
+// | TailSiT GmbH
+// | Graz, Austria
+//   www.tailsit.com
+//
+// </preamble>
+//------------------------------------------------------------------------------
+
+//! @author    Lars Kielhorn, Thomas Rüberg, Jürgen Zechner
+//! @date      2024
+//! @copyright TailSiT GmbH
+#pragma once
+
+// system ----------------------------------------------------------------------
+#include <array>
+#include <filesystem>
+#include <span>
+#include <string>
+#include <vector>
+
+// own -------------------------------------------------------------------------
+#include "types.hpp"
+#include "Settings.hpp"
+
+//------------------------------------------------------------------------------
+namespace ts {
+
+  class Sweep;
+
+}
+
+//------------------------------------------------------------------------------
+/** Offline parameter sweep: many independent ForceGenerator runs, no preCICE.
+ *
+ *  Every combination of the swept dt, endt and force models is one run. A
+ *  run couples its own ForceGenerator to a ReplayParticipant that replays
+ *  the prescribed trajectory, and samples its forces into its own file.
+ *  Runs are spread over a work-stealing thread pool; each of them fits the
+ *  rigid motion on a single thread.
+ */
+class ts::Sweep
+{
+public:
+  struct Result
+  {
+    SizeT                 run        = 0;
+    SizeT                 numWindows = 0;
+    Real                  seconds    = 0;
+    Real                  forceSum   = 0; //!< over all windows and vertices
+    std::filesystem::path samplesFile;
+    std::string           error;          //!< empty if the run succeeded
+  };
+
+private:
+  SweepSettings         sweep_;
+  std::vector<Settings> runs_;
+
+public:
+  Sweep( const Settings& base, const SweepSettings& sweep );
+
+  //! settings of every run, samplesFile included
+  const std::vector<Settings>& runs( ) const { return runs_; }
+
+  //! all runs on the given point cloud; a failing run does not stop the others
+  std::vector<Result> run( std::span<const Real> coords ) const;
+
+  static SizeT numWindows( const Settings& settings );
+
+}; // end class Sweep
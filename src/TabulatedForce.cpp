@@ -0,0 +1,243 @@
+//------------------------------------------------------------------------------
+// <preamble>
+//
+//  ______
+// |
+// | TailSiT GmbH
+// | Graz, Austria
+//   www.tailsit.com
+//
+// </preamble>
+//------------------------------------------------------------------------------
+
+//! @author    Lars Kielhorn, Thomas Rüberg, Jürgen Zechner
+//! @date      2024
+//! @copyright TailSiT GmbH
+
+// system ----------------------------------------------------------------------
+#include <cmath>
+#include <format>
+#include <limits>
+#include <numeric>
+#include <stdexcept>
+
+// own -------------------------------------------------------------------------
+#include "TabulatedForce.hpp"
+#include "CSVParser.hpp"
+#include "Parallel.hpp"
+
+//------------------------------------------------------------------------------
+namespace ts {
+
+  //----------------------------------------------------------------------------
+  TabulatedForce::TabulatedForce( std::span<const Real> table,
+                                  Grid                  grid,
+                                  Interpolation         interpolation,
+                                  SizeT                 resolution )
+    : grid_(grid)
+    , interpolation_(interpolation)
+    , n_{ 1, 1, 1 }
+    , origin_{}
+    , invH_{}
+    , nodes_()
+  {
+    if( table.empty() || table.size() % numCols != 0 )
+      throw std::runtime_error( "ts::TabulatedForce::TabulatedForce:Invalid table size" );
+    if( resolution == 0 )
+      resolution = defaultResolution( grid );
+    if( resolution < 2 )
+      throw std::runtime_error( "ts::TabulatedForce::TabulatedForce:Resolution must be at least 2" );
+
+    // bounding box of the samples; flat axes get a single node
+    const SizeT numRows = table.size() / numCols;
+    for( SizeT a = 0; a < dim; ++a ) {
+      if( grid_ == Grid::axial && a != 2 ) continue;
+      Real lo = std::numeric_limits<Real>::max(), hi = std::numeric_limits<Real>::lowest();
+      for( SizeT r = 0; r < numRows; ++r ) {
+        lo = std::min( lo, table[numCols*r + a] );
+        hi = std::max( hi, table[numCols*r + a] );
+      }
+      origin_[a] = lo;
+      if( hi > lo ) {
+        n_[a]    = resolution;
+        invH_[a] = (resolution - 1) / (hi - lo);
+      }
+    }
+
+    if( n_[0]*n_[1]*n_[2] > maxNodes ) {
+      const std::string msg =
+        std::format( "ts::TabulatedForce::TabulatedForce:{}x{}x{} grid exceeds {} nodes, "
+                     "reduce the resolution", n_[0], n_[1], n_[2], maxNodes );
+      throw std::runtime_error(msg);
+    }
+    nodes_.assign( n_[0]*n_[1]*n_[2], Node_{} );
+    if( grid_ == Grid::axial ) resampleAxial_( table );
+    else                       resampleCartesian_( table );
+  }
+
+  //----------------------------------------------------------------------------
+  TabulatedForce::TabulatedForce( const ForceTableSettings& settings )
+    : TabulatedForce( CSVParser<numCols>()( settings.file ),
+                      settings.grid,
+                      settings.interpolation,
+                      settings.resolution )
+  {
+    // empty
+  }
+
+  //----------------------------------------------------------------------------
+  void TabulatedForce::resampleAxial_( std::span<const Real> table )
+  {
+    // sort by U2, average duplicate keys (e.g. repeated implicit iterations)
+    const SizeT numRows = table.size() / numCols;
+    std::vector<SizeT> order( numRows );
+    std::iota( order.begin(), order.end(), 0 );
+    std::ranges::sort( order, {}, [&]( SizeT r ) { return table[numCols*r + 2]; } );
+
+    std::vector<Real>  keys;
+    std::vector<Node_> values;
+    for( SizeT k = 0; k < numRows; ) {
+      const Real key = table[numCols*order[k] + 2];
+      Node_ sum = {};
+      SizeT count = 0;
+      for( ; k < numRows && table[numCols*order[k] + 2] == key; ++k, ++count )
+        for( SizeT c = 0; c < dim; ++c ) sum[c] += table[numCols*order[k] + dim + c];
+      for( auto& v : sum ) v /= count;
+      keys.push_back( key );
+      values.push_back( sum );
+    }
+
+    // piecewise linear resampling onto the uniform grid
+    for( SizeT i = 0; i < nodes_.size(); ++i ) {
+      const Real x = origin_[2] + (invH_[2] > 0 ? i / invH_[2] : 0);
+      const auto it = std::ranges::lower_bound( keys, x );
+      const SizeT j = static_cast<SizeT>( it - keys.begin() );
+      if( j == 0 )                { nodes_[i] = values.front(); continue; }
+      if( j == keys.size() )      { nodes_[i] = values.back();  continue; }
+      const Real t = (x - keys[j-1]) / (keys[j] - keys[j-1]);
+      for( SizeT l = 0; l < lanes_; ++l )
+        nodes_[i][l] = (1 - t) * values[j-1][l] + t * values[j][l];
+    }
+  }
+
+  //----------------------------------------------------------------------------
+  void TabulatedForce::resampleCartesian_( std::span<const Real> table )
+  {
+    // inverse distance weighting (power 4) of the numNeighbours nearest rows,
+    // in coordinates scaled to the unit box. The rows are sorted into a
+    // uniform grid of cells, searched ring by ring around every node until
+    // no unsearched cell can hold a nearer row.
+    static constexpr SizeT numNeighbours = 8;
+    static constexpr SizeT rowsPerCell   = 4;
+
+    const SizeT numRows = table.size() / numCols;
+    std::array<Real,dim> scale;
+    SizeT numAxes = 0;
+    for( SizeT a = 0; a < dim; ++a ) {
+      scale[a] = n_[a] > 1 ? invH_[a] / (n_[a] - 1) : 0;
+      if( n_[a] > 1 ) ++numAxes;
+    }
+
+    const Real  perAxis = std::pow( static_cast<Real>( numRows ) / rowsPerCell,
+                                    Real(1) / std::max<SizeT>( numAxes, 1 ) );
+    std::array<SizeT,dim> numCells;
+    Real width = 1; // of the narrowest cell
+    for( SizeT a = 0; a < dim; ++a ) {
+      numCells[a] = n_[a] > 1 ? std::max<SizeT>( 1, static_cast<SizeT>( perAxis ) ) : 1;
+      if( n_[a] > 1 ) width = std::min( width, Real(1) / numCells[a] );
+    }
+    auto cellOf = [&]( SizeT a, Real s ) {
+      return std::min( static_cast<SizeT>( std::max( s, Real(0) ) * numCells[a] ), numCells[a] - 1 );
+    };
+
+    // scaled positions and rows sorted by cell (counting sort)
+    std::vector<std::array<Real,dim>> pos( numRows );
+    std::vector<SizeT> cellOfRow( numRows );
+    std::vector<SizeT> cellStart( numCells[0]*numCells[1]*numCells[2] + 1, 0 );
+    for( SizeT r = 0; r < numRows; ++r ) {
+      SizeT cell = 0;
+      for( SizeT a = dim; a-- > 0; ) {
+        pos[r][a] = (table[numCols*r + a] - origin_[a]) * scale[a];
+        cell = cell * numCells[a] + cellOf( a, pos[r][a] );
+      }
+      cellOfRow[r] = cell;
+      ++cellStart[cell + 1];
+    }
+    std::partial_sum( cellStart.begin(), cellStart.end(), cellStart.begin() );
+    std::vector<SizeT> rows( numRows );
+    {
+      auto next = cellStart;
+      for( SizeT r = 0; r < numRows; ++r ) rows[ next[ cellOfRow[r] ]++ ] = r;
+    }
+    const SizeT maxRing = std::ranges::max( numCells );
+
+    parallel::forEachChunk( nodes_.size(), parallel::numThreads(),
+                            [&]( SizeT, SizeT begin, SizeT end ) {
+      for( SizeT i = begin; i < end; ++i ) {
+        const SizeT idx[dim] = { i % n_[0], (i / n_[0]) % n_[1], i / (n_[0]*n_[1]) };
+        std::array<Real,dim> x;
+        std::array<long,dim> home;
+        for( SizeT a = 0; a < dim; ++a ) {
+          x[a]    = n_[a] > 1 ? static_cast<Real>( idx[a] ) / (n_[a] - 1) : 0;
+          home[a] = static_cast<long>( cellOf( a, x[a] ) );
+        }
+
+        // the nearest rows so far, ascending by distance
+        std::array<std::pair<Real,SizeT>,numNeighbours> nearest;
+        SizeT numNearest = 0;
+        auto visit = [&]( SizeT cell ) {
+          for( SizeT k = cellStart[cell]; k < cellStart[cell + 1]; ++k ) {
+            const SizeT r = rows[k];
+            Real d2 = 0;
+            for( SizeT a = 0; a < dim; ++a ) {
+              const Real d = pos[r][a] - x[a];
+              d2 += d*d;
+            }
+            if( numNearest == numNeighbours && d2 >= nearest.back().first ) continue;
+            SizeT j = numNearest < numNeighbours ? numNearest++ : numNeighbours - 1;
+            for( ; j > 0 && nearest[j-1].first > d2; --j ) nearest[j] = nearest[j-1];
+            nearest[j] = { d2, r };
+          }
+        };
+
+        for( SizeT ring = 0; ring <= maxRing; ++ring ) {
+          const long d = static_cast<long>( ring );
+          for( long c2 = home[2] - d; c2 <= home[2] + d; ++c2 ) {
+            if( c2 < 0 || c2 >= static_cast<long>( numCells[2] ) ) continue;
+            for( long c1 = home[1] - d; c1 <= home[1] + d; ++c1 ) {
+              if( c1 < 0 || c1 >= static_cast<long>( numCells[1] ) ) continue;
+              // inner cells were visited by the smaller rings
+              const bool inner = std::abs( c2 - home[2] ) < d && std::abs( c1 - home[1] ) < d;
+              for( long c0 = home[0] - d; c0 <= home[0] + d; c0 += inner ? 2*d : 1 ) {
+                if( c0 < 0 || c0 >= static_cast<long>( numCells[0] ) ) continue;
+                visit( static_cast<SizeT>( (c2 * static_cast<long>( numCells[1] ) + c1)
+                                           * static_cast<long>( numCells[0] ) + c0 ) );
+              }
+            }
+          }
+          // rows beyond this ring are at least ring cell widths away
+          const Real reach = ring * width;
+          if( numNearest == numNeighbours && nearest.back().first <= reach*reach ) break;
+        }
+
+        Node_ sum = {};
+        if( nearest[0].first < 1e-24 ) { // exact hit
+          const Real* row = table.data() + numCols*nearest[0].second;
+          sum = { row[3], row[4], row[5], 0 };
+        }
+        else {
+          Real wsum = 0;
+          for( SizeT j = 0; j < numNearest; ++j ) {
+            const Real  w   = 1 / (nearest[j].first * nearest[j].first);
+            const Real* row = table.data() + numCols*nearest[j].second;
+            for( SizeT c = 0; c < dim; ++c ) sum[c] += w * row[dim + c];
+            wsum += w;
+          }
+          for( auto& v : sum ) v /= wsum;
+        }
+        nodes_[i] = sum;
+      }
+    } );
+  }
+
+} // end namespace ts
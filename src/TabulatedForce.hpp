@@ -0,0 +1,214 @@
+//------------------------------------------------------------------------------
+// <preamble>
+//
+//  ______
+// |
+// | TailSiT GmbH
+// | Graz, Austria
+//   www.tailsit.com
+//
+// </preamble>
+//------------------------------------------------------------------------------
+
+//! @author    Lars Kielhorn, Thomas Rüberg, Jürgen Zechner
+//! @date      2024
+//! @copyright TailSiT GmbH
+#pragma once
+
+// system ----------------------------------------------------------------------
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <span>
+#include <string_view>
+#include <vector>
+
+// own -------------------------------------------------------------------------
+#include "types.hpp"
+#include "Settings.hpp"
+#include "RigidMotion.hpp"
+
+//------------------------------------------------------------------------------
+namespace ts {
+
+  class TabulatedForce;
+
+}
+
+//------------------------------------------------------------------------------
+/** Force model interpolating a force-versus-displacement table.
+ *
+ *  The scattered table (rows U0,U1,U2,F0,F1,F2) is resampled once onto a
+ *  uniform grid, either 1D in U2 (piecewise linear) or 3D in U (inverse
+ *  distance weighting of the nearest rows, found through a cell grid). Every grid node stores the
+ *  force padded to four lanes, so an evaluation is a handful of aligned
+ *  4-wide multiply-adds over 2 (linear) or 4 (cubic, Catmull-Rom) nodes per
+ *  axis. Queries outside the table are clamped to its bounding box.
+ */
+class ts::TabulatedForce
+{
+public:
+  using Settings      = ForceTableSettings;
+  using Grid          = ForceTableSettings::Grid;
+  using Interpolation = ForceTableSettings::Interpolation;
+
+  static constexpr SizeT dim     = 3;
+  static constexpr SizeT numCols = 2*dim;
+  static constexpr std::string_view name = "tabulated";
+  static constexpr SizeT maxNodes = SizeT{1} << 24;
+
+  //! nodes per axis for resolution zero; a cartesian grid loads in well under a second
+  static constexpr SizeT defaultResolution( Grid grid )
+  {
+    return grid == Grid::axial ? 1024 : 64;
+  }
+
+private:
+  static constexpr SizeT lanes_ = 4; // F0,F1,F2,padding
+  using Node_ = std::array<Real,lanes_>;
+
+  Grid                   grid_;
+  Interpolation          interpolation_;
+  std::array<SizeT,dim>  n_;        //!< nodes per axis (1 for flat axes)
+  std::array<Real,dim>   origin_;
+  std::array<Real,dim>   invH_;     //!< inverse spacing, 0 for flat axes
+  std::vector<Node_>     nodes_;    //!< axis 0 fastest
+
+public:
+  /** @param table      row-major U0,U1,U2,F0,F1,F2 samples
+   *  @param resolution nodes per axis, zero: defaultResolution(grid) */
+  TabulatedForce( std::span<const Real> table,
+                  Grid                  grid,
+                  Interpolation         interpolation,
+                  SizeT                 resolution );
+
+  explicit TabulatedForce( const ForceTableSettings& settings );
+
+  std::array<Real,dim> eval( std::span<const Real,dim> U ) const;
+
+  void operator()( Real                /*time*/,
+                   const RigidMotion&  motion,
+                   std::span<Real>     Feval ) const
+  {
+    const auto F = eval( motion.translation );
+    std::ranges::copy( F, Feval.begin() );
+  }
+
+  SizeT numNodes( ) const { return nodes_.size(); }
+
+private:
+  void resampleAxial_( std::span<const Real> table );
+  void resampleCartesian_( std::span<const Real> table );
+
+  //! cell index and local coordinate along axis a
+  void locate_( SizeT a, Real x, SizeT& i, Real& t ) const;
+
+  template< SizeT W >
+  static void weights_( Real t, std::array<Real,W>& w );
+
+  template< SizeT W >
+  std::array<Real,dim> evalAxial_( Real x ) const;
+
+  template< SizeT W >
+  std::array<Real,dim> evalCartesian_( std::span<const Real,dim> U ) const;
+
+}; // end class TabulatedForce
+
+//============================================================================
+//
+// IMPLEMENTATION
+//
+//============================================================================
+inline void ts::TabulatedForce::locate_( SizeT a, Real x, SizeT& i, Real& t ) const
+{
+  if( n_[a] < 2 ) { i = 0; t = 0; return; }
+  const Real s = std::clamp( (x - origin_[a]) * invH_[a], Real(0), Real(n_[a] - 1) );
+  i = std::min( static_cast<SizeT>( s ), n_[a] - 2 );
+  t = s - static_cast<Real>( i );
+}
+
+//------------------------------------------------------------------------------
+template< ts::SizeT W >
+inline void ts::TabulatedForce::weights_( Real t, std::array<Real,W>& w )
+{
+  if constexpr( W == 2 ) {
+    w = { 1 - t, t };
+  }
+  else {
+    // Catmull-Rom
+    const Real t2 = t*t, t3 = t2*t;
+    w = { 0.5*(-t3 + 2*t2 - t),
+          0.5*( 3*t3 - 5*t2 + 2),
+          0.5*(-3*t3 + 4*t2 + t),
+          0.5*( t3 - t2) };
+  }
+}
+
+//------------------------------------------------------------------------------
+template< ts::SizeT W >
+inline auto ts::TabulatedForce::evalAxial_( Real x ) const -> std::array<Real,dim>
+{
+  SizeT i; Real t;
+  locate_( 2, x, i, t );
+  std::array<Real,W> w;
+  weights_<W>( t, w );
+
+  // stencil start, clamped at the ends
+  const long first = static_cast<long>(i) - (W == 4 ? 1 : 0);
+  const long last  = static_cast<long>(n_[2]) - 1;
+
+  alignas(32) Node_ acc = {};
+  for( SizeT k = 0; k < W; ++k ) {
+    const Node_& node = nodes_[ std::clamp<long>( first + k, 0, last ) ];
+    for( SizeT l = 0; l < lanes_; ++l ) acc[l] += w[k] * node[l];
+  }
+  return { acc[0], acc[1], acc[2] };
+}
+
+//------------------------------------------------------------------------------
+template< ts::SizeT W >
+inline auto ts::TabulatedForce::evalCartesian_( std::span<const Real,dim> U ) const
+  -> std::array<Real,dim>
+{
+  // flat axes contribute a single node with weight one
+  std::array<long,dim> first;
+  std::array<SizeT,dim> width;
+  std::array<std::array<Real,W>,dim> w;
+  for( SizeT a = 0; a < dim; ++a ) {
+    SizeT i; Real t;
+    locate_( a, U[a], i, t );
+    weights_<W>( t, w[a] );
+    first[a] = static_cast<long>(i) - (W == 4 ? 1 : 0);
+    width[a] = W;
+    if( n_[a] == 1 ) { w[a][0] = 1; first[a] = 0; width[a] = 1; }
+  }
+
+  auto index = [this]( SizeT a, long i ) {
+    return static_cast<SizeT>( std::clamp<long>( i, 0, static_cast<long>(n_[a]) - 1 ) );
+  };
+
+  alignas(32) Node_ acc = {};
+  for( SizeT k2 = 0; k2 < width[2]; ++k2 ) {
+    const SizeT o2 = index( 2, first[2] + k2 ) * n_[1];
+    for( SizeT k1 = 0; k1 < width[1]; ++k1 ) {
+      const SizeT o1 = (o2 + index( 1, first[1] + k1 )) * n_[0];
+      const Real  w12 = w[2][k2] * w[1][k1];
+      for( SizeT k0 = 0; k0 < width[0]; ++k0 ) {
+        const Node_& node = nodes_[ o1 + index( 0, first[0] + k0 ) ];
+        const Real   wk   = w12 * w[0][k0];
+        for( SizeT l = 0; l < lanes_; ++l ) acc[l] += wk * node[l];
+      }
+    }
+  }
+  return { acc[0], acc[1], acc[2] };
+}
+
+//------------------------------------------------------------------------------
+inline auto ts::TabulatedForce::eval( std::span<const Real,dim> U ) const
+  -> std::array<Real,dim>
+{
+  const bool linear = interpolation_ == Interpolation::linear;
+  if( grid_ == Grid::axial )
+    return linear ? evalAxial_<2>( U[2] ) : evalAxial_<4>( U[2] );
+  return linear ? evalCartesian_<2>( U ) : evalCartesian_<4>( U );
+}
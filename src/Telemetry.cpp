@@ -0,0 +1,363 @@
+//------------------------------------------------------------------------------
+// <preamble>
+//
+//  ______
+// |
+// | TailSiT GmbH
+// | Graz, Austria
+//   www.tailsit.com
+//
+// </preamble>
+//------------------------------------------------------------------------------
+
+//! @author    Lars Kielhorn, Thomas Rüberg, Jürgen Zechner
+//! @date      2024
+//! @copyright TailSiT GmbH
+
+// system ----------------------------------------------------------------------
+#include <atomic>
+#include <bit>
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+#include <format>
+#include <stdexcept>
+#include <thread>
+#include <type_traits>
+#include <utility>
+
+// posix -----------------------------------------------------------------------
+#include <fcntl.h>
+#include <signal.h>
+#include <sys/file.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+// own -------------------------------------------------------------------------
+#include "Telemetry.hpp"
+
+//------------------------------------------------------------------------------
+namespace ts {
+
+  //----------------------------------------------------------------------------
+  /** Layout of the shared memory; the magic is stored last, so readers see
+   *  either nothing or a complete header */
+  struct Telemetry::Region_
+  {
+    static constexpr std::uint64_t magicValue = 0x5453'5445'4c45'4d32; // "TSTELEM2"
+    static constexpr SizeT         numWords   = sizeof(Counters) / sizeof(std::uint64_t);
+
+    struct alignas(64) Slot
+    {
+      std::uint64_t                       sequence; //!< odd while the writer is inside
+      std::array<std::uint64_t,numWords>  words;
+    };
+
+    std::uint64_t                                     magic;
+    std::uint64_t                                     pid;
+    std::uint64_t                                     numMeshes;
+    std::uint64_t                                     status;
+    std::array<std::array<char,nameLength>,maxMeshes> meshNames;
+    std::array<Slot,maxMeshes>                        slots;
+  };
+
+  namespace {
+
+    static_assert( std::is_trivially_copyable_v<Telemetry::Counters> &&
+                   sizeof(Telemetry::Counters) % sizeof(std::uint64_t) == 0,
+                   "the counters are copied as words" );
+    static_assert( std::atomic_ref<std::uint64_t>::is_always_lock_free,
+                   "the seqlock is shared between processes" );
+
+    //! the words of the shared region are only accessed atomically; the
+    //! reader's mapping is read-only, which plain atomic loads are fine with
+    std::atomic_ref<std::uint64_t> word( const std::uint64_t& w )
+    {
+      return std::atomic_ref<std::uint64_t>( const_cast<std::uint64_t&>( w ) );
+    }
+
+    std::string objectName( const std::string& name )
+    {
+      return name.starts_with( '/' ) ? name : "/" + name;
+    }
+
+    //! serializes the adapters creating a region, on an object next to it
+    //! that is never removed: a removed one could be locked by two of them
+    class CreateLock
+    {
+    private:
+      int fd_;
+
+    public:
+      explicit CreateLock( const std::string& name )
+        : fd_( ::shm_open( (name + ".lock").c_str(), O_CREAT | O_RDWR, 0644 ) )
+      {
+        while( fd_ >= 0 && ::flock( fd_, LOCK_EX ) != 0 )
+          if( errno != EINTR ) {
+            ::close( fd_ );
+            fd_ = -1;
+          }
+        if( fd_ < 0 ) {
+          const std::string msg = std::format( "ts::Telemetry::create:Cannot lock '{}': {}",
+                                               name, std::strerror(errno) );
+          throw std::runtime_error(msg);
+        }
+      }
+
+      CreateLock( const CreateLock& ) = delete;
+      CreateLock& operator=( const CreateLock& ) = delete;
+
+      //! closing releases the lock
+      ~CreateLock( ) { ::close( fd_ ); }
+    };
+
+  } // end anonymous namespace
+
+  //----------------------------------------------------------------------------
+  Telemetry::Telemetry( ) noexcept
+    : region_(nullptr)
+    , name_()
+    , owner_(false)
+  {
+    // empty
+  }
+
+  //----------------------------------------------------------------------------
+  Telemetry::Telemetry( Telemetry&& other ) noexcept
+    : region_( std::exchange( other.region_, nullptr ) )
+    , name_( std::move( other.name_ ) )
+    , owner_( std::exchange( other.owner_, false ) )
+  {
+    // empty
+  }
+
+  //----------------------------------------------------------------------------
+  Telemetry& Telemetry::operator=( Telemetry&& other ) noexcept
+  {
+    if( this != &other ) {
+      release_();
+      region_ = std::exchange( other.region_, nullptr );
+      name_   = std::move( other.name_ );
+      owner_  = std::exchange( other.owner_, false );
+    }
+    return *this;
+  }
+
+  //----------------------------------------------------------------------------
+  Telemetry::~Telemetry( )
+  {
+    release_();
+  }
+
+  //----------------------------------------------------------------------------
+  Telemetry Telemetry::create( const std::string& name, const std::vector<std::string>& meshNames )
+  {
+    if( meshNames.size() > maxMeshes ) {
+      const std::string msg = std::format( "ts::Telemetry::create:At most {} meshes, not {}",
+                                           maxMeshes, meshNames.size() );
+      throw std::runtime_error(msg);
+    }
+
+    Telemetry telemetry;
+    telemetry.name_ = objectName( name );
+
+    // held until the header is complete: of several adapters finding the
+    // same stale region, the first replaces it and the others find it in use
+    const CreateLock lock( telemetry.name_ );
+    int fd = ::shm_open( telemetry.name_.c_str(), O_CREAT | O_EXCL | O_RDWR, 0644 );
+    if( fd < 0 && errno == EEXIST ) {
+      // another adapter's, or left behind by a crashed run: only the latter is replaced
+      const std::uint64_t pid = ownerOf_( telemetry.name_ );
+      if( pid == 0 ) {
+        const std::string msg = std::format( "ts::Telemetry::create:'{}' exists and is not a telemetry region",
+                                             telemetry.name_ );
+        throw std::runtime_error(msg);
+      }
+      if( alive( pid ) ) {
+        const std::string msg = std::format( "ts::Telemetry::create:'{}' is in use by process {}",
+                                             telemetry.name_, pid );
+        throw std::runtime_error(msg);
+      }
+      ::shm_unlink( telemetry.name_.c_str() );
+      fd = ::shm_open( telemetry.name_.c_str(), O_CREAT | O_EXCL | O_RDWR, 0644 );
+    }
+    if( fd < 0 ) {
+      const std::string msg = std::format( "ts::Telemetry::create:Cannot create '{}': {}",
+                                           telemetry.name_, std::strerror(errno) );
+      throw std::runtime_error(msg);
+    }
+    // created exclusively: from here on the destructor removes it again
+    telemetry.owner_ = true;
+    if( ::ftruncate( fd, sizeof(Region_) ) != 0 ) {
+      ::close( fd );
+      ::shm_unlink( telemetry.name_.c_str() );
+      const std::string msg = std::format( "ts::Telemetry::create:Cannot size '{}': {}",
+                                           telemetry.name_, std::strerror(errno) );
+      throw std::runtime_error(msg);
+    }
+    void* ptr = ::mmap( nullptr, sizeof(Region_), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0 );
+    ::close( fd );
+    if( ptr == MAP_FAILED ) {
+      ::shm_unlink( telemetry.name_.c_str() );
+      const std::string msg = std::format( "ts::Telemetry::create:Cannot map '{}': {}",
+                                           telemetry.name_, std::strerror(errno) );
+      throw std::runtime_error(msg);
+    }
+
+    // the object is zero filled; the header is complete before the magic
+    Region_* region = static_cast<Region_*>( ptr );
+    region -> pid       = static_cast<std::uint64_t>( ::getpid() );
+    region -> numMeshes = meshNames.size();
+    region -> status    = static_cast<std::uint64_t>( Status::starting );
+    for( SizeT m = 0; m < meshNames.size(); ++m )
+      meshNames[m].copy( region -> meshNames[m].data(), nameLength - 1 );
+    word( region -> magic ).store( Region_::magicValue, std::memory_order_release );
+    telemetry.region_ = region;
+    return telemetry;
+  }
+
+  //----------------------------------------------------------------------------
+  Telemetry Telemetry::attach( const std::string& name )
+  {
+    Telemetry telemetry;
+    telemetry.name_ = objectName( name );
+    const int fd = ::shm_open( telemetry.name_.c_str(), O_RDONLY, 0 );
+    if( fd < 0 ) {
+      const std::string msg = std::format( "ts::Telemetry::attach:No telemetry '{}': {}",
+                                           telemetry.name_, std::strerror(errno) );
+      throw std::runtime_error(msg);
+    }
+    struct stat st;
+    if( ::fstat( fd, &st ) != 0 || static_cast<SizeT>( st.st_size ) < sizeof(Region_) ) {
+      ::close( fd );
+      const std::string msg = std::format( "ts::Telemetry::attach:'{}' is not a telemetry region",
+                                           telemetry.name_ );
+      throw std::runtime_error(msg);
+    }
+    void* ptr = ::mmap( nullptr, sizeof(Region_), PROT_READ, MAP_SHARED, fd, 0 );
+    ::close( fd );
+    if( ptr == MAP_FAILED ) {
+      const std::string msg = std::format( "ts::Telemetry::attach:Cannot map '{}': {}",
+                                           telemetry.name_, std::strerror(errno) );
+      throw std::runtime_error(msg);
+    }
+    telemetry.region_ = static_cast<Region_*>( ptr );
+    if( word( telemetry.region_ -> magic ).load( std::memory_order_acquire ) != Region_::magicValue ) {
+      const std::string msg = std::format( "ts::Telemetry::attach:'{}' is not a telemetry region",
+                                           telemetry.name_ );
+      throw std::runtime_error(msg);
+    }
+    return telemetry;
+  }
+
+  //----------------------------------------------------------------------------
+  void Telemetry::publish( SizeT mesh, const Counters& counters )
+  {
+    auto& slot = region_ -> slots[mesh];
+    const auto words = std::bit_cast<std::array<std::uint64_t,Region_::numWords>>( counters );
+    const std::uint64_t sequence = slot.sequence; // only this thread writes it
+    word( slot.sequence ).store( sequence + 1, std::memory_order_relaxed );
+    std::atomic_thread_fence( std::memory_order_release );
+    for( SizeT w = 0; w < Region_::numWords; ++w )
+      word( slot.words[w] ).store( words[w], std::memory_order_relaxed );
+    word( slot.sequence ).store( sequence + 2, std::memory_order_release );
+  }
+
+  //----------------------------------------------------------------------------
+  void Telemetry::setStatus( Status status )
+  {
+    word( region_ -> status ).store( static_cast<std::uint64_t>( status ),
+                                     std::memory_order_release );
+  }
+
+  //----------------------------------------------------------------------------
+  Telemetry::Counters Telemetry::read( SizeT mesh ) const
+  {
+    if( mesh >= numMeshes() ) {
+      const std::string msg = std::format( "ts::Telemetry::read:No mesh {} in '{}'",
+                                           mesh, name_ );
+      throw std::runtime_error(msg);
+    }
+
+    // a writer is inside for well below a microsecond; one that stays there
+    // died in the middle of an update
+    static constexpr SizeT maxAttempts = SizeT{1} << 20;
+    const auto& slot = region_ -> slots[mesh];
+    std::array<std::uint64_t,Region_::numWords> words;
+    for( SizeT attempt = 0; attempt < maxAttempts; ++attempt ) {
+      const std::uint64_t before = word( slot.sequence ).load( std::memory_order_acquire );
+      if( before % 2 == 0 ) {
+        for( SizeT w = 0; w < Region_::numWords; ++w )
+          words[w] = word( slot.words[w] ).load( std::memory_order_relaxed );
+        std::atomic_thread_fence( std::memory_order_acquire );
+        if( word( slot.sequence ).load( std::memory_order_relaxed ) == before )
+          return std::bit_cast<Counters>( words );
+      }
+      std::this_thread::yield();
+    }
+    const std::string msg = std::format( "ts::Telemetry::read:Writer of '{}' stuck in an update",
+                                         name_ );
+    throw std::runtime_error(msg);
+  }
+
+  //----------------------------------------------------------------------------
+  Telemetry::Status Telemetry::status( ) const
+  {
+    return static_cast<Status>( word( region_ -> status ).load( std::memory_order_acquire ) );
+  }
+
+  //----------------------------------------------------------------------------
+  std::uint64_t Telemetry::pid( ) const
+  {
+    return region_ -> pid;
+  }
+
+  //----------------------------------------------------------------------------
+  SizeT Telemetry::numMeshes( ) const
+  {
+    return static_cast<SizeT>( region_ -> numMeshes );
+  }
+
+  //----------------------------------------------------------------------------
+  std::string Telemetry::meshName( SizeT mesh ) const
+  {
+    return std::string( region_ -> meshNames.at( mesh ).data() );
+  }
+
+  //----------------------------------------------------------------------------
+  Real Telemetry::now( )
+  {
+    return std::chrono::duration<Real>( std::chrono::system_clock::now().time_since_epoch() ).count();
+  }
+
+  //----------------------------------------------------------------------------
+  bool Telemetry::alive( std::uint64_t pid )
+  {
+    return ::kill( static_cast<pid_t>( pid ), 0 ) == 0 || errno == EPERM;
+  }
+
+  //----------------------------------------------------------------------------
+  std::uint64_t Telemetry::ownerOf_( const std::string& name ) noexcept
+  {
+    try {
+      return attach( name ).pid();
+    } catch( const std::exception& ) {
+      return 0;
+    }
+  }
+
+  //----------------------------------------------------------------------------
+  void Telemetry::release_( ) noexcept
+  {
+    if( region_ ) {
+      ::munmap( region_, sizeof(Region_) );
+      // unless a later adapter took the name over after all
+      if( owner_ && ownerOf_( name_ ) == static_cast<std::uint64_t>( ::getpid() ) )
+        ::shm_unlink( name_.c_str() );
+    }
+    region_ = nullptr;
+    owner_  = false;
+  }
+
+} // end namespace ts
@@ -0,0 +1,133 @@
+//------------------------------------------------------------------------------
+// <preamble>
+//
+//  ______
+// |
+// | TailSiT GmbH
+// | Graz, Austria
+//   www.tailsit.com
+//
+// </preamble>
+//------------------------------------------------------------------------------
+
+//! @author    Lars Kielhorn, Thomas Rüberg, Jürgen Zechner
+//! @date      2024
+//! @copyright TailSiT GmbH
+#pragma once
+
+// system ----------------------------------------------------------------------
+#include <array>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// own -------------------------------------------------------------------------
+#include "types.hpp"
+#include "Profiler.hpp"
+
+//------------------------------------------------------------------------------
+namespace ts {
+
+  class Telemetry;
+
+}
+
+//------------------------------------------------------------------------------
+/** Live counters of a running adapter in POSIX shared memory.
+ *
+ *  The adapter creates the region, one slot per mesh, and every solver
+ *  publishes its counters into its slot after each solve, reload and
+ *  accepted step. Every slot is a seqlock: the single writer bumps the
+ *  slot's sequence to odd, stores the counters and bumps it to even again,
+ *  without ever waiting. Readers attach read-only from other processes
+ *  (ts_telemetry) and retry while the sequence is odd or has moved. The
+ *  creator removes the region on destruction; attached readers keep their
+ *  view of the last state.
+ */
+class ts::Telemetry
+{
+public:
+  enum class Status : std::uint64_t { starting, coupling, finished };
+
+  static constexpr SizeT maxMeshes  = 16;
+  static constexpr SizeT nameLength = 64;  //!< of mesh names, with the terminating zero
+
+  //! one mesh, as published
+  struct Counters
+  {
+    Real                                  time          = 0; //!< of the solver
+    Real                                  updated       = 0; //!< wall clock [s since epoch]
+    std::uint64_t                         window        = 0; //!< accepted windows
+    std::uint64_t                         iteration     = 0; //!< of the current window
+    std::uint64_t                         numIterations = 0; //!< over all windows
+    std::uint64_t                         numReloads    = 0; //!< checkpoint reloads
+    std::uint64_t                         numSkipped    = 0; //!< unchanged fields
+    std::array<Real,3>                    translation   = {};
+    std::array<Real,3>                    force         = {};
+    std::uint64_t                         profiling     = 0; //!< the phases are recorded
+    std::array<Real,Profiler::numPhases>  phaseTotals   = {}; //!< [s], with profiling only
+    std::array<std::uint64_t,Profiler::numPhases> phaseCalls = {}; //!< with profiling only
+  };
+
+private:
+  struct Region_;
+
+  Region_*    region_;
+  std::string name_;
+  bool        owner_;  //!< created it, removes it
+
+public:
+  Telemetry( ) noexcept;
+
+  Telemetry( const Telemetry& ) = delete;
+  Telemetry& operator=( const Telemetry& ) = delete;
+
+  Telemetry( Telemetry&& other ) noexcept;
+  Telemetry& operator=( Telemetry&& other ) noexcept;
+
+  ~Telemetry( );
+
+  /** The region called name ('/name' in /dev/shm), created exclusively for
+   *  the given meshes; a stale one of a crashed run is replaced, one of a
+   *  running process is an error. Creators take turns on a lock object
+   *  '/name.lock', which stays. */
+  static Telemetry create( const std::string& name, const std::vector<std::string>& meshNames );
+
+  //! an existing region, read-only
+  static Telemetry attach( const std::string& name );
+
+  bool valid( ) const noexcept { return region_ != nullptr; }
+
+  const std::string& name( ) const noexcept { return name_; }
+
+  /** @name writer */
+  //@{
+  void publish( SizeT mesh, const Counters& counters );
+
+  void setStatus( Status status );
+  //@}
+
+  /** @name reader */
+  //@{
+  //! a consistent snapshot of the mesh's counters
+  Counters read( SizeT mesh ) const;
+
+  Status        status( ) const;
+  std::uint64_t pid( ) const;
+  SizeT         numMeshes( ) const;
+  std::string   meshName( SizeT mesh ) const;
+  //@}
+
+  //! wall clock, as in Counters::updated
+  static Real now( );
+
+  //! the process still exists (or cannot be signalled by us)
+  static bool alive( std::uint64_t pid );
+
+private:
+  //! pid of the writer of the region called name, 0 without a valid one
+  static std::uint64_t ownerOf_( const std::string& name ) noexcept;
+
+  void release_( ) noexcept;
+
+}; // end class Telemetry
@@ -0,0 +1,152 @@
+//------------------------------------------------------------------------------
+// <preamble>
+//
+//  ______
+// |
+// | TailSiT GmbH
+// | Graz, Austria
+//   www.tailsit.com
+//
+// </preamble>
+//------------------------------------------------------------------------------
+
+//! @author    Lars Kielhorn, Thomas Rüberg, Jürgen Zechner
+//! @date      2024
+//! @copyright TailSiT GmbH
+
+// system ----------------------------------------------------------------------
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+// own -------------------------------------------------------------------------
+#include "TimeStepControl.hpp"
+
+//------------------------------------------------------------------------------
+namespace {
+
+  using Vector = ts::TimeStepControl::Vector;
+
+  ts::Real norm( const Vector& x )
+  {
+    return std::hypot( x[0], x[1], x[2] );
+  }
+
+  ts::Real dot( const Vector& x, const Vector& y )
+  {
+    return x[0]*y[0] + x[1]*y[1] + x[2]*y[2];
+  }
+
+} // end anonymous namespace
+
+//------------------------------------------------------------------------------
+namespace ts {
+
+  //----------------------------------------------------------------------------
+  TimeStepControl::TimeStepControl( const TimeStepSettings& settings, Real dt )
+    : settings_(settings)
+    , dt_(dt)
+    , proposed_(dt)
+    , times_()
+    , points_()
+    , numPoints_(0)
+    , gradient_()
+    , curvature_()
+    , direction_()
+    , forceScale_( settings.forceScale )
+  {
+    reset();
+  }
+
+  //----------------------------------------------------------------------------
+  void TimeStepControl::reset( )
+  {
+    proposed_   = settings_.adaptive ? std::clamp( dt_, settings_.dtMin, settings_.dtMax ) : dt_;
+    numPoints_  = 0;
+    gradient_   = curvature_ = direction_ = Vector{};
+    forceScale_ = settings_.forceScale;
+    accept( 0, Vector{} );
+  }
+
+  //----------------------------------------------------------------------------
+  auto TimeStepControl::velocity( ) const -> Vector
+  {
+    Vector V{};
+    if( numPoints_ < 2 ) return V;
+    const Real h = times_[0] - times_[1];
+    for( SizeT a = 0; a < 3; ++a ) V[a] = (points_[0][a] - points_[1][a]) / h;
+    return V;
+  }
+
+  //----------------------------------------------------------------------------
+  auto TimeStepControl::acceleration( ) const -> Vector
+  {
+    // second divided difference on the non-uniform steps h0, h1
+    Vector A{};
+    if( numPoints_ < 3 ) return A;
+    const Real h0 = times_[0] - times_[1];
+    const Real h1 = times_[1] - times_[2];
+    for( SizeT a = 0; a < 3; ++a )
+      A[a] = 2 * ( (points_[0][a] - points_[1][a]) / h0
+                 - (points_[1][a] - points_[2][a]) / h1 ) / (h0 + h1);
+    return A;
+  }
+
+  //----------------------------------------------------------------------------
+  void TimeStepControl::accept( Real time, const Vector& U )
+  {
+    if( !settings_.adaptive ) return;
+    // a repeated time (zero step) would spoil the differences
+    if( numPoints_ > 0 && !(time > times_[0]) ) {
+      points_[0] = U;
+      return;
+    }
+    std::shift_right( times_.begin(), times_.end(), 1 );
+    std::shift_right( points_.begin(), points_.end(), 1 );
+    times_[0]  = time;
+    points_[0] = U;
+    numPoints_ = std::min<SizeT>( numPoints_ + 1, times_.size() );
+  }
+
+  //----------------------------------------------------------------------------
+  Real TimeStepControl::error( Real dt ) const
+  {
+    const auto [c1, c2] = errorCoefficients_();
+    return c1*dt + c2*dt*dt;
+  }
+
+  //----------------------------------------------------------------------------
+  Real TimeStepControl::propose( )
+  {
+    if( !settings_.adaptive ) return dt_;
+
+    // the largest dt with c1 dt + c2 dt^2 <= tolerance
+    const auto [c1, c2] = errorCoefficients_();
+    const Real tol = settings_.tolerance;
+    Real dt = std::numeric_limits<Real>::infinity();
+    if( c1 > 0 || c2 > 0 )
+      dt = 2*tol / (c1 + std::sqrt( c1*c1 + 4*c2*tol ));
+
+    const Real upper = std::max( settings_.dtMin,
+                                 std::min( settings_.dtMax, settings_.maxGrowth * proposed_ ) );
+    proposed_ = std::clamp( settings_.safety * dt, settings_.dtMin, upper );
+    return proposed_;
+  }
+
+  //----------------------------------------------------------------------------
+  std::array<Real,2> TimeStepControl::errorCoefficients_( ) const
+  {
+    const Vector V = velocity();
+    const Vector A = acceleration();
+    const Real   v = dot( V, direction_ );
+    const Real   a = dot( A, direction_ );
+    Vector rate, change;
+    for( SizeT i = 0; i < 3; ++i ) {
+      rate[i]   = gradient_[i] * v;
+      change[i] = curvature_[i] * v*v + gradient_[i] * a;
+    }
+    const Real scale = forceScale_ > 0 ? forceScale_ : std::numeric_limits<Real>::min();
+    return { norm( rate ) / scale, norm( change ) / (2*scale) };
+  }
+
+} // end namespace ts
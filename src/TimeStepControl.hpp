@@ -0,0 +1,149 @@
+//------------------------------------------------------------------------------
+// <preamble>
+//
+//  ______
+// |
+// | TailSiT GmbH
+// | Graz, Austria
+//   www.tailsit.com
+//
+// </preamble>
+//------------------------------------------------------------------------------
+
+//! @author    Lars Kielhorn, Thomas Rüberg, Jürgen Zechner
+//! @date      2024
+//! @copyright TailSiT GmbH
+#pragma once
+
+// system ----------------------------------------------------------------------
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <utility>
+
+// own -------------------------------------------------------------------------
+#include "types.hpp"
+#include "Settings.hpp"
+#include "RigidMotion.hpp"
+
+//------------------------------------------------------------------------------
+namespace ts {
+
+  class TimeStepControl;
+
+}
+
+//------------------------------------------------------------------------------
+/** Step size proposals of the ForceGenerator.
+ *
+ *  The coupling partner sees the force sampled once per step, so a step is
+ *  as large as the force allows to change by at most tolerance relative to
+ *  the force scale, or to the largest force seen if that is larger:
+ *
+ *    |F'| dt + |F''| dt^2 / 2 <= tolerance max( forceScale, max|F| )
+ *
+ *  with the time derivatives taken along the motion,
+ *
+ *    F'  = dF/ds (V.d),  F'' = d2F/ds2 (V.d)^2 + dF/ds (A.d).
+ *
+ *  dF/ds and d2F/ds2 are central differences of the force model along the
+ *  direction d of motion (probe()), over the distance the body travels in a
+ *  step, so that sharp transitions ahead are seen before they are stepped
+ *  over. Velocity V and acceleration A are divided differences of the last
+ *  three accepted translations (accept()). The components of A normal to d
+ *  are neglected. Proposals stay within [dtMin, dtMax] and grow by at most
+ *  maxGrowth per step; without any motion yet they only grow.
+ *
+ *  All of the state is in the object, so checkpoints simply copy it.
+ */
+class ts::TimeStepControl
+{
+public:
+  using Vector = std::array<Real,3>;
+
+private:
+  TimeStepSettings     settings_;
+  Real                 dt_;         //!< fixed step, the first proposal
+  Real                 proposed_;   //!< last proposal
+  std::array<Real,3>   times_;      //!< accepted, newest first
+  std::array<Vector,3> points_;     //!< translations at times_
+  SizeT                numPoints_;
+  Vector               gradient_;   //!< dF/ds at the newest probe
+  Vector               curvature_;  //!< d2F/ds2 at the newest probe
+  Vector               direction_;  //!< d of the newest probe
+  Real                 forceScale_; //!< max( forceScale, max|F| probed )
+
+public:
+  TimeStepControl( const TimeStepSettings& settings, Real dt );
+
+  bool adaptive( ) const { return settings_.adaptive; }
+
+  //! forget all history, the next proposal is dt again
+  void reset( );
+
+  //! velocity and acceleration of the accepted translations
+  Vector velocity( ) const;
+  Vector acceleration( ) const;
+
+  //! differences force(time, motion moved along the motion) with the model
+  template< typename FORCE >
+  void probe( const FORCE& force, Real time, const RigidMotion& motion );
+
+  //! the step ending at time with translation U is accepted
+  void accept( Real time, const Vector& U );
+
+  //! estimated relative force change over a step of dt
+  Real error( Real dt ) const;
+
+  Real propose( );
+
+private:
+  //! error(dt) = c1 dt + c2 dt^2
+  std::array<Real,2> errorCoefficients_( ) const;
+
+}; // end class TimeStepControl
+
+//============================================================================
+//
+// IMPLEMENTATION
+//
+//============================================================================
+template< typename FORCE >
+void ts::TimeStepControl::probe( const FORCE& force, Real time, const RigidMotion& motion )
+{
+  if( !settings_.adaptive ) return;
+
+  Vector F;
+  force( time, motion, F );
+  forceScale_ = std::max( forceScale_, std::hypot( F[0], F[1], F[2] ) );
+
+  // move by the distance of the next step, along the motion or, from rest,
+  // along the acceleration
+  Vector d = velocity();
+  Real speed = std::hypot( d[0], d[1], d[2] );
+  if( speed == 0 ) {
+    d = acceleration();
+    speed = std::hypot( d[0], d[1], d[2] ) * proposed_;
+  }
+  const Real norm = std::hypot( d[0], d[1], d[2] );
+  if( norm == 0 ) {
+    gradient_ = curvature_ = direction_ = Vector{};
+    return;
+  }
+  for( auto& x : d ) x /= norm;
+  const auto& U = motion.translation;
+  const Real h = std::max( speed * proposed_,
+                           1e-9 * (1 + std::hypot( U[0], U[1], U[2] )) );
+
+  RigidMotion moved = motion;
+  Vector Fp, Fm;
+  for( SizeT a = 0; a < 3; ++a ) moved.translation[a] = U[a] + h*d[a];
+  force( time, std::as_const( moved ), Fp );
+  for( SizeT a = 0; a < 3; ++a ) moved.translation[a] = U[a] - h*d[a];
+  force( time, std::as_const( moved ), Fm );
+  for( SizeT a = 0; a < 3; ++a ) {
+    gradient_[a]  = (Fp[a] - Fm[a]) / (2*h);
+    curvature_[a] = (Fp[a] - 2*F[a] + Fm[a]) / (h*h);
+  }
+  direction_ = d;
+}
@@ -0,0 +1,130 @@
+//------------------------------------------------------------------------------
+// <preamble>
+//
+//  ______
+// |
+// | TailSiT GmbH
+// | Graz, Austria
+//   www.tailsit.com
+//
+// </preamble>
+//------------------------------------------------------------------------------
+
+//! @author    Lars Kielhorn, Thomas Rüberg, Jürgen Zechner
+//! @date      2024
+//! @copyright TailSiT GmbH
+#pragma once
+
+// system ----------------------------------------------------------------------
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <cstdint>
+#include <span>
+#include <stdexcept>
+#include <string_view>
+
+// own -------------------------------------------------------------------------
+#include "types.hpp"
+#include "CouplingTrace.hpp"
+
+//------------------------------------------------------------------------------
+namespace ts {
+
+  class TraceParticipant;
+
+}
+
+//------------------------------------------------------------------------------
+/** Stand-in for precice::Participant that replays a recorded CouplingTrace.
+ *
+ *  Every record is one iteration: its step size and checkpoint flags drive
+ *  the coupling loop, its displacements are read. The forces written are
+ *  compared with the recorded ones, bit for bit if tolerance is zero, else
+ *  by their absolute difference.
+ */
+class ts::TraceParticipant
+{
+private:
+  CouplingTrace::Reader& trace_;
+  Real                   tolerance_;
+  bool                   ongoing_;
+  bool                   readCheckpoint_;
+  SizeT                  numIterations_;
+  SizeT                  numMismatches_;
+  SizeT                  firstMismatch_;
+  Real                   maxDeviation_;
+
+public:
+  TraceParticipant( CouplingTrace::Reader& trace, Real tolerance = 0 )
+    : trace_(trace)
+    , tolerance_(tolerance)
+    , ongoing_( trace.next() )
+    , readCheckpoint_(false)
+    , numIterations_(0)
+    , numMismatches_(0)
+    , firstMismatch_(0)
+    , maxDeviation_(0)
+  {}
+
+  SizeT numIterations( ) const { return numIterations_; }
+
+  //! iterations whose forces differ from the recorded ones
+  SizeT numMismatches( ) const { return numMismatches_; }
+
+  //! the first of them, if any
+  SizeT firstMismatch( ) const { return firstMismatch_; }
+
+  Real maxDeviation( ) const { return maxDeviation_; }
+
+  /** @name the precice::Participant calls of the coupling loop */
+  //@{
+  bool isCouplingOngoing( ) const { return ongoing_; }
+
+  bool requiresWritingCheckpoint( ) const { return trace_.record().writeCheckpoint; }
+
+  bool requiresReadingCheckpoint( ) const { return readCheckpoint_; }
+
+  Real getMaxTimeStepSize( ) const { return trace_.record().dt; }
+
+  void readData( std::string_view      /*meshName*/,
+                 std::string_view      /*dataName*/,
+                 std::span<const Int>  /*vertexIds*/,
+                 Real                  /*relativeReadTime*/,
+                 std::span<Real>       values ) const
+  {
+    const auto& recorded = trace_.record().displacements;
+    if( values.size() != recorded.size() )
+      throw std::runtime_error( "ts::TraceParticipant::readData:Invalid size" );
+    std::ranges::copy( recorded, values.begin() );
+  }
+
+  void writeData( std::string_view      /*meshName*/,
+                  std::string_view      /*dataName*/,
+                  std::span<const Int>  /*vertexIds*/,
+                  std::span<const Real> values )
+  {
+    const auto& recorded = trace_.record().forces;
+    if( values.size() != recorded.size() )
+      throw std::runtime_error( "ts::TraceParticipant::writeData:Invalid size" );
+    bool mismatch = false;
+    for( SizeT i = 0; i < values.size(); ++i ) {
+      const Real deviation = std::abs( values[i] - recorded[i] );
+      maxDeviation_ = std::max( maxDeviation_, deviation );
+      mismatch = mismatch || ( tolerance_ > 0
+                               ? !(deviation <= tolerance_)
+                               : std::bit_cast<std::uint64_t>( values[i] )
+                                 != std::bit_cast<std::uint64_t>( recorded[i] ) );
+    }
+    if( mismatch && numMismatches_++ == 0 ) firstMismatch_ = numIterations_;
+  }
+
+  void advance( Real /*dt*/ )
+  {
+    readCheckpoint_ = trace_.record().readCheckpoint;
+    ++numIterations_;
+    ongoing_ = trace_.next();
+  }
+  //@}
+
+}; // end class TraceParticipant
@@ -0,0 +1,96 @@
+//------------------------------------------------------------------------------
+// <preamble>
+//
+//  ______
+// |
+// | TailSiT GmbH
+// | Graz, Austria
+//   www.tailsit.com
+//
+// </preamble>
+//------------------------------------------------------------------------------
+
+//! @author    Lars Kielhorn, Thomas Rüberg, Jürgen Zechner
+//! @date      2024
+//! @copyright TailSiT GmbH
+
+// system ----------------------------------------------------------------------
+#include <algorithm>
+#include <format>
+#include <functional>
+#include <stdexcept>
+#include <utility>
+
+// own -------------------------------------------------------------------------
+#include "Trajectory.hpp"
+#include "CSVParser.hpp"
+
+//------------------------------------------------------------------------------
+namespace ts {
+
+  //----------------------------------------------------------------------------
+  Trajectory::Trajectory( std::vector<Real> times, std::vector<Vector> translations )
+    : times_( std::move( times ) )
+    , translations_( std::move( translations ) )
+  {
+    if( times_.empty() || times_.size() != translations_.size() )
+      throw std::runtime_error( "ts::Trajectory:Invalid samples" );
+    if( std::ranges::adjacent_find( times_, std::greater_equal<>() ) != times_.end() )
+      throw std::runtime_error( "ts::Trajectory:Times must increase strictly" );
+  }
+
+  //----------------------------------------------------------------------------
+  Trajectory Trajectory::load( const std::filesystem::path& file )
+  {
+    const auto rows = CSVParser<4>()( file );
+    const SizeT numRows = rows.size() / 4;
+    std::vector<Real>   times( numRows );
+    std::vector<Vector> translations( numRows );
+    for( SizeT i = 0; i < numRows; ++i ) {
+      times[i]        = rows[4*i];
+      translations[i] = { rows[4*i+1], rows[4*i+2], rows[4*i+3] };
+    }
+    return Trajectory( std::move( times ), std::move( translations ) );
+  }
+
+  //----------------------------------------------------------------------------
+  Trajectory Trajectory::freeFall( Real gravity, SizeT axis, Real endt, SizeT numSamples )
+  {
+    numSamples = std::max<SizeT>( 2, numSamples );
+    std::vector<Real>   times( numSamples );
+    std::vector<Vector> translations( numSamples, Vector{ 0, 0, 0 } );
+    for( SizeT i = 0; i < numSamples; ++i ) {
+      const Real t = endt * i / (numSamples - 1);
+      times[i] = t;
+      translations[i][axis] = -0.5 * gravity * t * t;
+    }
+    return Trajectory( std::move( times ), std::move( translations ) );
+  }
+
+  //----------------------------------------------------------------------------
+  Trajectory Trajectory::make( const TrajectorySettings& settings, Real endt )
+  {
+    if( settings.type == "freeFall" )
+      return freeFall( settings.gravity, settings.axis, endt );
+    if( settings.type == "file" )
+      return load( settings.file );
+    const std::string msg = std::format( "ts::Trajectory::make:Unknown trajectory '{}'",
+                                         settings.type );
+    throw std::runtime_error(msg);
+  }
+
+  //----------------------------------------------------------------------------
+  auto Trajectory::operator()( Real t ) const -> Vector
+  {
+    if( t <= times_.front() ) return translations_.front();
+    if( t >= times_.back() )  return translations_.back();
+
+    const SizeT i = std::ranges::upper_bound( times_, t ) - times_.begin();
+    const Real  s = (t - times_[i-1]) / (times_[i] - times_[i-1]);
+    Vector U;
+    for( SizeT a = 0; a < 3; ++a )
+      U[a] = (1 - s) * translations_[i-1][a] + s * translations_[i][a];
+    return U;
+  }
+
+} // end namespace ts
@@ -0,0 +1,62 @@
+//------------------------------------------------------------------------------
+// <preamble>
+//
+//  ______
+// |
+// | TailSiT GmbH
+// | Graz, Austria
+//   www.tailsit.com
+//
+// </preamble>
+//------------------------------------------------------------------------------
+
+//! @author    Lars Kielhorn, Thomas Rüberg, Jürgen Zechner
+//! @date      2024
+//! @copyright TailSiT GmbH
+#pragma once
+
+// system ----------------------------------------------------------------------
+#include <array>
+#include <filesystem>
+#include <vector>
+
+// own -------------------------------------------------------------------------
+#include "types.hpp"
+#include "Settings.hpp"
+
+//------------------------------------------------------------------------------
+namespace ts {
+
+  class Trajectory;
+
+}
+
+//------------------------------------------------------------------------------
+/** Rigid translation U(t), tabulated and linearly interpolated.
+ *
+ *  Outside the tabulated interval U is held at the first and last sample.
+ */
+class ts::Trajectory
+{
+public:
+  using Vector = std::array<Real,3>;
+
+private:
+  std::vector<Real>   times_;        //!< strictly increasing
+  std::vector<Vector> translations_;
+
+public:
+  Trajectory( std::vector<Real> times, std::vector<Vector> translations );
+
+  //! t,U0,U1,U2 rows, e.g. a recorded run
+  static Trajectory load( const std::filesystem::path& file );
+
+  //! U[axis] = -g t^2 / 2 on [0,endt], numSamples samples
+  static Trajectory freeFall( Real gravity, SizeT axis, Real endt, SizeT numSamples = 4096 );
+
+  //! as selected by the settings, covering at least [0,endt]
+  static Trajectory make( const TrajectorySettings& settings, Real endt );
+
+  Vector operator()( Real t ) const;
+
+}; // end class Trajectory
@@ -0,0 +1,120 @@
+//------------------------------------------------------------------------------
+// <preamble>
+//
+//  ______
+// |
+// | TailSiT GmbH
+// | Graz, Austria
+//   www.tailsit.com
+//
+// </preamble>
+//------------------------------------------------------------------------------
+
+//! @author    Lars Kielhorn, Thomas Rüberg, Jürgen Zechner
+//! @date      2024
+//! @copyright TailSiT GmbH
+
+// system ----------------------------------------------------------------------
+#include <algorithm>
+#include <array>
+#include <limits>
+#include <utility>
+
+// own -------------------------------------------------------------------------
+#include "VertexOrdering.hpp"
+
+//------------------------------------------------------------------------------
+namespace {
+
+  static constexpr unsigned numBits = 21; // per axis, 63 bits of key
+
+  //! the lower 21 bits of v, spread to every third bit
+  std::uint64_t spread( std::uint32_t v )
+  {
+    std::uint64_t x = v & 0x1fffff;
+    x = (x | x << 32) & 0x1f00000000ffff;
+    x = (x | x << 16) & 0x1f0000ff0000ff;
+    x = (x | x <<  8) & 0x100f00f00f00f00f;
+    x = (x | x <<  4) & 0x10c30c30c30c30c3;
+    x = (x | x <<  2) & 0x1249249249249249;
+    return x;
+  }
+
+} // end anonymous namespace
+
+//------------------------------------------------------------------------------
+namespace ts {
+
+  //----------------------------------------------------------------------------
+  std::uint64_t mortonKey( std::uint32_t x, std::uint32_t y, std::uint32_t z )
+  {
+    return spread(x) << 2 | spread(y) << 1 | spread(z);
+  }
+
+  //----------------------------------------------------------------------------
+  std::uint64_t hilbertKey( std::uint32_t x, std::uint32_t y, std::uint32_t z )
+  {
+    // Skilling, "Programming the Hilbert curve" (2004): axes to transpose
+    std::array<std::uint32_t,3> X = { x, y, z };
+    const std::uint32_t M = 1u << (numBits - 1);
+    for( std::uint32_t Q = M; Q > 1; Q >>= 1 ) {
+      const std::uint32_t P = Q - 1;
+      for( auto& Xi : X ) {
+        if( Xi & Q ) X[0] ^= P;
+        else {
+          const std::uint32_t t = (X[0] ^ Xi) & P;
+          X[0] ^= t;
+          Xi   ^= t;
+        }
+      }
+    }
+    // Gray encode
+    X[1] ^= X[0];
+    X[2] ^= X[1];
+    std::uint32_t t = 0;
+    for( std::uint32_t Q = M; Q > 1; Q >>= 1 )
+      if( X[2] & Q ) t ^= Q - 1;
+    for( auto& Xi : X ) Xi ^= t;
+
+    // the transpose holds the key bits interleaved, most significant first
+    return mortonKey( X[0], X[1], X[2] );
+  }
+
+  //----------------------------------------------------------------------------
+  std::vector<SizeT> spaceFillingOrder( std::span<const Real>    coords,
+                                        Settings::VertexOrdering ordering )
+  {
+    static constexpr SizeT dim = 3;
+    if( ordering == Settings::VertexOrdering::input ) return {};
+    const SizeT numVertices = coords.size() / dim;
+
+    // common scale of the bounding box, so that the cells are cubes
+    std::array<Real,dim> lo, hi;
+    lo.fill( std::numeric_limits<Real>::max() );
+    hi.fill( std::numeric_limits<Real>::lowest() );
+    for( SizeT i = 0; i < numVertices; ++i )
+      for( SizeT a = 0; a < dim; ++a ) {
+        lo[a] = std::min( lo[a], coords[dim*i + a] );
+        hi[a] = std::max( hi[a], coords[dim*i + a] );
+      }
+    Real extent = 0;
+    for( SizeT a = 0; a < dim; ++a ) extent = std::max( extent, hi[a] - lo[a] );
+    const Real scale = extent > 0 ? Real( (1u << numBits) - 1 ) / extent : Real(0);
+
+    std::vector<std::pair<std::uint64_t,SizeT>> keys( numVertices );
+    for( SizeT i = 0; i < numVertices; ++i ) {
+      std::array<std::uint32_t,dim> q;
+      for( SizeT a = 0; a < dim; ++a )
+        q[a] = static_cast<std::uint32_t>( (coords[dim*i + a] - lo[a]) * scale );
+      keys[i] = { ordering == Settings::VertexOrdering::morton ? mortonKey( q[0], q[1], q[2] )
+                                                               : hilbertKey( q[0], q[1], q[2] ),
+                  i };
+    }
+    std::ranges::sort( keys );
+
+    std::vector<SizeT> order( numVertices );
+    std::ranges::transform( keys, order.begin(), []( const auto& key ) { return key.second; } );
+    return order;
+  }
+
+} // end namespace ts
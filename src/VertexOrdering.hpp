@@ -0,0 +1,49 @@
+//------------------------------------------------------------------------------
+// <preamble>
+//
+//  ______
+// |
+// | TailSiT GmbH
+// | Graz, Austria
+//   www.tailsit.com
+//
+// </preamble>
+//------------------------------------------------------------------------------
+
+//! @author    Lars Kielhorn, Thomas Rüberg, Jürgen Zechner
+//! @date      2024
+//! @copyright TailSiT GmbH
+#pragma once
+
+// system ----------------------------------------------------------------------
+#include <cstdint>
+#include <span>
+#include <vector>
+
+// own -------------------------------------------------------------------------
+#include "types.hpp"
+#include "Settings.hpp"
+
+//------------------------------------------------------------------------------
+namespace ts {
+
+  //----------------------------------------------------------------------------
+  /** Vertices sorted along a space-filling curve through their bounding box,
+   *  so that neighbours in space are close in memory. The coordinates are
+   *  quantized to 21 bits per axis on a common scale. Hilbert curves keep
+   *  consecutive vertices adjacent; Morton (Z-order) curves jump at the
+   *  octant boundaries but are cheaper to compute.
+   *
+   *  @return order[i], the input vertex at position i; empty for
+   *          VertexOrdering::input
+   */
+  std::vector<SizeT> spaceFillingOrder( std::span<const Real>    coords,
+                                        Settings::VertexOrdering ordering );
+
+  //! key of the quantized point (x, y, z) on the Morton curve
+  std::uint64_t mortonKey( std::uint32_t x, std::uint32_t y, std::uint32_t z );
+
+  //! key of the quantized point (x, y, z) on the Hilbert curve
+  std::uint64_t hilbertKey( std::uint32_t x, std::uint32_t y, std::uint32_t z );
+
+}
@@ -0,0 +1,197 @@
+//------------------------------------------------------------------------------
+// <preamble>
+//
+//  ______
+// |
+// | TailSiT GmbH
+// | Graz, Austria
+//   www.tailsit.com
+//
+// </preamble>
+//------------------------------------------------------------------------------
+
+//! @author    Lars Kielhorn, Thomas Rüberg, Jürgen Zechner
+//! @date      2024
+//! @copyright TailSiT GmbH
+
+// system ----------------------------------------------------------------------
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <stdexcept>
+#include <utility>
+
+// own -------------------------------------------------------------------------
+#include "VoxelDecimation.hpp"
+
+//------------------------------------------------------------------------------
+namespace {
+
+  static constexpr ts::SizeT dim = 3;
+
+  using Cell = std::array<std::int64_t,dim>;
+
+  //! the voxel of every point, with the point's index
+  std::vector<std::pair<Cell,ts::SizeT>> sortedCells( std::span<const ts::Real> coords,
+                                                      ts::Real                  voxelSize )
+  {
+    const ts::SizeT numPoints = coords.size() / dim;
+    std::vector<std::pair<Cell,ts::SizeT>> cells( numPoints );
+    for( ts::SizeT i = 0; i < numPoints; ++i ) {
+      for( ts::SizeT a = 0; a < dim; ++a )
+        cells[i].first[a] = static_cast<std::int64_t>( std::floor( coords[dim*i + a] / voxelSize ) );
+      cells[i].second = i;
+    }
+    std::ranges::sort( cells );
+    return cells;
+  }
+
+  //! occupied voxels
+  ts::SizeT numOccupied( std::span<const ts::Real> coords, ts::Real voxelSize )
+  {
+    static constexpr unsigned numBits = 21;
+    const ts::SizeT numPoints = coords.size() / dim;
+    if( numPoints == 0 ) return 0;
+
+    // cells packed into 63 bits if their range allows, else compared whole
+    Cell lo, hi;
+    for( ts::SizeT a = 0; a < dim; ++a ) {
+      ts::Real min = coords[a], max = coords[a];
+      for( ts::SizeT i = 1; i < numPoints; ++i ) {
+        min = std::min( min, coords[dim*i + a] );
+        max = std::max( max, coords[dim*i + a] );
+      }
+      lo[a] = static_cast<std::int64_t>( std::floor( min / voxelSize ) );
+      hi[a] = static_cast<std::int64_t>( std::floor( max / voxelSize ) );
+      if( hi[a] - lo[a] >= (std::int64_t(1) << numBits) ) {
+        const auto cells = sortedCells( coords, voxelSize );
+        ts::SizeT count = 0;
+        for( ts::SizeT i = 0; i < cells.size(); ++i )
+          count += i == 0 || cells[i].first != cells[i-1].first;
+        return count;
+      }
+    }
+    std::vector<std::uint64_t> keys( numPoints );
+    for( ts::SizeT i = 0; i < numPoints; ++i ) {
+      std::uint64_t key = 0;
+      for( ts::SizeT a = 0; a < dim; ++a ) {
+        const auto c = static_cast<std::int64_t>( std::floor( coords[dim*i + a] / voxelSize ) );
+        key = key << numBits | static_cast<std::uint64_t>( c - lo[a] );
+      }
+      keys[i] = key;
+    }
+    std::ranges::sort( keys );
+    return static_cast<ts::SizeT>( std::ranges::distance( keys.begin(), std::ranges::unique( keys ).begin() ) );
+  }
+
+} // end anonymous namespace
+
+//------------------------------------------------------------------------------
+namespace ts {
+
+  //----------------------------------------------------------------------------
+  VoxelDecimation::VoxelDecimation( std::span<const Real>     coords,
+                                    const DecimationSettings& settings,
+                                    const Communicator&       comm )
+    : voxelSize_(0)
+    , maxDistance_(0)
+    , points_()
+    , coords_()
+    , vertexMap_()
+    , counts_()
+  {
+    if( !settings.enabled ) {
+      points_ = coords;
+      return;
+    }
+    if( settings.voxelSize > 0 )
+      voxelSize_ = settings.voxelSize;
+    else if( settings.targetCount > 0 ) {
+      // largest extent of all ranks' points as a start
+      std::array<Real,1> extent = { 0 };
+      for( SizeT a = 0; a < dim; ++a ) {
+        Real lo = 0, hi = 0;
+        for( SizeT i = 0; i < coords.size() / dim; ++i ) {
+          lo = i ? std::min( lo, coords[dim*i + a] ) : coords[dim*i + a];
+          hi = i ? std::max( hi, coords[dim*i + a] ) : coords[dim*i + a];
+        }
+        extent[0] = std::max( extent[0], hi - lo );
+      }
+      comm.allReduceMax( extent );
+      if( !( extent[0] > 0 ) ) extent[0] = 1;
+
+      // the count is not monotonic in the size: keep the size closest to
+      // the target seen
+      const Real target = static_cast<Real>( settings.targetCount );
+      SizeT best = 0;
+      const auto count = [&]( Real h ) {
+        const SizeT n = comm.allReduceSum( numOccupied( coords, h ) );
+        if( n <= settings.targetCount && ( n > best || voxelSize_ == 0 ) ) {
+          best       = n;
+          voxelSize_ = h;
+        }
+        return static_cast<Real>( n );
+      };
+
+      // bracket the size, from a first guess as for a surface ...
+      Real hi  = extent[0] * std::sqrt( count( extent[0] ) / target );
+      Real nHi = count( hi );
+      Real lo = hi, nLo = nHi;
+      while( nHi > target ) {
+        // the grid is anchored at the origin: a cloud around it needs 8 voxels
+        lo  = hi;
+        nLo = nHi;
+        hi *= 2;
+        if( hi > extent[0] * 1e6 )
+          throw std::runtime_error( "ts::VoxelDecimation::VoxelDecimation:targetCount not reachable" );
+        nHi = count( hi );
+      }
+      while( nLo <= target && lo > hi * 1e-9 ) {
+        lo /= 2;
+        nLo = count( lo );
+      }
+
+      // ... then interpolate log(count) over log(size)
+      for( SizeT it = 0;
+           it < 20 && nLo > target && hi > lo * (1 + 1e-3) && best < 0.97 * target;
+           ++it ) {
+        const Real t = std::clamp( std::log( nLo / target ) / std::log( nLo / std::max<Real>( nHi, 1 ) ),
+                                   Real(0.1), Real(0.9) );
+        const Real h = lo * std::pow( hi / lo, t );
+        const Real n = count( h );
+        if( n > target ) { lo = h; nLo = n; }
+        else             { hi = h; nHi = n; }
+      }
+    }
+    else
+      throw std::runtime_error( "ts::VoxelDecimation::VoxelDecimation:Neither voxelSize nor targetCount" );
+
+    // one vertex per run of equal cells, at the centroid of its points
+    const auto cells = sortedCells( coords, voxelSize_ );
+    vertexMap_.resize( cells.size() );
+    for( SizeT i = 0; i < cells.size(); ++i ) {
+      if( i == 0 || cells[i].first != cells[i-1].first ) {
+        coords_.insert( coords_.end(), dim, Real(0) );
+        counts_.push_back( 0 );
+      }
+      const SizeT v = counts_.size() - 1;
+      const SizeT p = cells[i].second;
+      for( SizeT a = 0; a < dim; ++a ) coords_[dim*v + a] += coords[dim*p + a];
+      ++counts_[v];
+      vertexMap_[p] = v;
+    }
+    for( SizeT v = 0; v < counts_.size(); ++v )
+      for( SizeT a = 0; a < dim; ++a ) coords_[dim*v + a] /= static_cast<Real>( counts_[v] );
+
+    for( SizeT p = 0; p < vertexMap_.size(); ++p ) {
+      Real d2 = 0;
+      for( SizeT a = 0; a < dim; ++a ) {
+        const Real d = coords[dim*p + a] - coords_[dim*vertexMap_[p] + a];
+        d2 += d*d;
+      }
+      maxDistance_ = std::max( maxDistance_, std::sqrt( d2 ) );
+    }
+  }
+
+} // end namespace ts
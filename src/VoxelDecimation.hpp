@@ -0,0 +1,82 @@
+//------------------------------------------------------------------------------
+// <preamble>
+//
+//  ______
+// |
+// | TailSiT GmbH
+// | Graz, Austria
+//   www.tailsit.com
+//
+// </preamble>
+//------------------------------------------------------------------------------
+
+//! @author    Lars Kielhorn, Thomas Rüberg, Jürgen Zechner
+//! @date      2024
+//! @copyright TailSiT GmbH
+#pragma once
+
+// system ----------------------------------------------------------------------
+#include <span>
+#include <vector>
+
+// own -------------------------------------------------------------------------
+#include "types.hpp"
+#include "Settings.hpp"
+#include "Communicator.hpp"
+
+//------------------------------------------------------------------------------
+namespace ts {
+
+  class VoxelDecimation;
+
+}
+
+//------------------------------------------------------------------------------
+/** A point cloud thinned on a voxel grid: every occupied voxel becomes one
+ *  vertex at the centroid of its points. The grid is anchored at the origin,
+ *  so ranks agree on it without communication; a voxel whose points lie on
+ *  several ranks gives a vertex on each of them. For a targetCount the
+ *  voxel size is searched (collectively) until the vertices of all ranks
+ *  come within 3 % below it, or as close as the grid allows. Disabled,
+ *  the vertices are the points; they are not copied, so coordinates() is
+ *  then valid only as long as the points given to the constructor.
+ *
+ *  Every input point keeps the index of its vertex, and every vertex the
+ *  number of its points, so that forces can be spread over the vertices in
+ *  proportion to the points they stand for.
+ */
+class ts::VoxelDecimation
+{
+private:
+  Real               voxelSize_;
+  Real               maxDistance_; //!< of a point from its vertex
+  std::span<const Real> points_; //!< the input points, disabled only
+  std::vector<Real>  coords_;    //!< the vertices, empty if disabled
+  std::vector<SizeT> vertexMap_; //!< input point -> vertex, empty if disabled
+  std::vector<SizeT> counts_;    //!< input points per vertex, empty if disabled
+
+public:
+  //! collective over comm if settings.targetCount is used
+  VoxelDecimation( std::span<const Real>     coords,
+                   const DecimationSettings& settings,
+                   const Communicator&       comm = {} );
+
+  bool enabled( ) const { return !vertexMap_.empty(); }
+
+  //! zero if disabled
+  Real voxelSize( ) const { return voxelSize_; }
+
+  //! largest distance of a point from its vertex
+  Real maxDistance( ) const { return maxDistance_; }
+
+  std::span<const Real> coordinates( ) const
+  {
+    return enabled() ? std::span<const Real>( coords_ ) : points_;
+  }
+
+  //! vertex of every input point, for diagnostics
+  std::span<const SizeT> vertexMap( ) const { return vertexMap_; }
+
+  std::span<const SizeT> counts( ) const { return counts_; }
+
+}; // end class VoxelDecimation
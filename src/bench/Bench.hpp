@@ -0,0 +1,147 @@
+//------------------------------------------------------------------------------
+// <preamble>
+//
+//  ______
+// |
+// | TailSiT GmbH
+// | Graz, Austria
+//   www.tailsit.com
+//
+// </preamble>
+//------------------------------------------------------------------------------
+
+//! @author    Lars Kielhorn, Thomas Rüberg, Jürgen Zechner
+//! @date      2024
+//! @copyright TailSiT GmbH
+#pragma once
+
+// system ----------------------------------------------------------------------
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <functional>
+#include <limits>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// own -------------------------------------------------------------------------
+#include "../types.hpp"
+
+//------------------------------------------------------------------------------
+namespace ts {
+  namespace bench {
+
+    //--------------------------------------------------------------------------
+    struct Options
+    {
+      std::string           filter;      //!< run only cases containing this
+      std::vector<SizeT>    sizes;       //!< overrides the per case sizes
+      SizeT                 repetitions = 3;
+      std::filesystem::path workDir = std::filesystem::temp_directory_path();
+      std::filesystem::path jsonFile;    //!< machine readable copy of the results
+    };
+
+    //--------------------------------------------------------------------------
+    struct Result
+    {
+      std::string name;
+      std::string label;
+      SizeT       size;
+      SizeT       repetitions;
+      Real        minSeconds;
+      Real        meanSeconds;
+      Real        items;        //!< work items per repetition
+    };
+
+    class Context;
+
+    //--------------------------------------------------------------------------
+    struct Case
+    {
+      std::string                    name;
+      std::vector<SizeT>             sizes;
+      std::function<void(Context&)>  run;
+    };
+
+    std::vector<Case>& registry( );
+
+    //--------------------------------------------------------------------------
+    /** Registers a case at static initialization time */
+    struct Registrar
+    {
+      Registrar( std::string name,
+                 std::vector<SizeT> sizes,
+                 std::function<void(Context&)> run )
+      {
+        registry().push_back( { std::move(name), std::move(sizes), std::move(run) } );
+      }
+    };
+
+    //--------------------------------------------------------------------------
+    /** Handed to every case; measures callables and collects the results */
+    class Context
+    {
+    private:
+      const Options&       options_;
+      std::vector<Result>& results_;
+      std::string          name_;
+      SizeT                size_;
+
+    public:
+      Context( const Options& options,
+               std::vector<Result>& results,
+               std::string name,
+               SizeT size )
+        : options_(options), results_(results), name_(std::move(name)), size_(size)
+      {}
+
+      SizeT size( ) const { return size_; }
+      const Options& options( ) const { return options_; }
+      const std::filesystem::path& workDir( ) const { return options_.workDir; }
+
+      /** Run f repetitions() times; items is the work done per call */
+      template< typename F >
+      void measure( std::string_view label, Real items, F&& f );
+    };
+
+    //--------------------------------------------------------------------------
+    /** @name fixtures shared between cases */
+    //@{
+    /** Point cloud with numRows rows in the layout of magnetPointCloud.csv:
+     *  a cylinder surface. The file is reused if it already exists. */
+    std::filesystem::path writeCloud( const std::filesystem::path& dir, SizeT numRows );
+    //@}
+
+    //--------------------------------------------------------------------------
+    /** Keep the optimizer from discarding a result */
+    template< typename T >
+    inline void doNotOptimize( const T& value )
+    {
+      asm volatile( "" : : "g"(&value) : "memory" );
+    }
+
+    //==========================================================================
+    //
+    // IMPLEMENTATION
+    //
+    //==========================================================================
+    template< typename F >
+    void Context::measure( std::string_view label, Real items, F&& f )
+    {
+      using Clock = std::chrono::steady_clock;
+      const SizeT reps = std::max<SizeT>( 1, options_.repetitions );
+      Real minT = std::numeric_limits<Real>::max();
+      Real sumT = 0;
+      for( SizeT r = 0; r < reps; ++r ) {
+        const auto t0 = Clock::now();
+        f();
+        const std::chrono::duration<Real> dt = Clock::now() - t0;
+        minT = std::min( minT, dt.count() );
+        sumT += dt.count();
+      }
+      results_.push_back( { name_, std::string(label), size_, reps, minT, sumT/reps, items } );
+    }
+
+  } // end namespace bench
+} // end namespace ts
@@ -0,0 +1,91 @@
+//------------------------------------------------------------------------------
+// <preamble>
+//
+//  ______
+// |
+// | TailSiT GmbH
+// | Graz, Austria
+//   www.tailsit.com
+//
+// </preamble>
+//------------------------------------------------------------------------------
+
+//! @author    Lars Kielhorn, Thomas Rüberg, Jürgen Zechner
+//! @date      2024
+//! @copyright TailSiT GmbH
+
+// system ----------------------------------------------------------------------
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// own -------------------------------------------------------------------------
+#include "Bench.hpp"
+#include "../ForceGenerator.hpp"
+
+//------------------------------------------------------------------------------
+namespace {
+
+  //----------------------------------------------------------------------------
+  /** Checkpoint save/reload cost against mesh size, per implicit window */
+  void benchCheckpoint( ts::bench::Context& context )
+  {
+    static constexpr ts::SizeT numWindows = 16;
+    const ts::SizeT n = context.size();
+    std::vector<ts::Real> coords( 3*n, 1. ), displacements( 3*n, 1e-3 );
+    const ts::Real items = static_cast<ts::Real>( numWindows );
+
+    // what saveOldState/reloadOldState/endTimeStep used to do:
+    // allocate and copy on save, copy on reload, free at the end of the window
+    struct State { std::vector<ts::Real> displacements; };
+    std::vector<ts::Real> current( 3*n );
+    auto legacySet = [&]() { std::ranges::copy( displacements, current.begin() ); };
+    context.measure( "legacy save", items, [&]() {
+      for( ts::SizeT w = 0; w < numWindows; ++w ) {
+        auto state = std::make_unique<State>( State{ current } );
+        legacySet();
+        ts::bench::doNotOptimize( state->displacements.data() );
+      }
+    } );
+    context.measure( "legacy save+reload+set", items, [&]() {
+      for( ts::SizeT w = 0; w < numWindows; ++w ) {
+        auto state = std::make_unique<State>( State{ current } );
+        legacySet();
+        current = state->displacements;
+        legacySet();
+        ts::bench::doNotOptimize( current.data() );
+      }
+    } );
+
+    for( const auto inField : { "Displacements", "DisplacementDeltas" } ) {
+      ts::Settings settings;
+      settings.inField     = inField;
+      settings.samplesFile = (context.workDir() / "ts_bench_forces.csv").string();
+      ts::ForceGenerator solver( coords, settings );
+      solver.start();
+
+      const std::string label = inField == std::string_view( "Displacements" )
+                              ? "swap" : "copy";
+      context.measure( label + " save", items, [&]() {
+        for( ts::SizeT w = 0; w < numWindows; ++w ) {
+          solver.saveOldState();
+          solver.set( inField, displacements );
+        }
+      } );
+      context.measure( label + " save+reload+set", items, [&]() {
+        for( ts::SizeT w = 0; w < numWindows; ++w ) {
+          solver.saveOldState();
+          solver.set( inField, displacements );
+          solver.reloadOldState();
+          solver.set( inField, displacements );
+        }
+      } );
+      solver.stop();
+    }
+  }
+
+  const ts::bench::Registrar checkpoint( "checkpoint", { 10'000, 100'000, 1'000'000 }, benchCheckpoint );
+
+} // end anonymous namespace
@@ -0,0 +1,110 @@
+//------------------------------------------------------------------------------
+// <preamble>
+//
+//  ______
+// |
+// | TailSiT GmbH
+// | Graz, Austria
+//   www.tailsit.com
+//
+// </preamble>
+//------------------------------------------------------------------------------
+
+//! @author    Lars Kielhorn, Thomas Rüberg, Jürgen Zechner
+//! @date      2024
+//! @copyright TailSiT GmbH
+
+// system ----------------------------------------------------------------------
+#include <algorithm>
+#include <format>
+#include <numeric>
+#include <stdexcept>
+#include <vector>
+
+// own -------------------------------------------------------------------------
+#include "Bench.hpp"
+#include "../Coupling.hpp"
+#include "../CSVParser.hpp"
+#include "../ForceGenerator.hpp"
+#include "../ReplayParticipant.hpp"
+#include "../SigmoidForce.hpp"
+#include "../Trajectory.hpp"
+
+//------------------------------------------------------------------------------
+namespace {
+
+  //----------------------------------------------------------------------------
+  /** The whole adapter run from parsing to stop, coupled to a stand-in
+   *  participant replaying a falling magnet; items are iterations */
+  void benchCoupling( ts::bench::Context& context )
+  {
+    static constexpr ts::SizeT numWindows = 100;
+    const auto file = ts::bench::writeCloud( context.workDir(), context.size() );
+
+    ts::Settings settings;
+    settings.samplesFile = (context.workDir() / "ts_bench_forces.csv").string();
+    const ts::SigmoidForce force;
+    const auto trajectory = ts::Trajectory::freeFall( 9.81, 2, numWindows * settings.dt );
+
+    for( ts::SizeT numIterations : { 1, 4, 0 } ) {
+      // last round: implicit again, but with phase timers and trace
+      settings.profiling.enabled   = numIterations == 0;
+      settings.profiling.traceFile = numIterations == 0
+                                   ? (context.workDir() / "ts_bench_trace.json").string()
+                                   : std::string();
+      const std::string label = numIterations == 1 ? std::string( "explicit" )
+                              : numIterations == 0 ? std::string( "implicit 4 it profiled" )
+                              : std::format( "implicit {} it", numIterations );
+      if( numIterations == 0 ) numIterations = 4;
+      const ts::Real items = static_cast<ts::Real>( numWindows * numIterations );
+      context.measure( label, items, [&]() {
+        const auto coords = ts::CSVParser<3>()( file );
+        ts::ForceGenerator solver( coords, settings );
+        ts::ReplayParticipant participant( trajectory, settings.dt, numWindows, numIterations );
+
+        solver.start();
+        std::vector<ts::Int> vertexIds( solver.numCoordinates() );
+        std::iota( vertexIds.begin(), vertexIds.end(), 0 );
+        ts::couple( participant, solver, settings, vertexIds, force );
+        solver.stop();
+        if( settings.profiling.enabled )
+          solver.profiler().writeTrace( settings.profiling.traceFile );
+        ts::bench::doNotOptimize( participant.forceSum() );
+      } );
+    }
+
+    // implicit again, on a tenth of the vertices
+    settings.profiling  = {};
+    settings.decimation = { true, 0, std::max<ts::SizeT>( 8, context.size() / 10 ) };
+    context.measure( "implicit 4 it decimated", numWindows * 4, [&]() {
+      const auto coords = ts::CSVParser<3>()( file );
+      ts::ForceGenerator solver( coords, settings );
+      ts::ReplayParticipant participant( trajectory, settings.dt, numWindows, 4 );
+
+      solver.start();
+      std::vector<ts::Int> vertexIds( solver.numCoordinates() );
+      std::iota( vertexIds.begin(), vertexIds.end(), 0 );
+      ts::couple( participant, solver, settings, vertexIds, force );
+      solver.stop();
+      ts::bench::doNotOptimize( participant.forceSum() );
+    } );
+
+    // forces for all points do not fit the decimated vertices
+    {
+      const auto coords = ts::CSVParser<3>()( file );
+      const ts::ForceGenerator solver( coords, settings );
+      std::vector<ts::Real> forces( coords.size() );
+      bool refused = false;
+      try {
+        solver.get( "Forces", forces );
+      } catch( const std::runtime_error& ) {
+        refused = true;
+      }
+      if( !refused && solver.numCoordinates() * 3 != coords.size() )
+        throw std::runtime_error( "ts::bench::coupling:Decimated get accepted forces for all points" );
+    }
+  }
+
+  const ts::bench::Registrar coupling( "coupling", { 1'000, 10'000, 100'000 }, benchCoupling );
+
+} // end anonymous namespace
@@ -0,0 +1,105 @@
+//------------------------------------------------------------------------------
+// <preamble>
+//
+//  ______
+// |
+// | TailSiT GmbH
+// | Graz, Austria
+//   www.tailsit.com
+//
+// </preamble>
+//------------------------------------------------------------------------------
+
+//! @author    Lars Kielhorn, Thomas Rüberg, Jürgen Zechner
+//! @date      2024
+//! @copyright TailSiT GmbH
+
+// system ----------------------------------------------------------------------
+#include <array>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+// own -------------------------------------------------------------------------
+#include "Bench.hpp"
+#include "../CSVParser.hpp"
+
+//------------------------------------------------------------------------------
+namespace {
+
+  //----------------------------------------------------------------------------
+  /** The stringstream based parser that CSVParser replaced, kept as reference */
+  template< ts::SizeT NUM_COLS, typename T = ts::Real >
+  struct LegacyCSVParser
+  {
+    std::vector<T> operator()( const std::filesystem::path& file,
+                               char delimiter   = ',',
+                               char commentChar = '#' ) const
+    {
+      std::ifstream is( file );
+      if( !is.is_open() )
+        throw std::runtime_error( "LegacyCSVParser:File '" + file.string() + "' not found" );
+
+      std::string line;
+      std::vector<T> resval;
+      while( std::getline( is, line ) ) {
+        if( !line.empty() && line[0] == commentChar ) continue;
+        std::istringstream stream(line);
+        std::string val;
+        while( std::getline( stream, val, delimiter ) ) {
+          std::istringstream iss(val);
+          std::copy( std::istream_iterator<T>(iss),
+                     std::istream_iterator<T>(),
+                     std::back_inserter( resval ) );
+        }
+      }
+      return resval;
+    }
+  };
+
+  //----------------------------------------------------------------------------
+  /** The row formats the legacy parser took: a trailing delimiter, CR LF,
+   *  blanks and '+' signs; more than one trailing delimiter is an error */
+  void checkFormats( )
+  {
+    const ts::CSVParser<3> parser;
+    const auto rows = parser.parse( "# X, Y, Z\n1,2,3,\n+4, 5 ,6\r\n7,8,9, \r\n\n" );
+    if( rows != ts::CSVParser<3>::Vector{ 1, 2, 3, 4, 5, 6, 7, 8, 9 } )
+      throw std::runtime_error( "ts::bench::csvParser:Rows differ from the legacy format" );
+
+    bool refused = false;
+    try {
+      parser.parse( "1,2,3,,\n" );
+    } catch( const std::runtime_error& ) {
+      refused = true;
+    }
+    if( !refused )
+      throw std::runtime_error( "ts::bench::csvParser:Accepted two trailing delimiters" );
+  }
+
+  //----------------------------------------------------------------------------
+  void benchCSV( ts::bench::Context& context )
+  {
+    checkFormats();
+
+    const auto file = ts::bench::writeCloud( context.workDir(), context.size() );
+    const ts::Real numRows = static_cast<ts::Real>( context.size() );
+
+    context.measure( "legacy", numRows, [&]() {
+      ts::bench::doNotOptimize( LegacyCSVParser<3>()( file ) );
+    } );
+    context.measure( "mmap-serial", numRows, [&]() {
+      ts::bench::doNotOptimize( ts::CSVParser<3>{ .numThreads = 1 }( file ) );
+    } );
+    context.measure( "mmap-parallel", numRows, [&]() {
+      ts::bench::doNotOptimize( ts::CSVParser<3>()( file ) );
+    } );
+  }
+
+  const ts::bench::Registrar csv( "csvParser", { 100'000, 1'000'000, 10'000'000 }, benchCSV );
+
+} // end anonymous namespace
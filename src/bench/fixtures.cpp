@@ -0,0 +1,52 @@
+//------------------------------------------------------------------------------
+// <preamble>
+//
+//  ______
+// |
+// | TailSiT GmbH
+// | Graz, Austria
+//   www.tailsit.com
+//
+// </preamble>
+//------------------------------------------------------------------------------
+
+//! @author    Lars Kielhorn, Thomas Rüberg, Jürgen Zechner
+//! @date      2024
+//! @copyright TailSiT GmbH
+
+// system ----------------------------------------------------------------------
+#include <cmath>
+#include <format>
+#include <fstream>
+#include <iterator>
+#include <string>
+
+// own -------------------------------------------------------------------------
+#include "Bench.hpp"
+
+//------------------------------------------------------------------------------
+namespace ts {
+  namespace bench {
+
+    //--------------------------------------------------------------------------
+    std::filesystem::path writeCloud( const std::filesystem::path& dir, SizeT numRows )
+    {
+      const auto file = dir / std::format( "ts_bench_cloud_{}.csv", numRows );
+      if( std::filesystem::exists( file ) ) return file;
+
+      std::ofstream out( file );
+      out << "# X, Y, Z\n";
+      std::string buffer;
+      for( SizeT i = 0; i < numRows; ++i ) {
+        const Real phi = 2.39996322972865332 * i;
+        const Real z   = 7.62e-2 * (i % 1024) / 1024.;
+        std::format_to( std::back_inserter( buffer ), "{:.8e},{:.8e},{:.8e}\n",
+                        3e-3 * std::cos(phi), 3e-3 * std::sin(phi), z );
+        if( buffer.size() > (1u << 20) ) { out << buffer; buffer.clear(); }
+      }
+      out << buffer;
+      return file;
+    }
+
+  } // end namespace bench
+} // end namespace ts
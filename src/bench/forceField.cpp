@@ -0,0 +1,81 @@
+//------------------------------------------------------------------------------
+// <preamble>
+//
+//  ______
+// |
+// | TailSiT GmbH
+// | Graz, Austria
+//   www.tailsit.com
+//
+// </preamble>
+//------------------------------------------------------------------------------
+
+//! @author    Lars Kielhorn, Thomas Rüberg, Jürgen Zechner
+//! @date      2024
+//! @copyright TailSiT GmbH
+
+// system ----------------------------------------------------------------------
+#include <array>
+#include <cmath>
+#include <format>
+#include <span>
+#include <string>
+#include <vector>
+
+// own -------------------------------------------------------------------------
+#include "Bench.hpp"
+#include "../CSVParser.hpp"
+#include "../ForceField.hpp"
+#include "../Parallel.hpp"
+#include "../SigmoidForce.hpp"
+#include "../Simd.hpp"
+
+//------------------------------------------------------------------------------
+namespace {
+
+  //----------------------------------------------------------------------------
+  /** Per-vertex force field of the sigmoid over the magnet cloud, displaced
+   *  into the transition at 0.025: SigmoidForce::eval called per vertex
+   *  against evalForceField, serial and threaded, which runs the SIMD
+   *  kernel if the build has a vector ISA; items are vertices */
+  void benchForceField( ts::bench::Context& context )
+  {
+    const auto coords = ts::CSVParser<3>()( ts::bench::writeCloud( context.workDir(), context.size() ) );
+    const ts::SizeT n = coords.size() / 3;
+    std::vector<ts::Real> displacements( coords.size(), 0 );
+    for( ts::SizeT i = 0; i < n; ++i ) displacements[3*i + 2] = -0.025;
+    std::vector<ts::Real> forces( coords.size() );
+    const std::array<ts::Real,3> center = { 0, 0, 7.62e-2 / 2 };
+    const ts::Real weight = 1. / n;
+    const ts::SigmoidForce force;
+
+    context.measure( "eval per vertex", static_cast<ts::Real>( n ), [&]() {
+      for( ts::SizeT i = 0; i < n; ++i ) {
+        const ts::Real s = std::abs( coords[3*i + 2] + displacements[3*i + 2] - center[2] );
+        forces[3*i] = forces[3*i + 1] = 0;
+        forces[3*i + 2] = weight * force.eval( s );
+      }
+      ts::bench::doNotOptimize( forces.back() );
+    } );
+
+    for( const ts::SizeT numThreads : { 1, 0 } ) {
+      ts::parallel::ThreadPool pool( numThreads );
+      context.measure( std::format( "{}, {}",
+                                    ts::simd::Pack::size > 1
+                                      ? std::format( "{} kernel", ts::simd::Pack::isa )
+                                      : std::string( "field" ),
+                                    numThreads == 1 ? "serial" : "threaded" ),
+                       static_cast<ts::Real>( n ), [&]() {
+        const auto total = ts::evalForceField( force, 0., center,
+                                               std::span<const ts::Real>( coords ),
+                                               std::span<const ts::Real>( displacements ),
+                                               weight, std::span<ts::Real>( forces ), pool );
+        ts::bench::doNotOptimize( total );
+      } );
+    }
+  }
+
+  const ts::bench::Registrar forceField( "forceField", { 10'000, 100'000, 1'000'000 },
+                                         benchForceField );
+
+} // end anonymous namespace
@@ -0,0 +1,100 @@
+//------------------------------------------------------------------------------
+// <preamble>
+//
+//  ______
+// |
+// | TailSiT GmbH
+// | Graz, Austria
+//   www.tailsit.com
+//
+// </preamble>
+//------------------------------------------------------------------------------
+
+//! @author    Lars Kielhorn, Thomas Rüberg, Jürgen Zechner
+//! @date      2024
+//! @copyright TailSiT GmbH
+
+// system ----------------------------------------------------------------------
+#include <cmath>
+#include <stdexcept>
+#include <vector>
+
+// own -------------------------------------------------------------------------
+#include "Bench.hpp"
+#include "../ForceGenerator.hpp"
+#include "../SigmoidForce.hpp"
+
+//------------------------------------------------------------------------------
+namespace {
+
+  //----------------------------------------------------------------------------
+  /** The ForceGenerator calls of one implicit iteration, each on its own */
+  void benchForceGenerator( ts::bench::Context& context )
+  {
+    static constexpr ts::SizeT numSamples = 1024;
+    const ts::SizeT n = context.size();
+    std::vector<ts::Real> coords( 3*n ), displacements( 3*n ), forces( 3*n ), other( 3*n );
+    for( ts::SizeT i = 0; i < n; ++i ) {
+      const ts::Real phi = 2.39996322972865332 * i;
+      coords[3*i]   = 3e-3 * std::cos(phi);
+      coords[3*i+1] = 3e-3 * std::sin(phi);
+      coords[3*i+2] = 7.62e-2 * (i % 1024) / 1024.;
+      displacements[3*i+2] = -2e-2;
+    }
+    const ts::Real items = static_cast<ts::Real>( n );
+
+    ts::Settings settings;
+    settings.samplesFile = (context.workDir() / "ts_bench_forces.csv").string();
+    ts::ForceGenerator solver( coords, settings );
+    const ts::SigmoidForce force;
+    solver.start();
+
+    context.measure( "set Displacements", items, [&]() {
+      solver.set( "Displacements", displacements );
+    } );
+    context.measure( "set DisplacementDeltas", items, [&]() {
+      solver.set( "DisplacementDeltas", displacements );
+    } );
+    // a field differing from the last one solved for, so that it is fitted
+    ts::Real shift = 0;
+    context.measure( "set+solve", items, [&]() {
+      displacements[2] = (shift = -shift + 1e-9);
+      solver.set( "Displacements", displacements );
+      solver.solveTimeStep( force );
+    } );
+    const ts::SizeT solved = solver.forcesVersion();
+    context.measure( "solve unchanged", items, [&]() {
+      solver.solveTimeStep( force );
+    } );
+    if( solver.forcesVersion() != solved )
+      throw std::runtime_error( "ts::bench::forceGenerator:Unchanged solves changed the forces" );
+    // alternating buffers, so that every call fills one
+    bool toggle = false;
+    context.measure( "get", items, [&]() {
+      toggle = !toggle;
+      solver.get( "Forces", toggle ? forces : other );
+      ts::bench::doNotOptimize( forces.data() );
+    } );
+    // as the coupling loop does it: forces of the version held are not fetched again
+    ts::SizeT version = 0;
+    context.measure( "get unchanged", items, [&]() {
+      if( solver.forcesVersion() != version ) {
+        solver.get( "Forces", forces );
+        version = solver.forcesVersion();
+      }
+      ts::bench::doNotOptimize( forces.data() );
+    } );
+    solver.stop();
+
+    // sampling and the final flush of the sample files
+    context.measure( "start+sample+stop", numSamples, [&]() {
+      solver.start();
+      solver.set( "Displacements", displacements );
+      for( ts::SizeT s = 0; s < numSamples; ++s ) solver.solveTimeStep( force, true );
+      solver.stop();
+    } );
+  }
+
+  const ts::bench::Registrar forceGenerator( "forceGenerator", { 10'000, 100'000, 1'000'000 }, benchForceGenerator );
+
+} // end anonymous namespace
@@ -0,0 +1,140 @@
+//------------------------------------------------------------------------------
+// <preamble>
+//
+//  ______
+// |
+// | TailSiT GmbH
+// | Graz, Austria
+//   www.tailsit.com
+//
+// </preamble>
+//------------------------------------------------------------------------------
+
+//! @author    Lars Kielhorn, Thomas Rüberg, Jürgen Zechner
+//! @date      2024
+//! @copyright TailSiT GmbH
+
+// system ----------------------------------------------------------------------
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <format>
+#include <span>
+#include <string>
+#include <vector>
+
+// own -------------------------------------------------------------------------
+#include "Bench.hpp"
+#include "../SigmoidForce.hpp"
+#include "../PolynomialForce.hpp"
+#include "../TabulatedForce.hpp"
+
+//------------------------------------------------------------------------------
+namespace {
+
+  //----------------------------------------------------------------------------
+  /** Sweep of the falling magnet: U2 in [-0.1,0], n evaluations per call */
+  template< typename FORCE >
+  void sweep( ts::bench::Context& context, std::string_view label, const FORCE& force )
+  {
+    const ts::SizeT n = context.size();
+    context.measure( label, static_cast<ts::Real>( n ), [&]() {
+      ts::RigidMotion motion;
+      std::array<ts::Real,3> F;
+      ts::Real sum = 0;
+      for( ts::SizeT i = 0; i < n; ++i ) {
+        motion.translation[2] = -0.1 * i / n;
+        force( 0., motion, F );
+        sum += F[2];
+      }
+      ts::bench::doNotOptimize( sum );
+    } );
+  }
+
+  //----------------------------------------------------------------------------
+  /** Helix around the falling magnet's axis: U0,U1 on a circle of radius
+   *  2e-3, U2 in [-0.1,0], n evaluations per call */
+  template< typename FORCE >
+  void helix( ts::bench::Context& context, std::string_view label, const FORCE& force )
+  {
+    const ts::SizeT n = context.size();
+    context.measure( label, static_cast<ts::Real>( n ), [&]() {
+      ts::RigidMotion motion;
+      std::array<ts::Real,3> F;
+      ts::Real sum = 0;
+      for( ts::SizeT i = 0; i < n; ++i ) {
+        const ts::Real phi = 0.01 * i;
+        motion.translation = { 2e-3 * std::cos( phi ), 2e-3 * std::sin( phi ), -0.1 * i / n };
+        force( 0., motion, F );
+        sum += F[0] + F[1] + F[2];
+      }
+      ts::bench::doNotOptimize( sum );
+    } );
+  }
+
+  //----------------------------------------------------------------------------
+  /** The sigmoid along U2 with a linear restoring force across it, so a
+   *  table of it varies over all three displacements */
+  struct Restoring
+  {
+    ts::SigmoidForce axial;
+    ts::Real         stiffness = 10;
+
+    std::array<ts::Real,3> eval( const std::array<ts::Real,3>& U ) const
+    {
+      return { -stiffness * U[0], -stiffness * U[1], axial.eval( std::abs( U[2] ) ) };
+    }
+
+    void operator()( ts::Real, const ts::RigidMotion& motion, std::span<ts::Real> F ) const
+    {
+      std::ranges::copy( eval( motion.translation ), F.begin() );
+    }
+  };
+
+  //----------------------------------------------------------------------------
+  void benchForceModel( ts::bench::Context& context )
+  {
+    using Grid          = ts::TabulatedForce::Grid;
+    using Interpolation = ts::TabulatedForce::Interpolation;
+
+    // tabulate the analytic model, as a forces.csv of a run would
+    const ts::SigmoidForce analytic;
+    std::vector<ts::Real> table;
+    for( ts::SizeT i = 0; i <= 2000; ++i ) {
+      const ts::Real U2 = -0.1 * i / 2000.;
+      table.insert( table.end(), { 0., 0., U2, 0., 0., analytic.eval( -U2 ) } );
+    }
+
+    sweep( context, "sigmoid", analytic );
+    sweep( context, "polynomial",
+           ts::PolynomialForce( { .coefficients = { 0.1, -1., 2., -3., 4., -5. } } ) );
+    for( const auto interpolation : { Interpolation::linear, Interpolation::cubic } )
+      sweep( context,
+             std::format( "table-1d-{}", interpolation == Interpolation::linear ? "linear" : "cubic" ),
+             ts::TabulatedForce( table, Grid::axial, interpolation, 0 ) );
+
+    // 5 x 5 x 81 rows over U0,U1 in [-3e-3,3e-3] and U2 in [-0.1,0]
+    const Restoring restoring;
+    std::vector<ts::Real> table3d;
+    for( ts::SizeT k = 0; k <= 80; ++k )
+      for( ts::SizeT j = 0; j <= 4; ++j )
+        for( ts::SizeT i = 0; i <= 4; ++i ) {
+          const std::array<ts::Real,3> U = { 1.5e-3 * (i - 2.), 1.5e-3 * (j - 2.), -0.1 * k / 80. };
+          const auto F = restoring.eval( U );
+          table3d.insert( table3d.end(), { U[0], U[1], U[2], F[0], F[1], F[2] } );
+        }
+
+    helix( context, "restoring", restoring );
+    for( const auto interpolation : { Interpolation::linear, Interpolation::cubic } ) {
+      const std::string variant = interpolation == Interpolation::linear ? "linear" : "cubic";
+      context.measure( "table-3d-" + variant + " load", 1., [&]() {
+        ts::bench::doNotOptimize( ts::TabulatedForce( table3d, Grid::cartesian, interpolation, 0 ) );
+      } );
+      helix( context, "table-3d-" + variant,
+             ts::TabulatedForce( table3d, Grid::cartesian, interpolation, 0 ) );
+    }
+  }
+
+  const ts::bench::Registrar force( "forceModel", { 1'000'000 }, benchForceModel );
+
+} // end anonymous namespace
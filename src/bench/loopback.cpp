@@ -0,0 +1,104 @@
+//------------------------------------------------------------------------------
+// <preamble>
+//
+//  ______
+// |
+// | TailSiT GmbH
+// | Graz, Austria
+//   www.tailsit.com
+//
+// </preamble>
+//------------------------------------------------------------------------------
+
+//! @author    Lars Kielhorn, Thomas Rüberg, Jürgen Zechner
+//! @date      2024
+//! @copyright TailSiT GmbH
+
+// system ----------------------------------------------------------------------
+#include <numeric>
+#include <string_view>
+#include <vector>
+
+// own -------------------------------------------------------------------------
+#include "Bench.hpp"
+#include "../Coupling.hpp"
+#include "../CSVParser.hpp"
+#include "../ForceGenerator.hpp"
+#include "../LoopbackParticipant.hpp"
+#include "../SigmoidForce.hpp"
+
+//------------------------------------------------------------------------------
+namespace {
+
+  //----------------------------------------------------------------------------
+  /** The adapter coupled in process to the rigid body it drives, explicit
+   *  and implicit; items are windows */
+  void benchLoopback( ts::bench::Context& context )
+  {
+    static constexpr ts::SizeT numWindows = 100;
+    using Scheme = ts::RigidBodySettings::Scheme;
+    const auto file = ts::bench::writeCloud( context.workDir(), context.size() );
+
+    ts::Settings settings;
+    settings.samplesFile = (context.workDir() / "ts_bench_forces.csv").string();
+    const ts::SigmoidForce force;
+
+    for( const Scheme scheme : { Scheme::serialExplicit, Scheme::parallelImplicit } ) {
+      ts::RigidBodySettings body;
+      body.scheme = scheme;
+      const auto label = scheme == Scheme::serialExplicit ? "serialExplicit" : "parallelImplicit";
+      context.measure( label, numWindows, [&]() {
+        const auto coords = ts::CSVParser<3>()( file );
+        ts::ForceGenerator solver( coords, settings );
+        ts::LoopbackParticipant participant( body, settings.dt, numWindows );
+
+        solver.start();
+        std::vector<ts::Int> vertexIds( solver.numCoordinates() );
+        std::iota( vertexIds.begin(), vertexIds.end(), 0 );
+        ts::couple( participant, solver, settings, vertexIds, force );
+        solver.stop();
+        ts::bench::doNotOptimize( participant.numIterations() );
+      } );
+    }
+  }
+
+  //----------------------------------------------------------------------------
+  /** Windows of 20 dt subcycled implicitly: in fixed steps of dt or in the
+   *  adaptive ones, both advanced one by one, or averaged over 20 substeps
+   *  in the adapter and advanced once; items are windows */
+  void benchSubcycling( ts::bench::Context& context )
+  {
+    static constexpr ts::SizeT numWindows  = 30;
+    static constexpr ts::SizeT numSubsteps = 20;
+    const auto file = ts::bench::writeCloud( context.workDir(), context.size() );
+    const ts::SigmoidForce force;
+
+    ts::RigidBodySettings body;
+    body.integrator = ts::RigidBodySettings::Integrator::rk4;
+    for( const auto variant : { "fixed", "adaptive", "averaged" } ) {
+      ts::Settings settings;
+      settings.dt          = 5e-4;
+      settings.samplesFile = (context.workDir() / "ts_bench_forces.csv").string();
+      settings.timeStep.adaptive   = variant == std::string_view( "adaptive" );
+      settings.timeStep.forceScale = 5.9e-2;
+      settings.subcycling.enabled     = variant == std::string_view( "averaged" );
+      settings.subcycling.numSubsteps = numSubsteps;
+      context.measure( variant, numWindows, [&]() {
+        const auto coords = ts::CSVParser<3>()( file );
+        ts::ForceGenerator solver( coords, settings );
+        ts::LoopbackParticipant participant( body, numSubsteps*settings.dt, numWindows );
+
+        solver.start();
+        std::vector<ts::Int> vertexIds( solver.numCoordinates() );
+        std::iota( vertexIds.begin(), vertexIds.end(), 0 );
+        ts::couple( participant, solver, settings, vertexIds, force );
+        solver.stop();
+        ts::bench::doNotOptimize( participant.numSteps() );
+      } );
+    }
+  }
+
+  const ts::bench::Registrar loopback( "loopback", { 1'000, 10'000, 100'000 }, benchLoopback );
+  const ts::bench::Registrar subcycling( "subcycling", { 1'000, 10'000, 100'000 }, benchSubcycling );
+
+} // end anonymous namespace
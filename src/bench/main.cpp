@@ -0,0 +1,145 @@
+//------------------------------------------------------------------------------
+// <preamble>
+//
+//  ______
+// |
+// | TailSiT GmbH
+// | Graz, Austria
+//   www.tailsit.com
+//
+// </preamble>
+//------------------------------------------------------------------------------
+
+//! @author    Lars Kielhorn, Thomas Rüberg, Jürgen Zechner
+//! @date      2024
+//! @copyright TailSiT GmbH
+
+// system ----------------------------------------------------------------------
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <filesystem>
+#include <format>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+
+// own -------------------------------------------------------------------------
+#include "Bench.hpp"
+#include "../Communicator.hpp"
+
+//------------------------------------------------------------------------------
+namespace ts {
+  namespace bench {
+
+    //--------------------------------------------------------------------------
+    std::vector<Case>& registry( )
+    {
+      static std::vector<Case> cases;
+      return cases;
+    }
+
+  } // end namespace bench
+} // end namespace ts
+
+//------------------------------------------------------------------------------
+namespace {
+
+  //----------------------------------------------------------------------------
+  std::vector<ts::SizeT> parseSizes( std::string_view arg )
+  {
+    std::vector<ts::SizeT> sizes;
+    while( !arg.empty() ) {
+      const auto comma = arg.find( ',' );
+      sizes.push_back( std::stoull( std::string( arg.substr( 0, comma ) ) ) );
+      arg = (comma == std::string_view::npos) ? std::string_view{} : arg.substr( comma + 1 );
+    }
+    return sizes;
+  }
+
+  //----------------------------------------------------------------------------
+  void usage( const std::string& appname )
+  {
+    std::cerr << "usage: " << appname
+              << " [--filter name] [--sizes n1,n2,...] [--reps n] [--workdir dir]"
+                 " [--json file]"
+              << std::endl;
+    std::exit( EXIT_FAILURE );
+  }
+
+  //----------------------------------------------------------------------------
+  /** Results as JSON, one object per measurement, for tracking releases */
+  void writeJson( const std::filesystem::path& file,
+                  const std::vector<ts::bench::Result>& results,
+                  ts::SizeT numRanks )
+  {
+    std::ofstream out( file );
+    if( !out )
+      throw std::runtime_error( "ts_bench:Cannot write '" + file.string() + "'" );
+
+    const auto now = std::chrono::floor<std::chrono::seconds>( std::chrono::system_clock::now() );
+    out << "{\n"
+        << std::format( "  \"date\": \"{:%FT%TZ}\",\n", now )
+        << std::format( "  \"compiler\": \"{}\",\n", __VERSION__ )
+        << std::format( "  \"ranks\": {},\n", numRanks )
+        << "  \"results\": [";
+    for( ts::SizeT i = 0; i < results.size(); ++i ) {
+      const auto& r = results[i];
+      out << (i ? ",\n" : "\n")
+          << std::format( "    {{ \"case\": \"{}\", \"variant\": \"{}\", \"size\": {}, "
+                          "\"repetitions\": {}, \"minSeconds\": {:.6e}, "
+                          "\"meanSeconds\": {:.6e}, \"itemsPerSecond\": {:.6e} }}",
+                          r.name, r.label, r.size, r.repetitions, r.minSeconds,
+                          r.meanSeconds, r.items / r.minSeconds );
+    }
+    out << "\n  ]\n}\n";
+  }
+
+} // end anonymous namespace
+
+//------------------------------------------------------------------------------
+int main( int argc, char* argv[] )
+{
+  // every rank runs all cases, collectives inside them have to match
+  const ts::MpiEnvironment mpi( argc, argv );
+  const std::string appname = std::filesystem::path{ argv[0] }.filename().string();
+
+  ts::bench::Options options;
+  for( int i = 1; i < argc; ++i ) {
+    const std::string_view arg = argv[i];
+    if( i + 1 >= argc ) usage( appname );
+    const std::string_view val = argv[++i];
+    if     ( arg == "--filter"  ) options.filter = val;
+    else if( arg == "--sizes"   ) options.sizes = parseSizes( val );
+    else if( arg == "--reps"    ) options.repetitions = std::stoull( std::string(val) );
+    else if( arg == "--workdir" ) options.workDir = val;
+    else if( arg == "--json"    ) options.jsonFile = val;
+    else usage( appname );
+  }
+
+  std::vector<ts::bench::Result> results;
+  for( const auto& c : ts::bench::registry() ) {
+    if( c.name.find( options.filter ) == std::string::npos ) continue;
+    const auto& sizes = options.sizes.empty() ? c.sizes : options.sizes;
+    for( const auto size : sizes ) {
+      ts::bench::Context context( options, results, c.name, size );
+      c.run( context );
+    }
+  }
+
+  const ts::Communicator comm = ts::Communicator::world();
+  if( !comm.isRoot() ) return EXIT_SUCCESS;
+
+  std::cout << std::format( "{:<24s} {:<24s} {:>10s} {:>12s} {:>12s} {:>14s}\n",
+                            "case", "variant", "size", "min [s]", "mean [s]", "items/s" );
+  for( const auto& r : results )
+    std::cout << std::format( "{:<24s} {:<24s} {:>10d} {:>12.4e} {:>12.4e} {:>14.4e}\n",
+                              r.name, r.label, r.size, r.minSeconds, r.meanSeconds,
+                              r.items / r.minSeconds );
+
+  if( !options.jsonFile.empty() )
+    writeJson( options.jsonFile, results, comm.size() );
+
+  return EXIT_SUCCESS;
+}
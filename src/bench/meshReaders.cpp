@@ -0,0 +1,86 @@
+//------------------------------------------------------------------------------
+// <preamble>
+//
+//  ______
+// |
+// | TailSiT GmbH
+// | Graz, Austria
+//   www.tailsit.com
+//
+// </preamble>
+//------------------------------------------------------------------------------
+
+//! @author    Lars Kielhorn, Thomas Rüberg, Jürgen Zechner
+//! @date      2024
+//! @copyright TailSiT GmbH
+
+// system ----------------------------------------------------------------------
+#include <cmath>
+#include <filesystem>
+#include <format>
+#include <fstream>
+#include <iterator>
+#include <string>
+
+// own -------------------------------------------------------------------------
+#include "Bench.hpp"
+#include "../MeshReaders.hpp"
+
+//------------------------------------------------------------------------------
+namespace {
+
+  //----------------------------------------------------------------------------
+  /** A CalculiX deck of a cube of n^3 nodes and (n-1)^3 hexahedra in the
+   *  ELSET 'Cube' */
+  std::filesystem::path writeDeck( const std::filesystem::path& dir, ts::SizeT n )
+  {
+    const auto file = dir / std::format( "ts_bench_cube_{}.inp", n );
+    if( std::filesystem::exists( file ) ) return file;
+
+    auto node = [n]( ts::SizeT i, ts::SizeT j, ts::SizeT k ) { return 1 + i + n * (j + n * k); };
+    std::ofstream out( file );
+    std::string buffer = "*NODE\n";
+    auto flush = [&]() { if( buffer.size() > (1u << 20) ) { out << buffer; buffer.clear(); } };
+    for( ts::SizeT k = 0; k < n; ++k )
+      for( ts::SizeT j = 0; j < n; ++j )
+        for( ts::SizeT i = 0; i < n; ++i ) {
+          std::format_to( std::back_inserter( buffer ), "{}, {:.8e}, {:.8e}, {:.8e}\n",
+                          node( i, j, k ), 1e-3 * i, 1e-3 * j, 1e-3 * k );
+          flush();
+        }
+    buffer += "*ELEMENT, TYPE=C3D8, ELSET=Cube\n";
+    for( ts::SizeT k = 0, e = 1; k + 1 < n; ++k )
+      for( ts::SizeT j = 0; j + 1 < n; ++j )
+        for( ts::SizeT i = 0; i + 1 < n; ++i, ++e ) {
+          std::format_to( std::back_inserter( buffer ), "{}, {}, {}, {}, {}, {}, {}, {}, {}\n", e,
+                          node( i, j, k ),   node( i+1, j, k ),   node( i+1, j+1, k ),   node( i, j+1, k ),
+                          node( i, j, k+1 ), node( i+1, j, k+1 ), node( i+1, j+1, k+1 ), node( i, j+1, k+1 ) );
+          flush();
+        }
+    out << buffer;
+    return file;
+  }
+
+  //----------------------------------------------------------------------------
+  /** All nodes of a deck, serially and in parallel chunks, and the surface
+   *  nodes of its solids */
+  void benchMeshReaders( ts::bench::Context& context )
+  {
+    const auto n    = static_cast<ts::SizeT>( std::cbrt( static_cast<double>( context.size() ) ) );
+    const auto file = writeDeck( context.workDir(), n );
+    const ts::Real numNodes = static_cast<ts::Real>( n * n * n );
+
+    context.measure( "inp nodes serial", numNodes, [&]() {
+      ts::bench::doNotOptimize( ts::CalculixMeshReader{ .numThreads = 1, .region = {} }( file ) );
+    } );
+    context.measure( "inp nodes parallel", numNodes, [&]() {
+      ts::bench::doNotOptimize( ts::CalculixMeshReader()( file ) );
+    } );
+    context.measure( "inp ELSET surface", numNodes, [&]() {
+      ts::bench::doNotOptimize( ts::CalculixMeshReader{ .numThreads = 0, .region = "Cube" }( file ) );
+    } );
+  }
+
+  const ts::bench::Registrar meshReaders( "meshReaders", { 100'000, 1'000'000 }, benchMeshReaders );
+
+} // end anonymous namespace
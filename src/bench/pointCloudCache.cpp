@@ -0,0 +1,45 @@
+//------------------------------------------------------------------------------
+// <preamble>
+//
+//  ______
+// |
+// | TailSiT GmbH
+// | Graz, Austria
+//   www.tailsit.com
+//
+// </preamble>
+//------------------------------------------------------------------------------
+
+//! @author    Lars Kielhorn, Thomas Rüberg, Jürgen Zechner
+//! @date      2024
+//! @copyright TailSiT GmbH
+
+// system ----------------------------------------------------------------------
+#include <filesystem>
+
+// own -------------------------------------------------------------------------
+#include "Bench.hpp"
+#include "../PointCloudCache.hpp"
+
+//------------------------------------------------------------------------------
+namespace {
+
+  //----------------------------------------------------------------------------
+  void benchCache( ts::bench::Context& context )
+  {
+    const auto file = ts::bench::writeCloud( context.workDir(), context.size() );
+    const ts::Real numRows = static_cast<ts::Real>( context.size() );
+
+    context.measure( "cold (parse+write)", numRows, [&]() {
+      std::filesystem::remove( ts::PointCloudCache::cachePath( file ) );
+      ts::bench::doNotOptimize( ts::PointCloudCache::load<3>( file ) );
+    } );
+    context.measure( "warm (mmap)", numRows, [&]() {
+      const auto cache = ts::PointCloudCache::load<3>( file );
+      ts::bench::doNotOptimize( cache.coordinates().back() );
+    } );
+  }
+
+  const ts::bench::Registrar cache( "pointCloudCache", { 100'000, 1'000'000, 10'000'000 }, benchCache );
+
+} // end anonymous namespace
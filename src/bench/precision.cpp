@@ -0,0 +1,92 @@
+//------------------------------------------------------------------------------
+// <preamble>
+//
+//  ______
+// |
+// | TailSiT GmbH
+// | Graz, Austria
+//   www.tailsit.com
+//
+// </preamble>
+//------------------------------------------------------------------------------
+
+//! @author    Lars Kielhorn, Thomas Rüberg, Jürgen Zechner
+//! @date      2024
+//! @copyright TailSiT GmbH
+
+// system ----------------------------------------------------------------------
+#include <cmath>
+#include <format>
+#include <numeric>
+#include <span>
+#include <string>
+#include <vector>
+
+// own -------------------------------------------------------------------------
+#include "Bench.hpp"
+#include "../Coupling.hpp"
+#include "../CSVParser.hpp"
+#include "../ForceGenerator.hpp"
+#include "../ReplayParticipant.hpp"
+#include "../SigmoidForce.hpp"
+#include "../Trajectory.hpp"
+
+//------------------------------------------------------------------------------
+namespace {
+
+  //! the falling magnet, implicitly with 4 iterations per window, on a
+  //! solver storing its fields as T; returns the sum of all forces written
+  template< typename T >
+  ts::Real run( std::span<const ts::Real>  coords,
+                const ts::Settings&        settings,
+                const ts::Trajectory&      trajectory,
+                ts::SizeT                  numWindows )
+  {
+    const ts::SigmoidForce force;
+    ts::BasicForceGenerator<T> solver( coords, settings );
+    ts::ReplayParticipant participant( trajectory, settings.dt, numWindows, 4 );
+
+    solver.start();
+    std::vector<ts::Int> vertexIds( solver.numCoordinates() );
+    std::iota( vertexIds.begin(), vertexIds.end(), 0 );
+    ts::couple( participant, solver, settings, vertexIds, force );
+    solver.stop();
+    return participant.forceSum();
+  }
+
+  //----------------------------------------------------------------------------
+  /** Coupled runs with double and float storage, for both force fields; the
+   *  float label gives the relative deviation of the force sum from the
+   *  double run. Items are iterations */
+  void benchPrecision( ts::bench::Context& context )
+  {
+    static constexpr ts::SizeT numWindows = 100;
+    const auto file   = ts::bench::writeCloud( context.workDir(), context.size() );
+    const auto coords = ts::CSVParser<3>()( file );
+
+    ts::Settings settings;
+    settings.samplesFile = (context.workDir() / "ts_bench_forces.csv").string();
+    const auto trajectory = ts::Trajectory::freeFall( 9.81, 2, numWindows * settings.dt );
+    const ts::Real items  = static_cast<ts::Real>( numWindows * 4 );
+
+    using ForceField = ts::Settings::ForceField;
+    for( ForceField field : { ForceField::uniform, ForceField::perVertex } ) {
+      settings.forceField = field;
+      const std::string name = field == ForceField::uniform ? "uniform" : "perVertex";
+
+      const ts::Real reference = run<double>( coords, settings, trajectory, numWindows );
+      const ts::Real single    = run<float>( coords, settings, trajectory, numWindows );
+      const ts::Real deviation = std::abs( single - reference ) / std::abs( reference );
+
+      context.measure( std::format( "double {}", name ), items, [&]() {
+        ts::bench::doNotOptimize( run<double>( coords, settings, trajectory, numWindows ) );
+      } );
+      context.measure( std::format( "float {}, dF {:.1e}", name, deviation ), items, [&]() {
+        ts::bench::doNotOptimize( run<float>( coords, settings, trajectory, numWindows ) );
+      } );
+    }
+  }
+
+  const ts::bench::Registrar precision( "precision", { 1'000, 10'000, 100'000 }, benchPrecision );
+
+} // end anonymous namespace
@@ -0,0 +1,70 @@
+//------------------------------------------------------------------------------
+// <preamble>
+//
+//  ______
+// |
+// | TailSiT GmbH
+// | Graz, Austria
+//   www.tailsit.com
+//
+// </preamble>
+//------------------------------------------------------------------------------
+
+//! @author    Lars Kielhorn, Thomas Rüberg, Jürgen Zechner
+//! @date      2024
+//! @copyright TailSiT GmbH
+
+// system ----------------------------------------------------------------------
+#include <cmath>
+#include <vector>
+
+// own -------------------------------------------------------------------------
+#include "Bench.hpp"
+#include "../RigidMotion.hpp"
+
+//------------------------------------------------------------------------------
+namespace {
+
+  //----------------------------------------------------------------------------
+  /** Cost of one rigid motion fit, i.e. per implicit iteration */
+  void benchRigidMotion( ts::bench::Context& context )
+  {
+    const ts::SizeT n = context.size();
+    std::vector<ts::Real> coords( 3*n ), displacements( 3*n );
+    for( ts::SizeT i = 0; i < n; ++i ) {
+      const ts::Real phi = 2.39996322972865332 * i;
+      coords[3*i]   = 3e-3 * std::cos(phi);
+      coords[3*i+1] = 3e-3 * std::sin(phi);
+      coords[3*i+2] = 7.62e-2 * (i % 1024) / 1024.;
+      displacements[3*i+2] = 2e-2 + 1e-6 * std::sin( 17.*i ); // mapping noise
+    }
+
+    const ts::Real items = static_cast<ts::Real>( n );
+    context.measure( "vertex0 (old)", items, [&]() {
+      ts::bench::doNotOptimize( displacements[2] );
+    } );
+
+    const ts::RigidMotionFit serial( coords, 1 );
+    context.measure( "reduce-serial", items, [&]() {
+      ts::bench::doNotOptimize( serial.reduce( coords, displacements ) );
+    } );
+    context.measure( "fit-serial", items, [&]() {
+      ts::bench::doNotOptimize( serial( coords, displacements ) );
+    } );
+
+    // the same fields stored in single precision (TS_FLOAT_STORAGE)
+    const std::vector<float> coordsF( coords.begin(), coords.end() );
+    const std::vector<float> displacementsF( displacements.begin(), displacements.end() );
+    context.measure( "reduce-serial float", items, [&]() {
+      ts::bench::doNotOptimize( serial.reduce( coordsF, displacementsF ) );
+    } );
+
+    const ts::RigidMotionFit threaded( coords );
+    context.measure( "fit-parallel", items, [&]() {
+      ts::bench::doNotOptimize( threaded( coords, displacements ) );
+    } );
+  }
+
+  const ts::bench::Registrar rigid( "rigidMotion", { 10'000, 100'000, 1'000'000 }, benchRigidMotion );
+
+} // end anonymous namespace
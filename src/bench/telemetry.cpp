@@ -0,0 +1,82 @@
+//------------------------------------------------------------------------------
+// <preamble>
+//
+//  ______
+// |
+// | TailSiT GmbH
+// | Graz, Austria
+//   www.tailsit.com
+//
+// </preamble>
+//------------------------------------------------------------------------------
+
+//! @author    Lars Kielhorn, Thomas Rüberg, Jürgen Zechner
+//! @date      2024
+//! @copyright TailSiT GmbH
+
+// system ----------------------------------------------------------------------
+#include <numeric>
+#include <vector>
+
+// own -------------------------------------------------------------------------
+#include "Bench.hpp"
+#include "../Coupling.hpp"
+#include "../CSVParser.hpp"
+#include "../ForceGenerator.hpp"
+#include "../ReplayParticipant.hpp"
+#include "../SigmoidForce.hpp"
+#include "../Telemetry.hpp"
+#include "../Trajectory.hpp"
+
+//------------------------------------------------------------------------------
+namespace {
+
+  //----------------------------------------------------------------------------
+  /** One seqlock update and one snapshot of the shared counters; and the
+   *  implicit coupled run with and without publishing them. Items are
+   *  updates, reads and iterations */
+  void benchTelemetry( ts::bench::Context& context )
+  {
+    ts::Telemetry telemetry = ts::Telemetry::create( "ts_bench_telemetry", { "dummy_magnet" } );
+    const ts::Telemetry reader = ts::Telemetry::attach( "ts_bench_telemetry" );
+
+    static constexpr ts::SizeT numUpdates = 10'000;
+    const ts::Real updates = static_cast<ts::Real>( numUpdates );
+    ts::Telemetry::Counters counters;
+    context.measure( "publish", updates, [&]() {
+      for( ts::SizeT i = 0; i < numUpdates; ++i ) {
+        counters.numIterations = i;
+        telemetry.publish( 0, counters );
+      }
+    } );
+    context.measure( "read", updates, [&]() {
+      for( ts::SizeT i = 0; i < numUpdates; ++i )
+        ts::bench::doNotOptimize( reader.read( 0 ).numIterations );
+    } );
+
+    static constexpr ts::SizeT numWindows = 100;
+    const auto file = ts::bench::writeCloud( context.workDir(), context.size() );
+    ts::Settings settings;
+    settings.samplesFile = (context.workDir() / "ts_bench_forces.csv").string();
+    const ts::SigmoidForce force;
+    const auto trajectory = ts::Trajectory::freeFall( 9.81, 2, numWindows * settings.dt );
+    const ts::Real iterations = static_cast<ts::Real>( numWindows * 4 );
+    for( const bool publish : { false, true } )
+      context.measure( publish ? "implicit 4 it published" : "implicit 4 it", iterations, [&]() {
+        const auto coords = ts::CSVParser<3>()( file );
+        ts::ForceGenerator solver( coords, settings );
+        ts::ReplayParticipant participant( trajectory, settings.dt, numWindows, 4 );
+
+        solver.start();
+        if( publish ) solver.attachTelemetry( telemetry, 0 );
+        std::vector<ts::Int> vertexIds( solver.numCoordinates() );
+        std::iota( vertexIds.begin(), vertexIds.end(), 0 );
+        ts::couple( participant, solver, settings, vertexIds, force );
+        solver.stop();
+        ts::bench::doNotOptimize( participant.forceSum() );
+      } );
+  }
+
+  const ts::bench::Registrar telemetry( "telemetry", { 1'000, 10'000 }, benchTelemetry );
+
+} // end anonymous namespace
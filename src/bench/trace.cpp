@@ -0,0 +1,89 @@
+//------------------------------------------------------------------------------
+// <preamble>
+//
+//  ______
+// |
+// | TailSiT GmbH
+// | Graz, Austria
+//   www.tailsit.com
+//
+// </preamble>
+//------------------------------------------------------------------------------
+
+//! @author    Lars Kielhorn, Thomas Rüberg, Jürgen Zechner
+//! @date      2024
+//! @copyright TailSiT GmbH
+
+// system ----------------------------------------------------------------------
+#include <format>
+#include <numeric>
+#include <stdexcept>
+#include <vector>
+
+// own -------------------------------------------------------------------------
+#include "Bench.hpp"
+#include "../Coupling.hpp"
+#include "../CouplingTrace.hpp"
+#include "../CSVParser.hpp"
+#include "../ForceGenerator.hpp"
+#include "../RecordingParticipant.hpp"
+#include "../ReplayParticipant.hpp"
+#include "../SigmoidForce.hpp"
+#include "../TraceParticipant.hpp"
+#include "../Trajectory.hpp"
+
+//------------------------------------------------------------------------------
+namespace {
+
+  //----------------------------------------------------------------------------
+  /** Implicit coupling runs recording their traffic, then the replay of the
+   *  trace checking the forces bit for bit; a replay that differs fails the
+   *  case. Items are iterations. */
+  void benchTrace( ts::bench::Context& context )
+  {
+    static constexpr ts::SizeT numWindows    = 100;
+    static constexpr ts::SizeT numIterations = 4;
+    const auto file      = ts::bench::writeCloud( context.workDir(), context.size() );
+    const auto traceFile = context.workDir() / "ts_bench_trace.bin";
+
+    ts::Settings settings;
+    settings.samplesFile = (context.workDir() / "ts_bench_forces.csv").string();
+    const ts::SigmoidForce force;
+    const auto trajectory = ts::Trajectory::freeFall( 9.81, 2, numWindows * settings.dt );
+    const auto coords = ts::CSVParser<3>()( file );
+    const ts::Real items = numWindows * numIterations;
+    std::vector<ts::Int> vertexIds( coords.size() / 3 );
+    std::iota( vertexIds.begin(), vertexIds.end(), 0 );
+
+    context.measure( "record", items, [&]() {
+      ts::ForceGenerator solver( coords, settings );
+      ts::ReplayParticipant participant( trajectory, settings.dt, numWindows, numIterations );
+      ts::CouplingTrace::Writer trace( traceFile, coords.size(), coords.size() );
+      ts::RecordingParticipant recorder( participant, trace );
+
+      solver.start();
+      ts::couple( recorder, solver, settings, vertexIds, force );
+      solver.stop();
+      trace.close();
+      ts::bench::doNotOptimize( trace.numBytes() );
+    } );
+
+    context.measure( "replay", items, [&]() {
+      ts::ForceGenerator solver( coords, settings );
+      ts::CouplingTrace::Reader trace( traceFile );
+      ts::TraceParticipant participant( trace );
+
+      solver.start();
+      ts::couple( participant, solver, settings, vertexIds, force );
+      solver.stop();
+      if( participant.numMismatches() > 0 )
+        throw std::runtime_error(
+          std::format( "ts::bench::trace:{} of {} replayed iterations differ, the first is {}",
+                       participant.numMismatches(), participant.numIterations(),
+                       participant.firstMismatch() ) );
+    } );
+  }
+
+  const ts::bench::Registrar trace( "trace", { 1'000, 10'000, 100'000 }, benchTrace );
+
+} // end anonymous namespace
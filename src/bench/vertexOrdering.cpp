@@ -0,0 +1,106 @@
+//------------------------------------------------------------------------------
+// <preamble>
+//
+//  ______
+// |
+// | TailSiT GmbH
+// | Graz, Austria
+//   www.tailsit.com
+//
+// </preamble>
+//------------------------------------------------------------------------------
+
+//! @author    Lars Kielhorn, Thomas Rüberg, Jürgen Zechner
+//! @date      2024
+//! @copyright TailSiT GmbH
+
+// system ----------------------------------------------------------------------
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <numeric>
+#include <random>
+#include <string>
+#include <vector>
+
+// own -------------------------------------------------------------------------
+#include "Bench.hpp"
+#include "../ForceGenerator.hpp"
+#include "../SigmoidForce.hpp"
+
+//------------------------------------------------------------------------------
+namespace {
+
+  //----------------------------------------------------------------------------
+  /** Per-vertex work and checkpoint copies on a cylinder surface whose
+   *  vertices come in random order, kept as is or sorted along a
+   *  space-filling curve inside the ForceGenerator */
+  void benchVertexOrdering( ts::bench::Context& context )
+  {
+    static constexpr ts::SizeT numWindows = 4;
+    const ts::SizeT n = context.size();
+    std::vector<ts::SizeT> shuffled( n );
+    std::iota( shuffled.begin(), shuffled.end(), 0 );
+    std::ranges::shuffle( shuffled, std::mt19937_64( 42 ) );
+    std::vector<ts::Real> coords( 3*n ), displacements( 3*n ), forces( 3*n );
+    const ts::SizeT numRings = static_cast<ts::SizeT>( std::sqrt( n ) );
+    for( ts::SizeT i = 0; i < n; ++i ) {
+      const ts::SizeT v = shuffled[i];
+      const ts::Real phi = 2 * 3.14159265358979 * (v % numRings) / numRings;
+      coords[3*i]   = 3e-3 * std::cos(phi);
+      coords[3*i+1] = 3e-3 * std::sin(phi);
+      coords[3*i+2] = 7.62e-2 * (v / numRings) / (n / numRings);
+      displacements[3*i+2] = -2e-2;
+    }
+    const ts::Real items = static_cast<ts::Real>( n );
+    const ts::SigmoidForce force;
+
+    using Ordering = ts::Settings::VertexOrdering;
+    for( const auto& [ordering, name] : { std::pair{ Ordering::input,   "input"   },
+                                          std::pair{ Ordering::morton,  "morton"  },
+                                          std::pair{ Ordering::hilbert, "hilbert" } } ) {
+      ts::Settings settings;
+      settings.vertexOrdering = ordering;
+      settings.forceField     = ts::Settings::ForceField::perVertex;
+      settings.samplesFile    = (context.workDir() / "ts_bench_forces.csv").string();
+      const std::string label( name );
+
+      std::unique_ptr<ts::ForceGenerator> solver;
+      context.measure( label + " construct", items, [&]() {
+        solver = std::make_unique<ts::ForceGenerator>( coords, settings );
+      } );
+      solver -> start();
+
+      // a field differing from the last one solved for, so that it is fitted
+      ts::Real shift = 0;
+      context.measure( label + " set", items, [&]() {
+        displacements[2] = (shift = -shift + 1e-9);
+        solver -> set( "Displacements", displacements );
+      } );
+      context.measure( label + " set+solve", items, [&]() {
+        displacements[2] = (shift = -shift + 1e-9);
+        solver -> set( "Displacements", displacements );
+        solver -> solveTimeStep( force );
+      } );
+      bool toggle = false;
+      std::vector<ts::Real> other( 3*n );
+      context.measure( label + " get", items, [&]() {
+        toggle = !toggle;
+        solver -> get( "Forces", toggle ? forces : other );
+        ts::bench::doNotOptimize( forces.data() );
+      } );
+      context.measure( label + " save+reload+set", numWindows, [&]() {
+        for( ts::SizeT w = 0; w < numWindows; ++w ) {
+          solver -> saveOldState();
+          solver -> set( "Displacements", displacements );
+          solver -> reloadOldState();
+          solver -> set( "Displacements", displacements );
+        }
+      } );
+      solver -> stop();
+    }
+  }
+
+  const ts::bench::Registrar vertexOrdering( "vertexOrdering", { 1'000'000, 4'000'000 }, benchVertexOrdering );
+
+} // end anonymous namespace
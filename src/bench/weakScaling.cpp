@@ -0,0 +1,78 @@
+//------------------------------------------------------------------------------
+// <preamble>
+//
+//  ______
+// |
+// | TailSiT GmbH
+// | Graz, Austria
+//   www.tailsit.com
+//
+// </preamble>
+//------------------------------------------------------------------------------
+
+//! @author    Lars Kielhorn, Thomas Rüberg, Jürgen Zechner
+//! @date      2024
+//! @copyright TailSiT GmbH
+
+// system ----------------------------------------------------------------------
+#include <format>
+#include <vector>
+
+// own -------------------------------------------------------------------------
+#include "Bench.hpp"
+#include "../Communicator.hpp"
+#include "../CSVParser.hpp"
+#include "../ForceGenerator.hpp"
+#include "../SigmoidForce.hpp"
+
+//------------------------------------------------------------------------------
+namespace {
+
+  //----------------------------------------------------------------------------
+  /** Partitioned load and coupling step with size() vertices per rank.
+   *
+   *  Run as 'mpirun -np N ts_bench --filter weakScaling' for N = 1, 2, 4, ...;
+   *  with perfect weak scaling the times do not grow with N. Every variant
+   *  ends in a collective, so the root's times are those of the slowest rank.
+   */
+  void benchWeakScaling( ts::bench::Context& context )
+  {
+    const ts::Communicator comm = ts::Communicator::world();
+    const ts::SizeT n = context.size();
+    const ts::SizeT numRanks = comm.size();
+    const ts::Real items = static_cast<ts::Real>( n * numRanks );
+
+    // the root writes the global cloud, the others then just find it
+    if( comm.isRoot() ) ts::bench::writeCloud( context.workDir(), n * numRanks );
+    comm.barrier();
+    const auto file = ts::bench::writeCloud( context.workDir(), n * numRanks );
+
+    ts::CSVParser<3> parser;
+    parser.part     = comm.rank();
+    parser.numParts = numRanks;
+    std::vector<ts::Real> coords;
+    context.measure( std::format( "load np={}", numRanks ), items, [&]() {
+      coords = parser( file );
+      comm.barrier();
+    } );
+
+    ts::Settings settings;
+    settings.samplesFile = (context.workDir() / "ts_bench_forces.csv").string();
+    ts::ForceGenerator solver( coords, settings, comm );
+    solver.start();
+
+    std::vector<ts::Real> displacements( coords.size() ), forces( coords.size() );
+    for( ts::SizeT i = 2; i < displacements.size(); i += 3 ) displacements[i] = 2e-2;
+    const ts::SigmoidForce force;
+    context.measure( std::format( "step np={}", numRanks ), items, [&]() {
+      solver.set( settings.inField, displacements );
+      solver.solveTimeStep( force );
+      solver.get( settings.outField, forces );
+      ts::bench::doNotOptimize( forces.data() );
+    } );
+    solver.stop();
+  }
+
+  const ts::bench::Registrar weakScaling( "weakScaling", { 10'000, 100'000, 1'000'000 }, benchWeakScaling );
+
+} // end anonymous namespace
@@ -0,0 +1,225 @@
+//------------------------------------------------------------------------------
+// <preamble>
+//
+//  ______
+// |
+// | TailSiT GmbH
+// | Graz, Austria
+//   www.tailsit.com
+//
+// </preamble>
+//------------------------------------------------------------------------------
+
+//! @author    Lars Kielhorn, Thomas Rüberg, Jürgen Zechner
+//! @date      2024
+//! @copyright TailSiT GmbH
+
+// system ----------------------------------------------------------------------
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <exception>
+#include <filesystem>
+#include <format>
+#include <iostream>
+#include <memory>
+#include <numeric>
+#include <span>
+#include <string>
+#include <variant>
+#include <vector>
+
+// own -------------------------------------------------------------------------
+#include "types.hpp"
+#include "Settings.hpp"
+#include "Coupling.hpp"
+#include "ForceGenerator.hpp"
+#include "ForceModels.hpp"
+#include "LoopbackParticipant.hpp"
+#include "PointCloudCache.hpp"
+#include "RigidBody.hpp"
+#include "RigidMotion.hpp"
+#include "Telemetry.hpp"
+#include "yaml/parse.hpp"
+
+//------------------------------------------------------------------------------
+namespace {
+
+  using Vector = ts::RigidBody::Vector;
+
+  //! the body integrated monolithically with the force models, window by
+  //! window in steps of at most dt
+  std::vector<ts::RigidBody::State> monolithic( const ts::RigidBodySettings&       body,
+                                                std::span<const ts::ForceModel>    forceModels,
+                                                ts::Real                           windowSize,
+                                                ts::Real                           dt,
+                                                ts::SizeT                          numWindows )
+  {
+    std::vector<ts::RigidBody::State> states;
+    states.reserve( numWindows + 1 );
+    ts::RigidBody reference( body.integrator );
+    states.push_back( reference.state() );
+    const auto accel = [&]( ts::Real t, const Vector& U, const Vector& ) {
+      ts::RigidMotion motion;
+      motion.translation = U;
+      Vector A = body.gravity;
+      for( const auto& forceModel : forceModels )
+        std::visit( [&]( const auto& force ) {
+                      Vector F;
+                      force( t, motion, F );
+                      for( ts::SizeT a = 0; a < 3; ++a ) A[a] += F[a]/body.mass;
+                    },
+                    forceModel );
+      return A;
+    };
+    for( ts::SizeT w = 0; w < numWindows; ++w ) {
+      for( ts::Real t = 0; t < windowSize * (1 - 1e-12); ) {
+        const ts::Real step = std::min( dt, windowSize - t );
+        reference.commit( reference.advance( step, accel ) );
+        t += step;
+      }
+      states.push_back( reference.state() );
+    }
+    return states;
+  }
+
+} // end anonymous namespace
+
+//------------------------------------------------------------------------------
+namespace {
+
+//------------------------------------------------------------------------------
+int run( int argc, char* argv[] )
+{
+  const std::filesystem::path appname = std::filesystem::path{ argv[0] }.filename();
+  if( argc != 3 ) {
+    std::cerr << "usage: " << appname.string() << " coords.csv config.yaml\n"
+              << "  config.yaml holds the 'settings' and the 'rigidBody' block;\n"
+              << "  with several 'meshes' the body feels the sum of their forces"
+              << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  const auto startTime = std::chrono::steady_clock::now();
+  const std::filesystem::path csvFile( argv[1] );
+  const std::filesystem::path yamlFile( argv[2] );
+
+  const ts::Settings          settings = ts::yaml::parse( yamlFile );
+  const ts::RigidBodySettings body     = ts::yaml::parseRigidBody( yamlFile );
+  ts::yaml::Parser::dump( std::cout, settings );
+  ts::yaml::Parser::dump( std::cout, body );
+
+  /*
+   * the adapter coupled to the in-process rigid body, one solver per mesh
+   */
+  static constexpr auto numColsInCSV = 3;
+  const std::vector<ts::Settings> meshSettings = ts::meshSettings( settings );
+  const ts::SizeT numMeshes  = meshSettings.size();
+  const ts::Real  windowSize = body.windowSize > 0 ? body.windowSize : settings.dt;
+  const ts::SizeT numWindows =
+    static_cast<ts::SizeT>( std::ceil( settings.endt / windowSize - 1e-9 ) );
+  ts::Telemetry telemetry;
+  if( settings.telemetry.enabled ) {
+    std::vector<std::string> meshNames;
+    for( const auto& meshSetting : meshSettings )
+      meshNames.push_back( meshSetting.meshName );
+    telemetry = ts::Telemetry::create( settings.telemetry.name.empty() ? settings.solverName
+                                                                       : settings.telemetry.name,
+                                       meshNames );
+    std::cout << std::format( "{}: telemetry in '{}'\n", appname.string(), telemetry.name() );
+  }
+  std::vector<ts::ForceModel>                      forceModels;
+  std::vector<std::unique_ptr<ts::ForceGenerator>> solvers;
+  std::vector<std::vector<ts::Int>>                vertexIds( numMeshes );
+  for( ts::SizeT m = 0; m < numMeshes; ++m ) {
+    const bool ownCloud = !settings.meshes.empty() && !settings.meshes[m].pointCloud.empty();
+    const auto pointCloud = ts::PointCloudCache::load<numColsInCSV>(
+      ownCloud ? std::filesystem::path( settings.meshes[m].pointCloud ) : csvFile );
+    forceModels.push_back( ts::makeForceModel( meshSettings[m].forceModel ) );
+    solvers.push_back( std::make_unique<ts::ForceGenerator>( pointCloud.coordinates(),
+                                                             meshSettings[m] ) );
+    solvers[m] -> start();
+    if( telemetry.valid() )
+      solvers[m] -> attachTelemetry( telemetry, m );
+    if( meshSettings[m].decimation.enabled )
+      std::cout << std::format( "{}: mesh '{}': {} points decimated to {} vertices, "
+                                "voxel size {:.4e}, max distance {:.4e}\n",
+                                appname.string(), meshSettings[m].meshName,
+                                solvers[m] -> decimation().vertexMap().size(),
+                                solvers[m] -> numCoordinates(),
+                                solvers[m] -> decimation().voxelSize(),
+                                solvers[m] -> decimation().maxDistance() );
+    vertexIds[m].resize( solvers[m] -> numCoordinates() );
+    std::iota( vertexIds[m].begin(), vertexIds[m].end(), 0 );
+  }
+  ts::LoopbackParticipant participant( body, windowSize, numWindows );
+  if( telemetry.valid() )
+    telemetry.setStatus( ts::Telemetry::Status::coupling );
+
+  if( numMeshes == 1 )
+    std::visit( [&]( const auto& force ) {
+                  ts::couple( participant, *solvers.front(), meshSettings.front(),
+                              vertexIds.front(), force );
+                },
+                forceModels.front() );
+  else {
+    std::vector<ts::CoupledMesh> meshes;
+    for( ts::SizeT m = 0; m < numMeshes; ++m )
+      meshes.push_back( { solvers[m].get(), &meshSettings[m], vertexIds[m], &forceModels[m] } );
+    ts::couple( participant, std::span<const ts::CoupledMesh>( meshes ) );
+  }
+  for( auto& solver : solvers )
+    solver -> stop();
+  if( telemetry.valid() )
+    telemetry.setStatus( ts::Telemetry::Status::finished );
+  participant.writeHistory( body.output );
+
+  const std::chrono::duration<ts::Real> coupled = std::chrono::steady_clock::now() - startTime;
+
+  /*
+   * compare with the monolithic solution
+   */
+  const auto reference = monolithic( body, forceModels, windowSize, settings.dt, numWindows );
+  const auto& history  = participant.history();
+  ts::Real maxDeviation = 0, maxDisplacement = 0;
+  for( ts::SizeT w = 0; w < history.size(); ++w )
+    for( ts::SizeT a = 0; a < 3; ++a ) {
+      maxDeviation    = std::max( maxDeviation, std::abs( history[w].state.U[a] - reference[w].U[a] ) );
+      maxDisplacement = std::max( maxDisplacement, std::abs( reference[w].U[a] ) );
+    }
+
+  const auto& last = history.back().state;
+  std::cout << std::format( "{}: {} windows, {} iterations, {} steps, U(t={:.4e}) = ({:.6e}, {:.6e}, {:.6e})\n",
+                            appname.string(), numWindows, participant.numIterations(),
+                            participant.numSteps(), last.t, last.U[0], last.U[1], last.U[2] )
+            << std::format( "{}: max deviation from monolithic in steps of dt {:.4e} (max |U| {:.4e})\n",
+                            appname.string(), maxDeviation, maxDisplacement )
+            << std::format( "{}: coupled run {:.3f} s, trajectory in '{}'\n",
+                            appname.string(), coupled.count(), body.output );
+  for( ts::SizeT m = 0; m < numMeshes; ++m ) {
+    const auto& cache = solvers[m] -> forceCache();
+    if( !cache.enabled() ) continue;
+    std::cout << std::format( "{}: mesh '{}': {} unchanged fields skipped, "
+                              "force cache {} hits in {} lookups\n",
+                              appname.string(), meshSettings[m].meshName,
+                              solvers[m] -> numSkipped(), cache.numHits(),
+                              cache.numLookups() );
+  }
+
+  return EXIT_SUCCESS;
+}
+
+} // end anonymous namespace
+
+//------------------------------------------------------------------------------
+int main( int argc, char* argv[] )
+{
+  try {
+    return run( argc, argv );
+  }
+  catch( const std::exception& e ) {
+    std::cerr << std::filesystem::path{ argv[0] }.filename().string() << ": " << e.what() << std::endl;
+  }
+  return EXIT_FAILURE;
+}
@@ -16,63 +16,53 @@
 
 // system ----------------------------------------------------------------------
 #include <cstdlib>
+#include <exception>
 #include <iostream>
 #include <filesystem>
 #include <format>
 #include <algorithm>
-#include <cmath>
 #include <chrono>
+#include <future>
+#include <map>
+#include <memory>
+#include <optional>
+#include <span>
+#include <string>
+#include <utility>
+#include <variant>
+#include <vector>
 
 // preCICE ---------------------------------------------------------------------
 #include <precice/precice.hpp>
 
 // own -------------------------------------------------------------------------
 #include "types.hpp"
+#include "Communicator.hpp"
 #include "ForceGenerator.hpp"
 #include "Settings.hpp"
-#include "CSVParser.hpp"
+#include "PointCloudCache.hpp"
+#include "MeshReaders.hpp"
+#include "ForceModels.hpp"
+#include "Coupling.hpp"
+#include "CouplingTrace.hpp"
+#include "RecordingParticipant.hpp"
+#include "StartupTimeline.hpp"
+#include "Telemetry.hpp"
 #include "yaml/parse.hpp"
 
 //------------------------------------------------------------------------------
-namespace app {
-
-  //----------------------------------------------------------------------------
-  struct DummyForce
-  {
-    static constexpr ts::SizeT dim = 3;
-
-    ts::Real eval( ts::Real s ) const
-    {
-      const auto e1 = std::exp(20. - 1000.*s);
-      const auto e2 = std::exp(25. - 1000.*s);
-      const auto e3 = std::exp(85. - 1000.*s);
-      const auto scale =  2./(1.+e1) - 1./(1.+e2) - 1./(1.+e3);
-      static constexpr ts::Real m = 6e-3;
-      static constexpr ts::Real g = 9.81;
-      return m*g*scale;
-      //return 0;
-    }
-    
-    void operator()( ts::Real                      time,
-                     std::span<const ts::Real,dim> U,
-                     std::span<ts::Real>           Feval ) const
-    {
-      std::ranges::fill( Feval, 0 );
-      Feval[2] = this->eval( std::abs(U[2]) );
-    }
-  };
-
-} // end namespace app
+namespace {
 
 //------------------------------------------------------------------------------
-int main( int argc, char* argv[] )
+int run( int argc, char* argv[], const ts::Communicator& comm )
 {
   const std::filesystem::path appname = std::filesystem::path{ argv[0] }.filename();
   if( argc != 4 ) {
-    std::cerr << "usage: " << appname.string()
-              << " coords.csv settings-precice.xml config.yaml"
-              << std::endl;
-    std::exit( EXIT_FAILURE );
+    if( comm.isRoot() )
+      std::cerr << "usage: [mpirun -np N] " << appname.string()
+                << " coords.{csv|mesh|inp} settings-precice.xml config.yaml"
+                << std::endl;
+    return EXIT_FAILURE;
   }
 
   /*
@@ -88,95 +78,238 @@ int main( int argc, char* argv[] )
   const std::filesystem::path yamlFile( argv[3] );
 
   /*
-   * parse settings from config yaml
+   * parse settings from config yaml; one or several meshes
    */
-  const ts::Settings settings = ts::yaml::parse(yamlFile);
-  ts::yaml::Parser::dump(std::cout,settings);
-  
+  ts::StartupTimeline startup;
+  const ts::Settings settings = [&]() {
+    const ts::StartupTimeline::Stage stage( startup, "settings" );
+    return ts::yaml::parse(yamlFile);
+  }();
+  if( comm.isRoot() )
+    ts::yaml::Parser::dump(std::cout,settings);
+  const std::vector<ts::Settings> meshSettings = ts::meshSettings( settings );
+  const ts::SizeT numMeshes = meshSettings.size();
+  if( !settings.recordFile.empty() &&
+      ( comm.size() > 1 || numMeshes > 1 || settings.subcycling.enabled ) ) {
+    // a trace holds one read per iteration
+    if( comm.isRoot() )
+      std::cerr << appname.string() << ": recordFile needs a serial run of one mesh, "
+                << "without subcycling" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  /*
+   * live counters for ts_telemetry, from now on; one region per rank
+   */
+  ts::Telemetry telemetry;
+  if( settings.telemetry.enabled ) {
+    std::string name = settings.telemetry.name.empty() ? settings.solverName
+                                                       : settings.telemetry.name;
+    if( comm.size() > 1 ) name += std::format( ".rank{}", comm.rank() );
+    std::vector<std::string> meshNames;
+    for( const auto& meshSetting : meshSettings )
+      meshNames.push_back( meshSetting.meshName );
+    telemetry = ts::Telemetry::create( name, meshNames );
+    if( comm.isRoot() )
+      std::cout << std::format( "{}: telemetry in '{}', watch with 'ts_telemetry {}'\n",
+                                appname.string(), telemetry.name(), name );
+  }
+
   /*
-   * instantiate dummy solver with point cloud
+   * the point clouds (parsed once, then cached; or the nodes of a TAILSIT
+   * '.mesh' or CalculiX '.inp' file, possibly of one region only) and the
+   * force models (e.g. tables) are loaded by worker threads while preCICE
+   * sets up; the workers never call MPI. Meshes sharing a file and region
+   * share its load.
    */
   static constexpr auto numColsInCSV = 3;
-  ts::ForceGenerator solver( ts::CSVParser<numColsInCSV>()( csvFile ), settings );
-  
+  using PointCloudKey = std::pair<std::filesystem::path,std::string>;
+  std::map<PointCloudKey,std::shared_future<ts::PointCloudCache>> pointClouds;
+  std::vector<PointCloudKey> meshPointClouds;
+  for( ts::SizeT m = 0; m < numMeshes; ++m ) {
+    const bool ownCloud = !settings.meshes.empty() && !settings.meshes[m].pointCloud.empty();
+    const PointCloudKey& key = meshPointClouds.emplace_back(
+      ownCloud ? std::filesystem::path( settings.meshes[m].pointCloud ) : csvFile,
+      meshSettings[m].pointCloudRegion );
+    const auto extension = key.first.extension();
+    const bool isMesh    = extension == ".mesh" || extension == ".inp";
+    if( !key.second.empty() && !isMesh ) {
+      if( comm.isRoot() )
+        std::cerr << appname.string() << ": pointCloudRegion needs a .mesh or .inp "
+                  << "point cloud, not '" << key.first.string() << "'" << std::endl;
+      return EXIT_FAILURE;
+    }
+    if( pointClouds.contains( key ) ) continue;
+    pointClouds.emplace( key, std::async( std::launch::async, [&, key, extension]() {
+      const auto& [file,region] = key;
+      const ts::StartupTimeline::Stage stage( startup, "pointCloud " + file.filename().string()
+                                                       + ( region.empty() ? "" : ":" + region ) );
+      if( extension == ".mesh" )
+        return ts::PointCloudCache::adopt<numColsInCSV>( ts::TailsitMeshReader{ 0, region }( file ),
+                                                         comm.rank(), comm.size() );
+      if( extension == ".inp" )
+        return ts::PointCloudCache::adopt<numColsInCSV>( ts::CalculixMeshReader{ 0, region }( file ),
+                                                         comm.rank(), comm.size() );
+      return ts::PointCloudCache::load<numColsInCSV>( file, comm.rank(), comm.size() );
+    } ) );
+  }
+  auto loadingForceModels = std::async( std::launch::async, [&]() {
+    const ts::StartupTimeline::Stage stage( startup, "forceModels" );
+    std::vector<ts::ForceModel> models;
+    for( const auto& meshSetting : meshSettings )
+      models.push_back( ts::makeForceModel( meshSetting.forceModel ) );
+    return models;
+  } );
+
   /*
    * instantiate precice
    */
-  static constexpr auto rank = 0;
-  static constexpr auto size = 1;
-  precice::Participant precice( settings.solverName, xmlFile.string(), rank, size );
+  const auto rank = static_cast<int>( comm.rank() );
+  const auto size = static_cast<int>( comm.size() );
+  std::unique_ptr<precice::Participant> participant;
+  {
+    const ts::StartupTimeline::Stage stage( startup, "participant" );
+    participant = std::make_unique<precice::Participant>( settings.solverName, xmlFile.string(),
+                                                          rank, size );
+  }
+  precice::Participant& precice = *participant;
 
   /*
-   * initialization
+   * instantiate a dummy solver per mesh with this rank's part of its point
+   * cloud; the constructor reduces over all ranks, so it runs here
    */
-  solver.start();
-  const ts::SizeT numPoints = solver.numCoordinates();
-  static constexpr ts::SizeT dim = solver.dim();
-  
-  std::vector<ts::Int>  vertexIds(numPoints);
-  std::vector<ts::Real> coords( numPoints * dim );
-
-  solver.getCoordinates( coords );
-
-  precice.setMeshVertices( settings.meshName, coords, vertexIds );
+  std::vector<std::unique_ptr<ts::ForceGenerator>> solvers;
+  for( ts::SizeT m = 0; m < numMeshes; ++m ) {
+    const auto& pointCloud = pointClouds.at( meshPointClouds[m] ).get();
+    const ts::StartupTimeline::Stage stage( startup, "forceGenerator " + meshSettings[m].meshName );
+    solvers.push_back( std::make_unique<ts::ForceGenerator>( pointCloud.coordinates(),
+                                                             meshSettings[m],
+                                                             comm ) );
+    if( telemetry.valid() )
+      solvers[m] -> attachTelemetry( telemetry, m );
+  }
+  const std::vector<ts::ForceModel> forceModels = loadingForceModels.get();
 
-  precice.initialize();
+  for( ts::SizeT m = 0; m < numMeshes; ++m ) {
+    if( !meshSettings[m].decimation.enabled ) continue;
+    const auto& decimation = solvers[m] -> decimation();
+    const ts::SizeT numPoints = comm.allReduceSum( decimation.vertexMap().size() );
+    if( comm.isRoot() )
+      std::cout << std::format( "{}: mesh '{}': {} points decimated to {} vertices, "
+                                "voxel size {:.4e}, max distance {:.4e}\n",
+                                appname.string(), meshSettings[m].meshName, numPoints,
+                                solvers[m] -> numGlobalCoordinates(), decimation.voxelSize(),
+                                decimation.maxDistance() );
+  }
 
   /*
-   * run 'simulation'
+   * initialization
    */
-  const app::DummyForce force;
-  std::vector<ts::Real> displacementBuffer( numPoints * dim );
-  std::vector<ts::Real> forcesBuffer( numPoints * dim );
-  while( precice.isCouplingOngoing() ) {
-
-    // possibly save state
-    if( precice.requiresWritingCheckpoint() )
-      solver.saveOldState();
-
-    // handle time step size
-    const ts::Real preciceDt = precice.getMaxTimeStepSize();
-    const ts::Real solverDt  = solver.beginTimeStep();
-    const ts::Real dt        = std::min( preciceDt, solverDt );
-
-    // read data
-    precice.readData( settings.meshName,
-                      settings.inField,
-                      vertexIds,
-                      dt,
-                      displacementBuffer );
-
-    // pass data to solver
-    solver.set( settings.inField, displacementBuffer );
-
-    // 'solve' for this time step
-    const bool sampleForce = true;
-    solver.solveTimeStep( force, sampleForce );
+  static constexpr ts::SizeT dim = ts::ForceGenerator::dim();
+  std::vector<std::vector<ts::Int>> vertexIds( numMeshes );
+  for( ts::SizeT m = 0; m < numMeshes; ++m ) {
+    auto& solver = *solvers[m];
+    solver.start();
+    const ts::SizeT numPoints = solver.numCoordinates();
+    vertexIds[m].resize( numPoints );
+    std::vector<ts::Real> coords( numPoints * dim );
 
-    // fetch forces on points from solver
-    solver.get( settings.outField, forcesBuffer );
+    const ts::StartupTimeline::Stage stage( startup, "setMeshVertices " + meshSettings[m].meshName );
+    solver.getCoordinates( coords );
 
-    // pass forces to precice
-    precice.writeData( settings.meshName,
-                       settings.outField,
-                       vertexIds,
-                       forcesBuffer );
+    precice.setMeshVertices( meshSettings[m].meshName, coords, vertexIds[m] );
+  }
+  pointClouds.clear();
 
-    // advance in time
-    precice.advance(dt);
+  {
+    const ts::StartupTimeline::Stage stage( startup, "initialize" );
+    precice.initialize();
+  }
+  if( telemetry.valid() )
+    telemetry.setStatus( ts::Telemetry::Status::coupling );
 
-    // possibly load old state
-    if( precice.requiresReadingCheckpoint() )
-      solver.reloadOldState();
-    else 
-      solver.endTimeStep();
+  /*
+   * run 'simulation', possibly recording the coupling traffic
+   */
+  if( numMeshes == 1 ) {
+    auto& solver = *solvers.front();
+    const auto& meshSetting = meshSettings.front();
+    const ts::SizeT numValues = solver.numCoordinates() * dim;
+    std::optional<ts::CouplingTrace::Writer> trace;
+    if( !settings.recordFile.empty() )
+      trace.emplace( settings.recordFile, numValues, numValues );
+    std::visit( [&]( const auto& force ) {
+                  if( trace ) {
+                    ts::RecordingParticipant recorder( precice, *trace );
+                    ts::couple( recorder, solver, meshSetting, vertexIds.front(), force );
+                  }
+                  else
+                    ts::couple( precice, solver, meshSetting, vertexIds.front(), force );
+                },
+                forceModels.front() );
+    if( trace ) {
+      trace -> close();
+      std::cout << std::format( "{}: recorded {} iterations, {} bytes, to '{}'\n",
+                                appname.string(), trace -> numRecords(),
+                                trace -> numBytes(), settings.recordFile );
+    }
+  }
+  else {
+    std::vector<ts::CoupledMesh> meshes;
+    for( ts::SizeT m = 0; m < numMeshes; ++m )
+      meshes.push_back( { solvers[m].get(), &meshSettings[m], vertexIds[m], &forceModels[m] } );
+    ts::couple( precice, std::span<const ts::CoupledMesh>( meshes ) );
   }
 
   /*
    * shutdown
    */
   precice.finalize();
-  solver.stop();
+  for( auto& solver : solvers )
+    solver -> stop();
+  if( telemetry.valid() )
+    telemetry.setStatus( ts::Telemetry::Status::finished );
+
+  /*
+   * work saved on repeated fields and displacements, per mesh
+   */
+  for( ts::SizeT m = 0; m < numMeshes; ++m ) {
+    const auto& cache = solvers[m] -> forceCache();
+    if( !cache.enabled() || !comm.isRoot() ) continue;
+    std::cout << std::format( "{}: mesh '{}': {} unchanged fields skipped, "
+                              "force cache {} hits in {} lookups\n",
+                              appname.string(), meshSettings[m].meshName,
+                              solvers[m] -> numSkipped(), cache.numHits(),
+                              cache.numLookups() );
+  }
+
+  /*
+   * phase timers, per mesh; in partitioned runs every rank writes its own
+   * trace
+   */
+  const auto& profiling = settings.profiling;
+  if( profiling.enabled && comm.isRoot() )
+    startup.writeSummary( std::cout );
+  for( ts::SizeT m = 0; m < numMeshes; ++m ) {
+    const auto& profiler = solvers[m] -> profiler();
+    if( !profiler.enabled() ) continue;
+    if( comm.isRoot() ) {
+      if( numMeshes > 1 )
+        std::cout << std::format( "mesh '{}':\n", meshSettings[m].meshName );
+      profiler.writeSummary( std::cout );
+    }
+    if( !profiling.traceFile.empty() ) {
+      std::filesystem::path traceFile = profiling.traceFile;
+      std::string suffix;
+      if( numMeshes > 1 ) suffix += std::format( "{}.", meshSettings[m].meshName );
+      if( comm.size() > 1 ) suffix += std::format( "rank{}.", comm.rank() );
+      if( !suffix.empty() ) {
+        suffix.pop_back();
+        traceFile.replace_extension( std::format( "{}{}", suffix, traceFile.extension().string() ) );
+      }
+      profiler.writeTrace( traceFile, comm.rank() );
+    }
+  }
 
   /*
    * done
@@ -184,9 +317,41 @@ int main( int argc, char* argv[] )
   const auto endTime = std::chrono::high_resolution_clock::now();
   using Seconds = std::ratio<1>;
   const std::chrono::duration<ts::Real,Seconds> diff = endTime - startTime;
-  std::cout << std::format( "{}: Total runtime = {}\n",
-                            appname.string(),
-                            diff );
+  if( comm.isRoot() )
+    std::cout << std::format( "{}: Total runtime = {} on {} rank(s)\n",
+                              appname.string(),
+                              diff,
+                              comm.size() );
                             
   return EXIT_SUCCESS;
 }
+
+} // end anonymous namespace
+
+//------------------------------------------------------------------------------
+int main( int argc, char* argv[] )
+{
+  /*
+   * each rank of 'mpirun -np N' couples its part of the point cloud
+   */
+  const ts::MpiEnvironment mpi( argc, argv );
+  const ts::Communicator   comm = ts::Communicator::world();
+
+  /*
+   * an error on one rank would leave the others blocked in the next
+   * collective, so it takes down all of them
+   */
+  try {
+    return run( argc, argv, comm );
+  }
+  catch( const std::exception& e ) {
+    std::cerr << std::filesystem::path{ argv[0] }.filename().string()
+              << ": rank " << comm.rank() << ": " << e.what() << std::endl;
+  }
+  catch( ... ) {
+    std::cerr << std::filesystem::path{ argv[0] }.filename().string()
+              << ": rank " << comm.rank() << ": unknown error" << std::endl;
+  }
+  comm.abort( EXIT_FAILURE );
+  return EXIT_FAILURE;
+}
@@ -0,0 +1,385 @@
+//------------------------------------------------------------------------------
+// <preamble>
+//
+//  ______
+// |
+// | TailSiT GmbH
+// | Graz, Austria
+//   www.tailsit.com
+//
+// </preamble>
+//------------------------------------------------------------------------------
+
+//! @author    Lars Kielhorn, Thomas Rüberg, Jürgen Zechner
+//! @date      2024
+//! @copyright TailSiT GmbH
+
+// system ----------------------------------------------------------------------
+#include <algorithm>
+#include <array>
+#include <format>
+#include <optional>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <variant>
+#include <vector>
+
+// pybind11 --------------------------------------------------------------------
+#include <pybind11/pybind11.h>
+#include <pybind11/numpy.h>
+#include <pybind11/stl.h>
+
+// own -------------------------------------------------------------------------
+#include "../types.hpp"
+#include "../Settings.hpp"
+#include "../ForceGenerator.hpp"
+#include "../ForceModels.hpp"
+#include "../Parallel.hpp"
+#include "../RigidMotion.hpp"
+#include "../yaml/parse.hpp"
+
+namespace py = pybind11;
+
+//------------------------------------------------------------------------------
+namespace {
+
+  using ts::Real;
+  using ts::SizeT;
+
+  /** C-contiguous float64 arrays; the arguments taking them do not convert,
+   *  so every array reaches C++ as a view of its own memory, or is refused
+   *  with a TypeError */
+  using Array = py::array_t<Real, py::array::c_style>;
+
+  std::span<const Real> view( const Array& array )
+  {
+    return { array.data(), static_cast<SizeT>( array.size() ) };
+  }
+
+  std::span<Real> mutableView( Array& array )
+  {
+    return { array.mutable_data(), static_cast<SizeT>( array.size() ) };
+  }
+
+  void checkSize( std::string_view where, const Array& array, SizeT expected )
+  {
+    if( static_cast<SizeT>( array.size() ) != expected ) {
+      const std::string msg = std::format( "ts::python::{}:Expected {} values, not {}",
+                                           where, expected, array.size() );
+      throw std::invalid_argument(msg);
+    }
+  }
+
+  //! x,y,z of every point
+  std::span<const Real> points( const Array& coords )
+  {
+    checkSize( "ForceGenerator::ForceGenerator", coords, static_cast<SizeT>( coords.size() ) / 3 * 3 );
+    return view( coords );
+  }
+
+  //! a fresh (n,3) array
+  Array vectors( SizeT n )
+  {
+    return Array( std::vector<py::ssize_t>{ static_cast<py::ssize_t>( n ), 3 } );
+  }
+
+  //----------------------------------------------------------------------------
+  /** A force model; pybind11/stl.h would cast a bare std::variant to and
+   *  from its alternatives instead of binding it as a class */
+  struct Force
+  {
+    ts::ForceModel model;
+  };
+
+  //----------------------------------------------------------------------------
+  //! the solver, taking and filling numpy arrays
+  class Solver
+  {
+  private:
+    ts::ForceGenerator solver_;
+
+  public:
+    Solver( const Array& coords, const ts::Settings& settings )
+      : solver_( points( coords ), settings )
+    {}
+
+    ts::ForceGenerator&       solver( )       { return solver_; }
+    const ts::ForceGenerator& solver( ) const { return solver_; }
+
+    SizeT numValues( ) const { return solver_.numCoordinates() * ts::ForceGenerator::dim(); }
+
+    void set( const std::string& fieldname, const Array& displacements )
+    {
+      checkSize( "ForceGenerator::set", displacements, numValues() );
+      const py::gil_scoped_release release;
+      solver_.set( fieldname, view( displacements ) );
+    }
+
+    Array get( const std::string& fieldname, std::optional<Array> out )
+    {
+      Array forces = out ? *out : vectors( solver_.numCoordinates() );
+      checkSize( "ForceGenerator::get", forces, numValues() );
+      {
+        const py::gil_scoped_release release;
+        solver_.get( fieldname, mutableView( forces ) );
+      }
+      return forces;
+    }
+
+    Array getCoordinates( std::optional<Array> out ) const
+    {
+      Array coords = out ? *out : vectors( solver_.numCoordinates() );
+      checkSize( "ForceGenerator::getCoordinates", coords, numValues() );
+      solver_.getCoordinates( mutableView( coords ) );
+      return coords;
+    }
+
+    void solveTimeStep( const Force& force, bool sampleForce )
+    {
+      const py::gil_scoped_release release;
+      std::visit( [&]( const auto& model ) { solver_.solveTimeStep( model, sampleForce ); },
+                  force.model );
+    }
+  };
+
+  //----------------------------------------------------------------------------
+  /** The force model at translations[i] and times[i] (or the one time
+   *  given), without rotation; the rows are split over numThreads */
+  Array evalBatch( const Force&           force,
+                   const Array&           times,
+                   const Array&           translations,
+                   std::optional<Array>   out,
+                   SizeT                  numThreads )
+  {
+    static constexpr SizeT minRowsPerThread = SizeT{1} << 12;
+    const SizeT n = static_cast<SizeT>( translations.size() ) / 3;
+    checkSize( "ForceModel::evalBatch", translations, 3*n );
+    if( times.size() != 1 )
+      checkSize( "ForceModel::evalBatch", times, n );
+    Array forces = out ? *out : vectors( n );
+    checkSize( "ForceModel::evalBatch", forces, 3*n );
+
+    const Real* t = times.data();
+    const Real* U = translations.data();
+    Real*       F = forces.mutable_data();
+    const SizeT timeStride = times.size() == 1 ? 0 : 1;
+    const SizeT numChunks  = std::min( ts::parallel::numThreads( numThreads ),
+                                       std::max<SizeT>( 1, n / minRowsPerThread ) );
+    const py::gil_scoped_release release;
+    std::visit( [&]( const auto& model ) {
+                  ts::parallel::forEachChunk( n, numChunks, [&]( SizeT, SizeT begin, SizeT end ) {
+                    ts::RigidMotion motion;
+                    for( SizeT i = begin; i < end; ++i ) {
+                      std::copy_n( U + 3*i, 3, motion.translation.begin() );
+                      model( t[timeStride*i], motion, std::span<Real>( F + 3*i, 3 ) );
+                    }
+                  } );
+                },
+                force.model );
+    return forces;
+  }
+
+} // end anonymous namespace
+
+//------------------------------------------------------------------------------
+PYBIND11_MODULE( ts_force_generator, m )
+{
+  m.doc() = "The TailSiT force generator and its force models, in process";
+
+  /*
+   * settings
+   */
+  py::class_<ts::SigmoidForceSettings>( m, "SigmoidForceSettings" )
+    .def( py::init<>() )
+    .def_readwrite( "mass",    &ts::SigmoidForceSettings::mass )
+    .def_readwrite( "gravity", &ts::SigmoidForceSettings::gravity )
+    .def_readwrite( "slope",   &ts::SigmoidForceSettings::slope )
+    .def_readwrite( "terms",   &ts::SigmoidForceSettings::terms )
+    .def_readwrite( "axis",    &ts::SigmoidForceSettings::axis );
+
+  py::class_<ts::PolynomialForceSettings>( m, "PolynomialForceSettings" )
+    .def( py::init<>() )
+    .def_readwrite( "coefficients", &ts::PolynomialForceSettings::coefficients )
+    .def_readwrite( "axis",         &ts::PolynomialForceSettings::axis );
+
+  py::class_<ts::ForceTableSettings> table( m, "ForceTableSettings" );
+  py::enum_<ts::ForceTableSettings::Grid>( table, "Grid" )
+    .value( "axial",     ts::ForceTableSettings::Grid::axial )
+    .value( "cartesian", ts::ForceTableSettings::Grid::cartesian );
+  py::enum_<ts::ForceTableSettings::Interpolation>( table, "Interpolation" )
+    .value( "linear", ts::ForceTableSettings::Interpolation::linear )
+    .value( "cubic",  ts::ForceTableSettings::Interpolation::cubic );
+  table
+    .def( py::init<>() )
+    .def_readwrite( "file",          &ts::ForceTableSettings::file )
+    .def_readwrite( "grid",          &ts::ForceTableSettings::grid )
+    .def_readwrite( "interpolation", &ts::ForceTableSettings::interpolation )
+    .def_readwrite( "resolution",    &ts::ForceTableSettings::resolution );
+
+  py::class_<ts::ForceModelSettings>( m, "ForceModelSettings" )
+    .def( py::init<>() )
+    .def_readwrite( "type",       &ts::ForceModelSettings::type )
+    .def_readwrite( "sigmoid",    &ts::ForceModelSettings::sigmoid )
+    .def_readwrite( "polynomial", &ts::ForceModelSettings::polynomial )
+    .def_readwrite( "table",      &ts::ForceModelSettings::table );
+
+  py::class_<ts::ForceCacheSettings>( m, "ForceCacheSettings" )
+    .def( py::init<>() )
+    .def_readwrite( "enabled",          &ts::ForceCacheSettings::enabled )
+    .def_readwrite( "tolerance",        &ts::ForceCacheSettings::tolerance )
+    .def_readwrite( "angularTolerance", &ts::ForceCacheSettings::angularTolerance )
+    .def_readwrite( "capacity",         &ts::ForceCacheSettings::capacity );
+
+  py::class_<ts::DecimationSettings>( m, "DecimationSettings" )
+    .def( py::init<>() )
+    .def_readwrite( "enabled",     &ts::DecimationSettings::enabled )
+    .def_readwrite( "voxelSize",   &ts::DecimationSettings::voxelSize )
+    .def_readwrite( "targetCount", &ts::DecimationSettings::targetCount );
+
+  py::class_<ts::ProfilingSettings>( m, "ProfilingSettings" )
+    .def( py::init<>() )
+    .def_readwrite( "enabled",        &ts::ProfilingSettings::enabled )
+    .def_readwrite( "traceFile",      &ts::ProfilingSettings::traceFile )
+    .def_readwrite( "maxTraceEvents", &ts::ProfilingSettings::maxTraceEvents );
+
+  py::class_<ts::TelemetrySettings>( m, "TelemetrySettings" )
+    .def( py::init<>() )
+    .def_readwrite( "enabled", &ts::TelemetrySettings::enabled )
+    .def_readwrite( "name",    &ts::TelemetrySettings::name );
+
+  py::class_<ts::TimeStepSettings>( m, "TimeStepSettings" )
+    .def( py::init<>() )
+    .def_readwrite( "adaptive",   &ts::TimeStepSettings::adaptive )
+    .def_readwrite( "dtMin",      &ts::TimeStepSettings::dtMin )
+    .def_readwrite( "dtMax",      &ts::TimeStepSettings::dtMax )
+    .def_readwrite( "tolerance",  &ts::TimeStepSettings::tolerance )
+    .def_readwrite( "forceScale", &ts::TimeStepSettings::forceScale )
+    .def_readwrite( "safety",     &ts::TimeStepSettings::safety )
+    .def_readwrite( "maxGrowth",  &ts::TimeStepSettings::maxGrowth );
+
+  py::class_<ts::SubcyclingSettings>( m, "SubcyclingSettings" )
+    .def( py::init<>() )
+    .def_readwrite( "enabled",     &ts::SubcyclingSettings::enabled )
+    .def_readwrite( "numSubsteps", &ts::SubcyclingSettings::numSubsteps );
+
+  py::class_<ts::MeshSettings>( m, "MeshSettings" )
+    .def( py::init<>() )
+    .def_readwrite( "meshName",         &ts::MeshSettings::meshName )
+    .def_readwrite( "pointCloud",       &ts::MeshSettings::pointCloud )
+    .def_readwrite( "pointCloudRegion", &ts::MeshSettings::pointCloudRegion )
+    .def_readwrite( "inField",          &ts::MeshSettings::inField )
+    .def_readwrite( "outField",         &ts::MeshSettings::outField )
+    .def_readwrite( "samplesFile",      &ts::MeshSettings::samplesFile )
+    .def_readwrite( "forceModel",       &ts::MeshSettings::forceModel );
+
+  py::class_<ts::Settings> settings( m, "Settings" );
+  py::enum_<ts::Settings::ForceField>( settings, "ForceField" )
+    .value( "uniform",   ts::Settings::ForceField::uniform )
+    .value( "perVertex", ts::Settings::ForceField::perVertex );
+  py::enum_<ts::Settings::VertexOrdering>( settings, "VertexOrdering" )
+    .value( "input",   ts::Settings::VertexOrdering::input )
+    .value( "morton",  ts::Settings::VertexOrdering::morton )
+    .value( "hilbert", ts::Settings::VertexOrdering::hilbert );
+  settings
+    .def( py::init<>() )
+    .def_static( "fromYaml", []( const std::string& file ) { return ts::yaml::parse( file ); },
+                 "the 'settings' block of an adapter configuration", py::arg( "file" ) )
+    .def( "__repr__", []( const ts::Settings& s ) { return ts::yaml::Parser::asString( s ); } )
+    .def_readwrite( "solverName",           &ts::Settings::solverName )
+    .def_readwrite( "meshName",             &ts::Settings::meshName )
+    .def_readwrite( "inField",              &ts::Settings::inField )
+    .def_readwrite( "outField",             &ts::Settings::outField )
+    .def_readwrite( "dt",                   &ts::Settings::dt )
+    .def_readwrite( "endt",                 &ts::Settings::endt )
+    .def_readwrite( "numCheckpoints",       &ts::Settings::numCheckpoints )
+    .def_readwrite( "numThreads",           &ts::Settings::numThreads )
+    .def_readwrite( "pointCloudRegion",     &ts::Settings::pointCloudRegion )
+    .def_readwrite( "vertexOrdering",       &ts::Settings::vertexOrdering )
+    .def_readwrite( "decimation",           &ts::Settings::decimation )
+    .def_readwrite( "timeStep",             &ts::Settings::timeStep )
+    .def_readwrite( "subcycling",           &ts::Settings::subcycling )
+    .def_readwrite( "samplesFile",          &ts::Settings::samplesFile )
+    .def_readwrite( "convergedSamplesOnly", &ts::Settings::convergedSamplesOnly )
+    .def_readwrite( "binarySamples",        &ts::Settings::binarySamples )
+    .def_readwrite( "forceModel",           &ts::Settings::forceModel )
+    .def_readwrite( "forceField",           &ts::Settings::forceField )
+    .def_readwrite( "forceCache",           &ts::Settings::forceCache )
+    .def_readwrite( "profiling",            &ts::Settings::profiling )
+    .def_readwrite( "telemetry",            &ts::Settings::telemetry )
+    .def_readwrite( "recordFile",           &ts::Settings::recordFile )
+    .def_readwrite( "meshes",               &ts::Settings::meshes );
+
+  /*
+   * force models
+   */
+  py::class_<ts::RigidMotion>( m, "RigidMotion" )
+    .def( py::init<>() )
+    .def_readwrite( "translation", &ts::RigidMotion::translation )
+    .def_readwrite( "rotation",    &ts::RigidMotion::rotation )
+    .def_readwrite( "center",      &ts::RigidMotion::center );
+
+  py::class_<Force>( m, "ForceModel" )
+    .def( py::init( []( const ts::ForceModelSettings& s ) { return Force{ ts::makeForceModel( s ) }; } ),
+          py::arg( "settings" ) = ts::ForceModelSettings() )
+    .def_property_readonly( "name", []( const Force& force ) {
+      return std::string( std::visit( []( const auto& model ) {
+                                        return std::decay_t<decltype(model)>::name;
+                                      },
+                                      force.model ) );
+    } )
+    .def( "__call__", []( const Force& force, Real time, const ts::RigidMotion& motion ) {
+      std::array<Real,3> F;
+      std::visit( [&]( const auto& model ) { model( time, motion, F ); }, force.model );
+      return F;
+    }, py::arg( "time" ), py::arg( "motion" ) )
+    .def( "__call__", []( const Force& force, Real time, const std::array<Real,3>& U ) {
+      ts::RigidMotion motion;
+      motion.translation = U;
+      std::array<Real,3> F;
+      std::visit( [&]( const auto& model ) { model( time, motion, F ); }, force.model );
+      return F;
+    }, py::arg( "time" ), py::arg( "translation" ) )
+    .def( "evalBatch", &evalBatch,
+          "forces (n,3) at the translations (n,3) and times (n or 1), without rotation",
+          py::arg( "times" ).noconvert(), py::arg( "translations" ).noconvert(),
+          py::arg( "out" ).noconvert() = py::none(), py::arg( "numThreads" ) = 0 );
+
+  m.def( "forceModelNames", []() {
+    std::vector<std::string> names;
+    for( const auto name : ts::forceModelNames() ) names.emplace_back( name );
+    return names;
+  } );
+
+  /*
+   * the solver; fields are float64 arrays of numCoordinates x 3 values
+   */
+  py::class_<Solver>( m, "ForceGenerator" )
+    .def( py::init<const Array&, const ts::Settings&>(),
+          py::arg( "coords" ).noconvert(), py::arg( "settings" ) = ts::Settings() )
+    .def( "start",          []( Solver& s ) { s.solver().start(); } )
+    .def( "stop",           []( Solver& s ) { s.solver().stop(); } )
+    .def( "beginTimeStep",  []( Solver& s ) { return s.solver().beginTimeStep(); } )
+    .def( "endTimeStep",    []( Solver& s, Real dt ) { s.solver().endTimeStep( dt ); },
+          py::arg( "dt" ) )
+    .def( "endSubstep",     []( Solver& s, Real dt ) { s.solver().endSubstep( dt ); },
+          py::arg( "dt" ) )
+    .def( "endWindow",      []( Solver& s ) { s.solver().endWindow(); } )
+    .def( "saveOldState",   []( Solver& s ) { s.solver().saveOldState(); } )
+    .def( "reloadOldState", []( Solver& s, SizeT windowsBack ) {
+      s.solver().reloadOldState( windowsBack );
+    }, py::arg( "windowsBack" ) = 0 )
+    .def( "set", &Solver::set, py::arg( "fieldname" ), py::arg( "displacements" ).noconvert() )
+    .def( "get", &Solver::get, "the forces, into out if given",
+          py::arg( "fieldname" ) = "Forces", py::arg( "out" ).noconvert() = py::none() )
+    .def( "getCoordinates", &Solver::getCoordinates, "in the input order, into out if given",
+          py::arg( "out" ).noconvert() = py::none() )
+    .def( "solveTimeStep", &Solver::solveTimeStep,
+          py::arg( "forceModel" ), py::arg( "sampleForce" ) = false )
+    .def_property_readonly( "currentTime",    []( const Solver& s ) { return s.solver().currentTime(); } )
+    .def_property_readonly( "forcesVersion",  []( const Solver& s ) { return s.solver().forcesVersion(); } )
+    .def_property_readonly( "numCoordinates", []( const Solver& s ) { return s.solver().numCoordinates(); } )
+    .def_property_readonly( "numSkipped",     []( const Solver& s ) { return s.solver().numSkipped(); } )
+    .def_property_readonly( "rigidMotion",    []( const Solver& s ) { return s.solver().rigidMotion(); } );
+}
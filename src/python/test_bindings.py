@@ -0,0 +1,101 @@
+import os
+import sys
+import tempfile
+
+import numpy as np
+
+import ts_force_generator as tsfg
+
+# ROUND TRIPS OF THE ts_force_generator MODULE
+# run with the module on the path, e.g. by ctest:
+#   PYTHONPATH=<build dir> python3 test_bindings.py
+
+def test_settings( workdir: str ):
+    s = tsfg.Settings()
+    s.pointCloudRegion = "MAGNET"
+    s.vertexOrdering = tsfg.Settings.VertexOrdering.hilbert
+    s.timeStep.adaptive = True
+    s.timeStep.dtMin = 2e-5
+    s.subcycling.enabled = True
+    s.subcycling.numSubsteps = 3
+    s.decimation.enabled = True
+    s.decimation.voxelSize = 1e-3
+    s.forceCache.enabled = True
+    s.forceCache.capacity = 64
+    s.profiling.traceFile = "trace.json"
+    s.telemetry.name = "ts_test_bindings"
+    s.recordFile = "coupling.bin"
+    mesh = tsfg.MeshSettings()
+    mesh.meshName = "upper"
+    mesh.forceModel.type = "polynomial"
+    s.meshes = [ mesh ]
+    # nested settings are references into s
+    assert s.timeStep.adaptive and s.subcycling.numSubsteps == 3
+
+    # through the YAML of the adapter and back
+    filename = os.path.join( workdir, "settings.yaml" )
+    with open( filename, "w" ) as f:
+        f.write( repr( s ) )
+    r = tsfg.Settings.fromYaml( filename )
+    assert r.pointCloudRegion == "MAGNET"
+    assert r.vertexOrdering == tsfg.Settings.VertexOrdering.hilbert
+    assert r.timeStep.adaptive and r.timeStep.dtMin == 2e-5
+    assert r.subcycling.enabled and r.subcycling.numSubsteps == 3
+    assert r.decimation.voxelSize == 1e-3
+    assert r.forceCache.enabled and r.forceCache.capacity == 64
+    assert r.profiling.traceFile == "trace.json"
+    assert r.telemetry.name == "ts_test_bindings"
+    assert r.recordFile == "coupling.bin"
+    assert len( r.meshes ) == 1
+    assert r.meshes[0].meshName == "upper" and r.meshes[0].forceModel.type == "polynomial"
+
+def test_solver( workdir: str ):
+    s = tsfg.Settings()
+    s.samplesFile = os.path.join( workdir, "forces.csv" )
+    s.vertexOrdering = tsfg.Settings.VertexOrdering.hilbert
+    coords = np.random.default_rng( 0 ).uniform( -5e-3, 5e-3, (1000,3) )
+    model = tsfg.ForceModel( s.forceModel )
+    solver = tsfg.ForceGenerator( coords, s )
+    assert solver.numCoordinates == len( coords )
+    assert np.array_equal( solver.getCoordinates(), coords )
+
+    solver.start()
+    U = np.zeros_like( coords )
+    U[:,2] = -2e-2
+    solver.set( "Displacements", U )
+    solver.solveTimeStep( model )
+    F = solver.get( "Forces" )
+    assert np.allclose( F.sum( axis=0 ), model( 0.0, [0.0, 0.0, -2e-2] ) )
+
+    # a caller's buffer is refilled on every get, changed forces or not
+    out = np.full_like( coords, np.nan )
+    solver.get( "Forces", out )
+    assert np.array_equal( out, F )
+    out[:] = np.nan
+    solver.get( "Forces", out )
+    assert np.array_equal( out, F )
+    solver.stop()
+
+    # views only: no silent copies
+    try:
+        solver.set( "Displacements", U.astype( np.float32 ) )
+    except TypeError:
+        pass
+    else:
+        raise AssertionError( "float32 displacements were converted" )
+
+def test_force_model():
+    model = tsfg.ForceModel()
+    assert model.name in tsfg.forceModelNames()
+    U = np.zeros( (100,3) )
+    U[:,2] = np.linspace( 0.0, -5e-2, len( U ) )
+    F = model.evalBatch( np.zeros( 1 ), U, numThreads=2 )
+    for i in range( len( U ) ):
+        assert np.allclose( F[i], model( 0.0, U[i] ) )
+
+if __name__ == "__main__":
+    with tempfile.TemporaryDirectory() as workdir:
+        test_settings( workdir )
+        test_solver( workdir )
+    test_force_model()
+    print( "{}: ok".format( os.path.basename( sys.argv[0] ) ) )
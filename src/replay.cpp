@@ -0,0 +1,106 @@
+//------------------------------------------------------------------------------
+// <preamble>
+//
+//  ______
+// |
+// | TailSiT GmbH
+// | Graz, Austria
+//   www.tailsit.com
+//
+// </preamble>
+//------------------------------------------------------------------------------
+
+//! @author    Lars Kielhorn, Thomas Rüberg, Jürgen Zechner
+//! @date      2024
+//! @copyright TailSiT GmbH
+
+// system ----------------------------------------------------------------------
+#include <chrono>
+#include <cstdlib>
+#include <filesystem>
+#include <format>
+#include <iostream>
+#include <numeric>
+#include <string>
+#include <variant>
+#include <vector>
+
+// own -------------------------------------------------------------------------
+#include "types.hpp"
+#include "Settings.hpp"
+#include "Coupling.hpp"
+#include "CouplingTrace.hpp"
+#include "ForceGenerator.hpp"
+#include "ForceModels.hpp"
+#include "PointCloudCache.hpp"
+#include "TraceParticipant.hpp"
+#include "yaml/parse.hpp"
+
+//------------------------------------------------------------------------------
+int main( int argc, char* argv[] )
+{
+  const std::filesystem::path appname = std::filesystem::path{ argv[0] }.filename();
+  if( argc != 4 && argc != 5 ) {
+    std::cerr << "usage: " << appname.string() << " coords.csv config.yaml trace.bin [tolerance]\n"
+              << "  replays a trace recorded with 'recordFile'; forces must match\n"
+              << "  bit for bit, or within the absolute tolerance if given"
+              << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  const auto startTime = std::chrono::steady_clock::now();
+  const std::filesystem::path csvFile( argv[1] );
+  const std::filesystem::path yamlFile( argv[2] );
+  const std::filesystem::path traceFile( argv[3] );
+  const ts::Real tolerance = argc == 5 ? std::stod( argv[4] ) : 0;
+
+  /*
+   * the recorded settings, but the samples go next to the trace
+   */
+  ts::Settings settings = ts::yaml::parse( yamlFile );
+  auto samplesFile = traceFile;
+  settings.samplesFile = samplesFile.replace_extension( ".replay.csv" ).string();
+  settings.recordFile.clear();
+  ts::yaml::Parser::dump( std::cout, settings );
+
+  const ts::ForceModel forceModel = ts::makeForceModel( settings.forceModel );
+  static constexpr auto numColsInCSV = 3;
+  const auto pointCloud = ts::PointCloudCache::load<numColsInCSV>( csvFile );
+  ts::ForceGenerator solver( pointCloud.coordinates(), settings );
+
+  ts::CouplingTrace::Reader trace( traceFile );
+  const ts::SizeT numValues = solver.numCoordinates() * solver.dim();
+  if( trace.numDisplacements() != numValues || trace.numForces() != numValues ) {
+    std::cerr << std::format( "{}: trace of {} values does not fit {} coordinates\n",
+                              appname.string(), trace.numDisplacements(), solver.numCoordinates() );
+    return EXIT_FAILURE;
+  }
+
+  /*
+   * the coupling loop, driven by the trace
+   */
+  ts::TraceParticipant participant( trace, tolerance );
+  solver.start();
+  std::vector<ts::Int> vertexIds( solver.numCoordinates() );
+  std::iota( vertexIds.begin(), vertexIds.end(), 0 );
+  std::visit( [&]( const auto& force ) {
+                ts::couple( participant, solver, settings, vertexIds, force );
+              },
+              forceModel );
+  solver.stop();
+
+  const std::chrono::duration<ts::Real> diff = std::chrono::steady_clock::now() - startTime;
+  std::cout << std::format( "{}: {} iterations replayed in {:.3f} s, max force deviation {:.4e}\n",
+                            appname.string(), participant.numIterations(), diff.count(),
+                            participant.maxDeviation() );
+  if( participant.numMismatches() > 0 ) {
+    std::cout << std::format( "{}: FAILED, {} iterations differ, the first is iteration {}\n",
+                              appname.string(), participant.numMismatches(),
+                              participant.firstMismatch() );
+    return EXIT_FAILURE;
+  }
+  std::cout << std::format( "{}: forces match {}\n", appname.string(),
+                            tolerance > 0 ? std::format( "within {:.4e}", tolerance )
+                                          : std::string( "bit for bit" ) );
+  return EXIT_SUCCESS;
+}
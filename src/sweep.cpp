@@ -0,0 +1,101 @@
+//------------------------------------------------------------------------------
+// <preamble>
+//
+//  ______
+// |
+// | TailSiT GmbH
+// | Graz, Austria
+//   www.tailsit.com
+//
+// </preamble>
+//------------------------------------------------------------------------------
+
+//! @author    Lars Kielhorn, Thomas Rüberg, Jürgen Zechner
+//! @date      2024
+//! @copyright TailSiT GmbH
+
+// system ----------------------------------------------------------------------
+#include <chrono>
+#include <cstdlib>
+#include <filesystem>
+#include <format>
+#include <fstream>
+#include <iostream>
+
+// yaml-cpp --------------------------------------------------------------------
+#include <yaml-cpp/yaml.h>
+
+// own -------------------------------------------------------------------------
+#include "types.hpp"
+#include "Settings.hpp"
+#include "PointCloudCache.hpp"
+#include "Sweep.hpp"
+#include "yaml/parse.hpp"
+#include "yaml/Settings.hpp"
+
+//------------------------------------------------------------------------------
+int main( int argc, char* argv[] )
+{
+  const std::filesystem::path appname = std::filesystem::path{ argv[0] }.filename();
+  if( argc != 3 ) {
+    std::cerr << "usage: " << appname.string() << " coords.csv sweep.yaml\n"
+              << "  sweep.yaml holds the base 'settings' and the 'sweep' block"
+              << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  const auto startTime = std::chrono::steady_clock::now();
+  const std::filesystem::path csvFile( argv[1] );
+  const std::filesystem::path yamlFile( argv[2] );
+
+  /*
+   * base settings and the values swept over
+   */
+  const ts::Settings      base  = ts::yaml::parse( yamlFile );
+  const ts::SweepSettings sweep = ts::yaml::parseSweep( yamlFile );
+  ts::yaml::Parser::dump( std::cout, base );
+  ts::yaml::Parser::dump( std::cout, sweep );
+
+  /*
+   * all runs share the point cloud
+   */
+  static constexpr auto numColsInCSV = 3;
+  const auto pointCloud = ts::PointCloudCache::load<numColsInCSV>( csvFile );
+  const ts::Sweep sweeper( base, sweep );
+  const auto results = sweeper.run( pointCloud.coordinates() );
+
+  /*
+   * report, and keep every run's settings and outcome next to its samples
+   */
+  std::cout << std::format( "{:>6s} {:>10s} {:>10s} {:<12s} {:>8s} {:>12s}  {}\n",
+                            "run", "dt", "endt", "forceModel", "windows", "time [s]", "samples" );
+  YAML::Node index;
+  bool ok = true;
+  for( const auto& result : results ) {
+    const auto& settings = sweeper.runs()[result.run];
+    std::cout << std::format( "{:>6d} {:>10.3e} {:>10.3e} {:<12s} {:>8d} {:>12.4e}  {}\n",
+                              result.run, settings.dt, settings.endt,
+                              settings.forceModel.type, result.numWindows, result.seconds,
+                              result.error.empty() ? result.samplesFile.string()
+                                                   : "FAILED: " + result.error );
+    ok = ok && result.error.empty();
+
+    YAML::Node entry;
+    entry["run"]      = result.run;
+    entry["settings"] = settings;
+    entry["seconds"]  = result.seconds;
+    entry["forceSum"] = result.forceSum;
+    if( !result.error.empty() ) entry["error"] = result.error;
+    index.push_back( entry );
+  }
+
+  if( !results.empty() ) {
+    const auto indexFile = results.front().samplesFile.parent_path() / "runs.yaml";
+    std::ofstream( indexFile ) << index << std::endl;
+  }
+
+  const std::chrono::duration<ts::Real> diff = std::chrono::steady_clock::now() - startTime;
+  std::cout << std::format( "{}: {} runs in {:.3f} s\n", appname.string(), results.size(), diff.count() );
+
+  return ok ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,135 @@
+//------------------------------------------------------------------------------
+// <preamble>
+//
+//  ______
+// |
+// | TailSiT GmbH
+// | Graz, Austria
+//   www.tailsit.com
+//
+// </preamble>
+//------------------------------------------------------------------------------
+
+//! @author    Lars Kielhorn, Thomas Rüberg, Jürgen Zechner
+//! @date      2024
+//! @copyright TailSiT GmbH
+
+// system ----------------------------------------------------------------------
+#include <chrono>
+#include <cstdlib>
+#include <exception>
+#include <filesystem>
+#include <format>
+#include <iostream>
+#include <string>
+#include <string_view>
+#include <thread>
+
+// own -------------------------------------------------------------------------
+#include "types.hpp"
+#include "Profiler.hpp"
+#include "Telemetry.hpp"
+
+//------------------------------------------------------------------------------
+namespace {
+
+  std::string_view statusName( ts::Telemetry::Status status )
+  {
+    using Status = ts::Telemetry::Status;
+    if     ( status == Status::starting ) return "starting";
+    else if( status == Status::coupling ) return "coupling";
+    else if( status == Status::finished ) return "finished";
+    else                                  return "unknown";
+  }
+
+  //! every mesh with its counters and phase totals
+  void writeSnapshot( std::ostream& out, const ts::Telemetry& telemetry )
+  {
+    const ts::Real now = ts::Telemetry::now();
+    for( ts::SizeT m = 0; m < telemetry.numMeshes(); ++m ) {
+      const auto c = telemetry.read( m );
+      out << std::format( "mesh '{}': t = {:.6e}, window {}, iteration {}, "
+                          "{} iterations, {} reloads, {} skipped, updated {:.2f} s ago\n",
+                          telemetry.meshName( m ), c.time, c.window, c.iteration,
+                          c.numIterations, c.numReloads, c.numSkipped, now - c.updated )
+          << std::format( "  U = ({:.6e}, {:.6e}, {:.6e})\n"
+                          "  F = ({:.6e}, {:.6e}, {:.6e})\n",
+                          c.translation[0], c.translation[1], c.translation[2],
+                          c.force[0], c.force[1], c.force[2] );
+      if( !c.profiling ) {
+        out << "  phases: profiling off\n";
+        continue;
+      }
+      for( ts::SizeT p = 0; p < ts::Profiler::numPhases; ++p )
+        if( c.phaseCalls[p] )
+          out << std::format( "  {:<18s} {:>10d} {:>12.4e} s\n",
+                              ts::Profiler::phaseNames[p], c.phaseCalls[p], c.phaseTotals[p] );
+    }
+  }
+
+  //! one row per mesh and tick
+  void writeRows( std::ostream& out, const ts::Telemetry& telemetry, ts::Real elapsed )
+  {
+    const ts::Real now = ts::Telemetry::now();
+    for( ts::SizeT m = 0; m < telemetry.numMeshes(); ++m ) {
+      const auto c = telemetry.read( m );
+      out << std::format( "{:>9.2f} {:<16s} {:>13.6e} {:>8d} {:>4d} {:>10d} {:>8d} {:>8.2f} "
+                          "{:>13.6e} {:>13.6e}\n",
+                          elapsed, telemetry.meshName( m ), c.time, c.window, c.iteration,
+                          c.numIterations, c.numReloads, now - c.updated,
+                          c.translation[2], c.force[2] );
+    }
+    out.flush();
+  }
+
+} // end anonymous namespace
+
+//------------------------------------------------------------------------------
+int main( int argc, char* argv[] )
+{
+  const std::filesystem::path appname = std::filesystem::path{ argv[0] }.filename();
+  const bool follow = argc == 4 && std::string_view( argv[2] ) == "--follow";
+  if( argc != 2 && !follow ) {
+    std::cerr << "usage: " << appname.string() << " name [--follow seconds]\n"
+              << "  prints the live counters of the adapter publishing 'telemetry' under\n"
+              << "  name (its solverName by default); with --follow a row per mesh every\n"
+              << "  interval until the run finishes"
+              << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  try {
+    const ts::Telemetry telemetry = ts::Telemetry::attach( argv[1] );
+    std::cout << std::format( "{}: '{}' of process {}, {}\n", appname.string(), telemetry.name(),
+                              telemetry.pid(), statusName( telemetry.status() ) );
+    if( !follow ) {
+      writeSnapshot( std::cout, telemetry );
+      return EXIT_SUCCESS;
+    }
+
+    const auto interval = std::chrono::duration<ts::Real>( std::stod( argv[3] ) );
+    const auto start    = std::chrono::steady_clock::now();
+    std::cout << std::format( "{:>9s} {:<16s} {:>13s} {:>8s} {:>4s} {:>10s} {:>8s} {:>8s} "
+                              "{:>13s} {:>13s}\n",
+                              "wall [s]", "mesh", "t", "window", "it", "iterations",
+                              "reloads", "age [s]", "U2", "F2" );
+    for( ;; ) {
+      // read the status first: rows after 'finished' are final
+      const auto status = telemetry.status();
+      const std::chrono::duration<ts::Real> elapsed = std::chrono::steady_clock::now() - start;
+      writeRows( std::cout, telemetry, elapsed.count() );
+      if( status == ts::Telemetry::Status::finished ) break;
+      if( !ts::Telemetry::alive( telemetry.pid() ) ) {
+        std::cout << std::format( "{}: process {} is gone\n", appname.string(), telemetry.pid() );
+        return EXIT_FAILURE;
+      }
+      std::this_thread::sleep_for( interval );
+    }
+    std::cout << std::format( "{}: run finished\n", appname.string() );
+  }
+  catch( const std::exception& e ) {
+    std::cerr << appname.string() << ": " << e.what() << std::endl;
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
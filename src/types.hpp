@@ -24,5 +24,12 @@ namespace ts {
   using Real  = double;
   using Int   = int;
   using SizeT = std::size_t;
+
+  //! per-vertex fields of the solver; sums and forces are computed in Real
+#ifdef TS_FLOAT_STORAGE
+  using Storage = float;
+#else
+  using Storage = Real;
+#endif
     
 } //end namespace ts
@@ -14,6 +14,9 @@
 //! @date      2024
 //! @copyright TailSiT GmbH
 
+// system ----------------------------------------------------------------------
+#include <utility>
+
 // own -------------------------------------------------------------------------
 #include "../types.hpp"
 #include "Settings.hpp"
@@ -21,6 +24,276 @@
 //------------------------------------------------------------------------------
 namespace YAML {
 
+  //----------------------------------------------------------------------------
+  Node convert< ts::ForceTableSettings >::encode( const ts::ForceTableSettings& table )
+  {
+    using Grid          = ts::ForceTableSettings::Grid;
+    using Interpolation = ts::ForceTableSettings::Interpolation;
+    Node node;
+    node["file"]          = table.file;
+    node["grid"]          = table.grid == Grid::axial ? "1d" : "3d";
+    node["interpolation"] = table.interpolation == Interpolation::linear ? "linear" : "cubic";
+    node["resolution"]    = table.resolution;
+    return node;
+  }
+
+  //----------------------------------------------------------------------------
+  bool convert< ts::ForceTableSettings >::decode( const Node& node,
+                                                  ts::ForceTableSettings& table )
+  {
+    using Grid          = ts::ForceTableSettings::Grid;
+    using Interpolation = ts::ForceTableSettings::Interpolation;
+    table.file = node["file"].as<std::string>();
+    if( node["grid"] ) {
+      const auto grid = node["grid"].as<std::string>();
+      if     ( grid == "1d" ) table.grid = Grid::axial;
+      else if( grid == "3d" ) table.grid = Grid::cartesian;
+      else return false;
+    }
+    if( node["interpolation"] ) {
+      const auto interpolation = node["interpolation"].as<std::string>();
+      if     ( interpolation == "linear" ) table.interpolation = Interpolation::linear;
+      else if( interpolation == "cubic"  ) table.interpolation = Interpolation::cubic;
+      else return false;
+    }
+    if( node["resolution"] )
+      table.resolution = node["resolution"].as<ts::SizeT>();
+    return true;
+  }
+
+  //----------------------------------------------------------------------------
+  Node convert< ts::SigmoidForceSettings >::encode( const ts::SigmoidForceSettings& sigmoid )
+  {
+    Node node;
+    node["mass"]    = sigmoid.mass;
+    node["gravity"] = sigmoid.gravity;
+    node["slope"]   = sigmoid.slope;
+    node["terms"]   = sigmoid.terms;
+    node["axis"]    = sigmoid.axis;
+    return node;
+  }
+
+  //----------------------------------------------------------------------------
+  bool convert< ts::SigmoidForceSettings >::decode( const Node& node,
+                                                    ts::SigmoidForceSettings& sigmoid )
+  {
+    if( node["mass"] )    sigmoid.mass    = node["mass"].as<ts::Real>();
+    if( node["gravity"] ) sigmoid.gravity = node["gravity"].as<ts::Real>();
+    if( node["slope"] )   sigmoid.slope   = node["slope"].as<ts::Real>();
+    if( node["terms"] )
+      sigmoid.terms = node["terms"].as<std::vector<ts::SigmoidForceSettings::Term>>();
+    if( node["axis"] )    sigmoid.axis    = node["axis"].as<ts::SizeT>();
+    return sigmoid.axis < 3;
+  }
+
+  //----------------------------------------------------------------------------
+  Node convert< ts::PolynomialForceSettings >::encode( const ts::PolynomialForceSettings& polynomial )
+  {
+    Node node;
+    node["coefficients"] = polynomial.coefficients;
+    node["axis"]         = polynomial.axis;
+    return node;
+  }
+
+  //----------------------------------------------------------------------------
+  bool convert< ts::PolynomialForceSettings >::decode( const Node& node,
+                                                       ts::PolynomialForceSettings& polynomial )
+  {
+    polynomial.coefficients = node["coefficients"].as<std::vector<ts::Real>>();
+    if( node["axis"] ) polynomial.axis = node["axis"].as<ts::SizeT>();
+    return polynomial.axis < 3 && !polynomial.coefficients.empty();
+  }
+
+  //----------------------------------------------------------------------------
+  Node convert< ts::ForceModelSettings >::encode( const ts::ForceModelSettings& model )
+  {
+    Node node;
+    node["type"] = model.type;
+    if( model.type == "sigmoid" )    node["sigmoid"]    = model.sigmoid;
+    if( model.type == "polynomial" ) node["polynomial"] = model.polynomial;
+    if( model.type == "tabulated" )  node["table"]      = model.table;
+    return node;
+  }
+
+  //----------------------------------------------------------------------------
+  bool convert< ts::ForceModelSettings >::decode( const Node& node,
+                                                  ts::ForceModelSettings& model )
+  {
+    // 'forceModel: sigmoid' is short for a model with default parameters
+    if( node.IsScalar() ) {
+      model.type = node.as<std::string>();
+      return true;
+    }
+    model.type = node["type"].as<std::string>();
+    if( node["sigmoid"] )
+      model.sigmoid = node["sigmoid"].as<ts::SigmoidForceSettings>();
+    if( node["polynomial"] )
+      model.polynomial = node["polynomial"].as<ts::PolynomialForceSettings>();
+    if( node["table"] )
+      model.table = node["table"].as<ts::ForceTableSettings>();
+    return true;
+  }
+
+  //----------------------------------------------------------------------------
+  Node convert< ts::ForceCacheSettings >::encode( const ts::ForceCacheSettings& cache )
+  {
+    Node node;
+    node["enabled"]          = cache.enabled;
+    node["tolerance"]        = cache.tolerance;
+    node["angularTolerance"] = cache.angularTolerance;
+    node["capacity"]         = cache.capacity;
+    return node;
+  }
+
+  //----------------------------------------------------------------------------
+  bool convert< ts::ForceCacheSettings >::decode( const Node& node,
+                                                  ts::ForceCacheSettings& cache )
+  {
+    // 'forceCache: true' caches exact rigid motions
+    if( node.IsScalar() ) {
+      cache.enabled = node.as<bool>();
+      return true;
+    }
+    if( node["enabled"] )   cache.enabled   = node["enabled"].as<bool>();
+    if( node["tolerance"] ) cache.tolerance = node["tolerance"].as<ts::Real>();
+    if( node["angularTolerance"] )
+      cache.angularTolerance = node["angularTolerance"].as<ts::Real>();
+    if( node["capacity"] )  cache.capacity  = node["capacity"].as<ts::SizeT>();
+    return cache.tolerance >= 0 && cache.angularTolerance >= 0 && cache.capacity > 0;
+  }
+
+  //----------------------------------------------------------------------------
+  Node convert< ts::DecimationSettings >::encode( const ts::DecimationSettings& decimation )
+  {
+    Node node;
+    node["enabled"]     = decimation.enabled;
+    node["voxelSize"]   = decimation.voxelSize;
+    node["targetCount"] = decimation.targetCount;
+    return node;
+  }
+
+  //----------------------------------------------------------------------------
+  bool convert< ts::DecimationSettings >::decode( const Node& node,
+                                                  ts::DecimationSettings& decimation )
+  {
+    if( node["enabled"] )     decimation.enabled     = node["enabled"].as<bool>();
+    if( node["voxelSize"] )   decimation.voxelSize   = node["voxelSize"].as<ts::Real>();
+    if( node["targetCount"] ) decimation.targetCount = node["targetCount"].as<ts::SizeT>();
+    return !decimation.enabled || decimation.voxelSize > 0 || decimation.targetCount > 0;
+  }
+
+  //----------------------------------------------------------------------------
+  Node convert< ts::ProfilingSettings >::encode( const ts::ProfilingSettings& profiling )
+  {
+    Node node;
+    node["enabled"]        = profiling.enabled;
+    node["traceFile"]      = profiling.traceFile;
+    node["maxTraceEvents"] = profiling.maxTraceEvents;
+    return node;
+  }
+
+  //----------------------------------------------------------------------------
+  bool convert< ts::ProfilingSettings >::decode( const Node& node,
+                                                 ts::ProfilingSettings& profiling )
+  {
+    // 'profiling: true' switches the summary on, without a trace
+    if( node.IsScalar() ) {
+      profiling.enabled = node.as<bool>();
+      return true;
+    }
+    if( node["enabled"] )   profiling.enabled   = node["enabled"].as<bool>();
+    if( node["traceFile"] ) profiling.traceFile = node["traceFile"].as<std::string>();
+    if( node["maxTraceEvents"] )
+      profiling.maxTraceEvents = node["maxTraceEvents"].as<ts::SizeT>();
+    return true;
+  }
+
+  //----------------------------------------------------------------------------
+  Node convert< ts::TelemetrySettings >::encode( const ts::TelemetrySettings& telemetry )
+  {
+    Node node;
+    node["enabled"] = telemetry.enabled;
+    if( !telemetry.name.empty() )
+      node["name"]  = telemetry.name;
+    return node;
+  }
+
+  //----------------------------------------------------------------------------
+  bool convert< ts::TelemetrySettings >::decode( const Node& node,
+                                                 ts::TelemetrySettings& telemetry )
+  {
+    // 'telemetry: true' publishes under the solverName
+    if( node.IsScalar() ) {
+      telemetry.enabled = node.as<bool>();
+      return true;
+    }
+    if( node["enabled"] ) telemetry.enabled = node["enabled"].as<bool>();
+    if( node["name"] )    telemetry.name    = node["name"].as<std::string>();
+    return true;
+  }
+
+  //----------------------------------------------------------------------------
+  Node convert< ts::TimeStepSettings >::encode( const ts::TimeStepSettings& timeStep )
+  {
+    Node node;
+    node["adaptive"]   = timeStep.adaptive;
+    node["dtMin"]      = timeStep.dtMin;
+    node["dtMax"]      = timeStep.dtMax;
+    node["tolerance"]  = timeStep.tolerance;
+    node["forceScale"] = timeStep.forceScale;
+    node["safety"]     = timeStep.safety;
+    node["maxGrowth"]  = timeStep.maxGrowth;
+    return node;
+  }
+
+  //----------------------------------------------------------------------------
+  bool convert< ts::TimeStepSettings >::decode( const Node& node,
+                                                ts::TimeStepSettings& timeStep )
+  {
+    // 'timeStep: adaptive' switches the controller on with its defaults
+    if( node.IsScalar() ) {
+      const auto type = node.as<std::string>();
+      if     ( type == "adaptive" ) timeStep.adaptive = true;
+      else if( type == "fixed"    ) timeStep.adaptive = false;
+      else return false;
+      return true;
+    }
+    if( node["adaptive"] )   timeStep.adaptive   = node["adaptive"].as<bool>();
+    if( node["dtMin"] )      timeStep.dtMin      = node["dtMin"].as<ts::Real>();
+    if( node["dtMax"] )      timeStep.dtMax      = node["dtMax"].as<ts::Real>();
+    if( node["tolerance"] )  timeStep.tolerance  = node["tolerance"].as<ts::Real>();
+    if( node["forceScale"] ) timeStep.forceScale = node["forceScale"].as<ts::Real>();
+    if( node["safety"] )     timeStep.safety     = node["safety"].as<ts::Real>();
+    if( node["maxGrowth"] )  timeStep.maxGrowth  = node["maxGrowth"].as<ts::Real>();
+    return timeStep.dtMin > 0 && timeStep.dtMin <= timeStep.dtMax &&
+           timeStep.tolerance > 0 && timeStep.forceScale >= 0 &&
+           timeStep.safety > 0 && timeStep.maxGrowth >= 1;
+  }
+
+  //----------------------------------------------------------------------------
+  Node convert< ts::SubcyclingSettings >::encode( const ts::SubcyclingSettings& subcycling )
+  {
+    Node node;
+    node["enabled"]     = subcycling.enabled;
+    node["numSubsteps"] = subcycling.numSubsteps;
+    return node;
+  }
+
+  //----------------------------------------------------------------------------
+  bool convert< ts::SubcyclingSettings >::decode( const Node& node,
+                                                  ts::SubcyclingSettings& subcycling )
+  {
+    // 'subcycling: 4' switches it on with four substeps
+    if( node.IsScalar() ) {
+      subcycling.enabled     = true;
+      subcycling.numSubsteps = node.as<ts::SizeT>();
+      return subcycling.numSubsteps > 0;
+    }
+    if( node["enabled"] )     subcycling.enabled     = node["enabled"].as<bool>();
+    if( node["numSubsteps"] ) subcycling.numSubsteps = node["numSubsteps"].as<ts::SizeT>();
+    return subcycling.numSubsteps > 0;
+  }
+
   //----------------------------------------------------------------------------
   Node convert< ts::Settings >::encode( const ts::Settings& settings )
   {
@@ -31,6 +304,41 @@ namespace YAML {
     node["outField"]   = settings.outField;
     node["dt"]         = settings.dt;
     node["endt"]       = settings.endt;
+    node["numCheckpoints"]       = settings.numCheckpoints;
+    node["numThreads"]           = settings.numThreads;
+    if( !settings.pointCloudRegion.empty() )
+      node["pointCloudRegion"]   = settings.pointCloudRegion;
+    node["vertexOrdering"]       = settings.vertexOrdering == ts::Settings::VertexOrdering::input  ? "input"
+                                 : settings.vertexOrdering == ts::Settings::VertexOrdering::morton ? "morton"
+                                 :                                                                   "hilbert";
+    node["decimation"]           = settings.decimation;
+    node["timeStep"]             = settings.timeStep;
+    node["subcycling"]           = settings.subcycling;
+    node["samplesFile"]          = settings.samplesFile;
+    node["convergedSamplesOnly"] = settings.convergedSamplesOnly;
+    node["binarySamples"]        = settings.binarySamples;
+    node["forceModel"]           = settings.forceModel;
+    node["forceField"]           = settings.forceField == ts::Settings::ForceField::uniform
+                                 ? "uniform" : "perVertex";
+    node["forceCache"]           = settings.forceCache;
+    node["profiling"]            = settings.profiling;
+    node["telemetry"]            = settings.telemetry;
+    if( !settings.recordFile.empty() )
+      node["recordFile"]         = settings.recordFile;
+    for( const auto& mesh : settings.meshes ) {
+      Node entry;
+      entry["meshName"] = mesh.meshName;
+      if( !mesh.pointCloud.empty() )
+        entry["pointCloud"] = mesh.pointCloud;
+      if( !mesh.pointCloudRegion.empty() )
+        entry["pointCloudRegion"] = mesh.pointCloudRegion;
+      entry["inField"]  = mesh.inField;
+      entry["outField"] = mesh.outField;
+      if( !mesh.samplesFile.empty() )
+        entry["samplesFile"] = mesh.samplesFile;
+      entry["forceModel"] = mesh.forceModel;
+      node["meshes"].push_back( entry );
+    }
     return node;
   }
     
@@ -38,12 +346,181 @@ namespace YAML {
   bool convert< ts::Settings >::decode( const Node& node, ts::Settings& settings )
   {
     settings.solverName = node["solverName"].as<std::string>();
-    settings.meshName   = node["meshName"].as<std::string>();
+    if( node["meshName"] || !node["meshes"] )
+      settings.meshName = node["meshName"].as<std::string>();
     settings.inField    = node["inField"].as<std::string>();
     settings.outField   = node["outField"].as<std::string>();
     settings.dt         = node["dt"].as<ts::Real>();
     settings.endt       = node["endt"].as<ts::Real>();
+
+    // optional entries keep their defaults
+    if( node["numCheckpoints"] )
+      settings.numCheckpoints = node["numCheckpoints"].as<ts::SizeT>();
+    if( node["numThreads"] )
+      settings.numThreads = node["numThreads"].as<ts::SizeT>();
+    if( node["pointCloudRegion"] )
+      settings.pointCloudRegion = node["pointCloudRegion"].as<std::string>();
+    if( node["vertexOrdering"] ) {
+      const auto ordering = node["vertexOrdering"].as<std::string>();
+      if     ( ordering == "input"   ) settings.vertexOrdering = ts::Settings::VertexOrdering::input;
+      else if( ordering == "morton"  ) settings.vertexOrdering = ts::Settings::VertexOrdering::morton;
+      else if( ordering == "hilbert" ) settings.vertexOrdering = ts::Settings::VertexOrdering::hilbert;
+      else return false;
+    }
+    if( node["decimation"] )
+      settings.decimation = node["decimation"].as<ts::DecimationSettings>();
+    if( node["timeStep"] )
+      settings.timeStep = node["timeStep"].as<ts::TimeStepSettings>();
+    if( node["subcycling"] )
+      settings.subcycling = node["subcycling"].as<ts::SubcyclingSettings>();
+    if( node["samplesFile"] )
+      settings.samplesFile = node["samplesFile"].as<std::string>();
+    if( node["convergedSamplesOnly"] )
+      settings.convergedSamplesOnly = node["convergedSamplesOnly"].as<bool>();
+    if( node["binarySamples"] )
+      settings.binarySamples = node["binarySamples"].as<bool>();
+    if( node["forceModel"] )
+      settings.forceModel = node["forceModel"].as<ts::ForceModelSettings>();
+    if( node["forceField"] ) {
+      const auto field = node["forceField"].as<std::string>();
+      if     ( field == "uniform"   ) settings.forceField = ts::Settings::ForceField::uniform;
+      else if( field == "perVertex" ) settings.forceField = ts::Settings::ForceField::perVertex;
+      else return false;
+    }
+    if( node["forceCache"] )
+      settings.forceCache = node["forceCache"].as<ts::ForceCacheSettings>();
+    if( node["profiling"] )
+      settings.profiling = node["profiling"].as<ts::ProfilingSettings>();
+    if( node["telemetry"] )
+      settings.telemetry = node["telemetry"].as<ts::TelemetrySettings>();
+    if( node["recordFile"] )
+      settings.recordFile = node["recordFile"].as<std::string>();
+
+    // meshes inherit fields and force model from the settings
+    for( const auto& entry : node["meshes"] ) {
+      ts::MeshSettings mesh;
+      mesh.meshName   = entry["meshName"].as<std::string>();
+      mesh.inField    = settings.inField;
+      mesh.outField   = settings.outField;
+      mesh.forceModel = settings.forceModel;
+      if( entry["pointCloud"] )
+        mesh.pointCloud = entry["pointCloud"].as<std::string>();
+      if( entry["pointCloudRegion"] )
+        mesh.pointCloudRegion = entry["pointCloudRegion"].as<std::string>();
+      if( entry["inField"] )
+        mesh.inField = entry["inField"].as<std::string>();
+      if( entry["outField"] )
+        mesh.outField = entry["outField"].as<std::string>();
+      if( entry["samplesFile"] )
+        mesh.samplesFile = entry["samplesFile"].as<std::string>();
+      if( entry["forceModel"] )
+        mesh.forceModel = entry["forceModel"].as<ts::ForceModelSettings>();
+      settings.meshes.push_back( std::move( mesh ) );
+    }
+    return true;
+  }
+
+  //----------------------------------------------------------------------------
+  Node convert< ts::TrajectorySettings >::encode( const ts::TrajectorySettings& trajectory )
+  {
+    Node node;
+    node["type"] = trajectory.type;
+    if( trajectory.type == "file" )
+      node["file"] = trajectory.file;
+    else {
+      node["gravity"] = trajectory.gravity;
+      node["axis"]    = trajectory.axis;
+    }
+    return node;
+  }
+
+  //----------------------------------------------------------------------------
+  bool convert< ts::TrajectorySettings >::decode( const Node& node,
+                                                  ts::TrajectorySettings& trajectory )
+  {
+    if( node["type"] )    trajectory.type    = node["type"].as<std::string>();
+    if( node["file"] )    trajectory.file    = node["file"].as<std::string>();
+    if( node["gravity"] ) trajectory.gravity = node["gravity"].as<ts::Real>();
+    if( node["axis"] )    trajectory.axis    = node["axis"].as<ts::SizeT>();
+    return trajectory.axis < 3;
+  }
+
+  //----------------------------------------------------------------------------
+  Node convert< ts::SweepSettings >::encode( const ts::SweepSettings& sweep )
+  {
+    Node node;
+    node["output"]      = sweep.output;
+    node["numThreads"]  = sweep.numThreads;
+    node["trajectory"]  = sweep.trajectory;
+    node["dt"]          = sweep.dt;
+    node["endt"]        = sweep.endt;
+    node["forceModels"] = sweep.forceModels;
+    return node;
+  }
+
+  //----------------------------------------------------------------------------
+  bool convert< ts::SweepSettings >::decode( const Node& node, ts::SweepSettings& sweep )
+  {
+    if( node["output"] )     sweep.output     = node["output"].as<std::string>();
+    if( node["numThreads"] ) sweep.numThreads = node["numThreads"].as<ts::SizeT>();
+    if( node["trajectory"] )
+      sweep.trajectory = node["trajectory"].as<ts::TrajectorySettings>();
+    if( node["dt"] )   sweep.dt   = node["dt"].as<std::vector<ts::Real>>();
+    if( node["endt"] ) sweep.endt = node["endt"].as<std::vector<ts::Real>>();
+    if( node["forceModels"] )
+      sweep.forceModels = node["forceModels"].as<std::vector<ts::ForceModelSettings>>();
     return true;
   }
+
+  //----------------------------------------------------------------------------
+  Node convert< ts::RigidBodySettings >::encode( const ts::RigidBodySettings& body )
+  {
+    using Integrator = ts::RigidBodySettings::Integrator;
+    using Scheme     = ts::RigidBodySettings::Scheme;
+    static constexpr const char* integrators[] = { "explicitEuler", "implicitEuler", "rk4", "bdf2" };
+    Node node;
+    node["mass"]          = body.mass;
+    node["gravity"]       = body.gravity;
+    node["integrator"]    = integrators[static_cast<int>( body.integrator )];
+    node["scheme"]        = body.scheme == Scheme::serialExplicit ? "serialExplicit"
+                                                                  : "parallelImplicit";
+    node["maxIterations"] = body.maxIterations;
+    node["tolerance"]     = body.tolerance;
+    node["relaxation"]    = body.relaxation;
+    node["windowSize"]    = body.windowSize;
+    node["output"]        = body.output;
+    static_assert( static_cast<int>( Integrator::bdf2 ) == 3 );
+    return node;
+  }
+
+  //----------------------------------------------------------------------------
+  bool convert< ts::RigidBodySettings >::decode( const Node& node,
+                                                 ts::RigidBodySettings& body )
+  {
+    using Integrator = ts::RigidBodySettings::Integrator;
+    using Scheme     = ts::RigidBodySettings::Scheme;
+    if( node["mass"] )    body.mass    = node["mass"].as<ts::Real>();
+    if( node["gravity"] ) body.gravity = node["gravity"].as<std::array<ts::Real,3>>();
+    if( node["integrator"] ) {
+      const auto integrator = node["integrator"].as<std::string>();
+      if     ( integrator == "explicitEuler" ) body.integrator = Integrator::explicitEuler;
+      else if( integrator == "implicitEuler" ) body.integrator = Integrator::implicitEuler;
+      else if( integrator == "rk4"           ) body.integrator = Integrator::rk4;
+      else if( integrator == "bdf2"          ) body.integrator = Integrator::bdf2;
+      else return false;
+    }
+    if( node["scheme"] ) {
+      const auto scheme = node["scheme"].as<std::string>();
+      if     ( scheme == "serialExplicit"   ) body.scheme = Scheme::serialExplicit;
+      else if( scheme == "parallelImplicit" ) body.scheme = Scheme::parallelImplicit;
+      else return false;
+    }
+    if( node["maxIterations"] ) body.maxIterations = node["maxIterations"].as<ts::SizeT>();
+    if( node["tolerance"] )     body.tolerance     = node["tolerance"].as<ts::Real>();
+    if( node["relaxation"] )    body.relaxation    = node["relaxation"].as<ts::Real>();
+    if( node["windowSize"] )    body.windowSize    = node["windowSize"].as<ts::Real>();
+    if( node["output"] )        body.output        = node["output"].as<std::string>();
+    return body.mass > 0 && body.windowSize >= 0;
+  }
   
 } // end namespace YAML
@@ -24,6 +24,86 @@
 //------------------------------------------------------------------------------
 namespace YAML {
 
+  //----------------------------------------------------------------------------
+  template< >
+  struct convert< ts::ForceTableSettings >
+  {
+    static Node encode( const ts::ForceTableSettings& );
+    static bool decode( const Node&, ts::ForceTableSettings& );
+  };
+
+  //----------------------------------------------------------------------------
+  template< >
+  struct convert< ts::SigmoidForceSettings >
+  {
+    static Node encode( const ts::SigmoidForceSettings& );
+    static bool decode( const Node&, ts::SigmoidForceSettings& );
+  };
+
+  //----------------------------------------------------------------------------
+  template< >
+  struct convert< ts::PolynomialForceSettings >
+  {
+    static Node encode( const ts::PolynomialForceSettings& );
+    static bool decode( const Node&, ts::PolynomialForceSettings& );
+  };
+
+  //----------------------------------------------------------------------------
+  template< >
+  struct convert< ts::ForceModelSettings >
+  {
+    static Node encode( const ts::ForceModelSettings& );
+    static bool decode( const Node&, ts::ForceModelSettings& );
+  };
+
+  //----------------------------------------------------------------------------
+  template< >
+  struct convert< ts::ForceCacheSettings >
+  {
+    static Node encode( const ts::ForceCacheSettings& );
+    static bool decode( const Node&, ts::ForceCacheSettings& );
+  };
+
+  //----------------------------------------------------------------------------
+  template< >
+  struct convert< ts::DecimationSettings >
+  {
+    static Node encode( const ts::DecimationSettings& );
+    static bool decode( const Node&, ts::DecimationSettings& );
+  };
+
+  //----------------------------------------------------------------------------
+  template< >
+  struct convert< ts::ProfilingSettings >
+  {
+    static Node encode( const ts::ProfilingSettings& );
+    static bool decode( const Node&, ts::ProfilingSettings& );
+  };
+
+  //----------------------------------------------------------------------------
+  template< >
+  struct convert< ts::TelemetrySettings >
+  {
+    static Node encode( const ts::TelemetrySettings& );
+    static bool decode( const Node&, ts::TelemetrySettings& );
+  };
+
+  //----------------------------------------------------------------------------
+  template< >
+  struct convert< ts::TimeStepSettings >
+  {
+    static Node encode( const ts::TimeStepSettings& );
+    static bool decode( const Node&, ts::TimeStepSettings& );
+  };
+
+  //----------------------------------------------------------------------------
+  template< >
+  struct convert< ts::SubcyclingSettings >
+  {
+    static Node encode( const ts::SubcyclingSettings& );
+    static bool decode( const Node&, ts::SubcyclingSettings& );
+  };
+
   //----------------------------------------------------------------------------
   template< >
   struct convert< ts::Settings >
@@ -31,5 +111,29 @@ namespace YAML {
     static Node encode( const ts::Settings& );
     static bool decode( const Node&, ts::Settings& );
   };
+
+  //----------------------------------------------------------------------------
+  template< >
+  struct convert< ts::TrajectorySettings >
+  {
+    static Node encode( const ts::TrajectorySettings& );
+    static bool decode( const Node&, ts::TrajectorySettings& );
+  };
+
+  //----------------------------------------------------------------------------
+  template< >
+  struct convert< ts::SweepSettings >
+  {
+    static Node encode( const ts::SweepSettings& );
+    static bool decode( const Node&, ts::SweepSettings& );
+  };
+
+  //----------------------------------------------------------------------------
+  template< >
+  struct convert< ts::RigidBodySettings >
+  {
+    static Node encode( const ts::RigidBodySettings& );
+    static bool decode( const Node&, ts::RigidBodySettings& );
+  };
   
 } // end namespace YAML
@@ -29,6 +29,41 @@ namespace ts {
       return node[root.data()].as<ts::Settings>();
     }
 
+    //--------------------------------------------------------------------------
+    SweepSettings Parser::parseSweep( const std::filesystem::path& yamlFile )
+    {
+      YAML::Node node = ::YAML::LoadFile( yamlFile.string() );
+      return node[sweepRoot.data()].as<ts::SweepSettings>();
+    }
+
+    //--------------------------------------------------------------------------
+    std::ostream& Parser::dump( std::ostream& out,
+                                const SweepSettings& sweep )
+    {
+      YAML::Node node;
+      node[sweepRoot.data()] = sweep;
+      out << ::YAML::Dump(node) << std::endl;
+      return out;
+    }
+
+    //--------------------------------------------------------------------------
+    RigidBodySettings Parser::parseRigidBody( const std::filesystem::path& yamlFile )
+    {
+      YAML::Node node = ::YAML::LoadFile( yamlFile.string() );
+      if( !node[bodyRoot.data()] ) return {};
+      return node[bodyRoot.data()].as<ts::RigidBodySettings>();
+    }
+
+    //--------------------------------------------------------------------------
+    std::ostream& Parser::dump( std::ostream& out,
+                                const RigidBodySettings& body )
+    {
+      YAML::Node node;
+      node[bodyRoot.data()] = body;
+      out << ::YAML::Dump(node) << std::endl;
+      return out;
+    }
+
     //--------------------------------------------------------------------------
     std::ostream& Parser::dump( std::ostream& out,
                                 const Settings& settings )
@@ -59,5 +94,17 @@ namespace ts {
     {
       return Parser::parse(yamlFile);
     }
+
+    //--------------------------------------------------------------------------
+    SweepSettings parseSweep( const std::filesystem::path& yamlFile )
+    {
+      return Parser::parseSweep(yamlFile);
+    }
+
+    //--------------------------------------------------------------------------
+    RigidBodySettings parseRigidBody( const std::filesystem::path& yamlFile )
+    {
+      return Parser::parseRigidBody(yamlFile);
+    }
   } // end namespace yaml
 } // end namespace ts
@@ -33,12 +33,25 @@ namespace ts {
     //--------------------------------------------------------------------------
     struct Parser
     {
-      static constexpr std::string_view root = "settings";
+      static constexpr std::string_view root      = "settings";
+      static constexpr std::string_view sweepRoot = "sweep";
+      static constexpr std::string_view bodyRoot  = "rigidBody";
       
       Parser() = delete;
 
       static Settings parse( const std::filesystem::path& yamlFile );
 
+      static SweepSettings parseSweep( const std::filesystem::path& yamlFile );
+
+      static std::ostream& dump( std::ostream& out,
+                                 const SweepSettings& sweep );
+
+      //! the 'rigidBody' block, defaults if there is none
+      static RigidBodySettings parseRigidBody( const std::filesystem::path& yamlFile );
+
+      static std::ostream& dump( std::ostream& out,
+                                 const RigidBodySettings& body );
+
       static std::ostream& dump( std::ostream& out,
                                  const Settings& settings );
       
@@ -49,5 +62,9 @@ namespace ts {
     //--------------------------------------------------------------------------
     Settings parse( const std::filesystem::path& yamlFile );
 
+    SweepSettings parseSweep( const std::filesystem::path& yamlFile );
+
+    RigidBodySettings parseRigidBody( const std::filesystem::path& yamlFile );
+
   } // end namespace yaml
 } // end namespace ts